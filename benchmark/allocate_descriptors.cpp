@@ -0,0 +1,146 @@
+/// @file Compares descriptor set allocation through @ref DescriptorAllocator with allocating and freeing sets one by one.
+/// @details Both approaches allocate the same number of sets per frame, for a number of frames,
+///          with a layout of one uniform buffer and one combined image sampler.
+///          Options:
+///          - --sets N: number of sets allocated per frame (default: 10000)
+///          - --frames N: number of frames (default: 100)
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "DescriptorAllocator.hpp"
+
+// --- STL Includes ---
+#include <iostream>
+#include <array>
+#include <stdexcept>
+
+
+namespace {
+
+
+VkDescriptorSetLayout makeLayout(const LogicalDevice& r_device)
+{
+    std::array<VkDescriptorSetLayoutBinding,2> bindings {};
+    bindings[0].binding = 0;
+    bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[0].descriptorCount = 1;
+    bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    bindings[1].binding = 1;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[1].descriptorCount = 1;
+    bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    info.bindingCount = static_cast<uint32_t>(bindings.size());
+    info.pBindings = bindings.data();
+
+    VkDescriptorSetLayout layout;
+    if (vkCreateDescriptorSetLayout(r_device.getDevice(), &info, r_device.getAllocationCallbacks(), &layout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor set layout");
+    }
+    return layout;
+}
+
+
+/// @brief Allocate every set on its own from a single pool, and free them one by one at the end of each frame.
+double runNaive(const LogicalDevice& r_device,
+                VkDescriptorSetLayout layout,
+                std::size_t setCount,
+                std::size_t frameCount)
+{
+    const VkDevice device = r_device.getDevice();
+
+    const std::array<VkDescriptorPoolSize,2> sizes {
+        VkDescriptorPoolSize {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, static_cast<uint32_t>(setCount)},
+        VkDescriptorPoolSize {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, static_cast<uint32_t>(setCount)}
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    poolInfo.maxSets = static_cast<uint32_t>(setCount);
+    poolInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
+    poolInfo.pPoolSizes = sizes.data();
+
+    VkDescriptorPool pool;
+    if (vkCreateDescriptorPool(device, &poolInfo, r_device.getAllocationCallbacks(), &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor pool");
+    }
+
+    std::vector<VkDescriptorSet> sets(setCount);
+    const double time = benchmark::measure([&]() {
+        for (std::size_t i_frame=0; i_frame<frameCount; ++i_frame) {
+            VkDescriptorSetAllocateInfo info {};
+            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            info.descriptorPool = pool;
+            info.descriptorSetCount = 1;
+            info.pSetLayouts = &layout;
+            for (VkDescriptorSet& r_set : sets) {
+                if (vkAllocateDescriptorSets(device, &info, &r_set) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to allocate descriptor set");
+                }
+            }
+            for (VkDescriptorSet set : sets) {
+                vkFreeDescriptorSets(device, pool, 1, &set);
+            }
+        }
+    });
+
+    vkDestroyDescriptorPool(device, pool, r_device.getAllocationCallbacks());
+    return time;
+}
+
+
+/// @brief Allocate sets linearly from per-frame pools that get reset in bulk.
+double runPooled(const std::shared_ptr<LogicalDevice>& rp_device,
+                 VkDescriptorSetLayout layout,
+                 std::size_t setCount,
+                 std::size_t frameCount,
+                 std::size_t& r_poolCount)
+{
+    DescriptorAllocator::Settings settings;
+    settings.descriptorsPerSet = {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+                                  {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.0f}};
+    DescriptorAllocator allocator(rp_device, 2, settings);
+
+    const double time = benchmark::measure([&]() {
+        for (std::size_t i_frame=0; i_frame<frameCount; ++i_frame) {
+            allocator.beginFrame();
+            for (std::size_t i_set=0; i_set<setCount; ++i_set) {
+                allocator.allocate(layout);
+            }
+        }
+    });
+
+    r_poolCount = allocator.getStatistics().poolCount;
+    return time;
+}
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t setCount = benchmark::getOption(argc, argv, "--sets", 10000);
+    const std::size_t frameCount = benchmark::getOption(argc, argv, "--frames", 100);
+
+    auto context = benchmark::makeHeadlessContext();
+    const LogicalDevice& r_device = *context.p_logicalDevice;
+    const VkDescriptorSetLayout layout = makeLayout(r_device);
+
+    const double totalSets = static_cast<double>(setCount * frameCount);
+    const double naiveTime = runNaive(r_device, layout, setCount, frameCount);
+
+    std::size_t poolCount = 0;
+    const double pooledTime = runPooled(context.p_logicalDevice, layout, setCount, frameCount, poolCount);
+
+    std::cout << "naive allocate + free: " << totalSets / naiveTime << " sets/s\n"
+              << "per-frame pools:       " << totalSets / pooledTime << " sets/s ("
+              << poolCount << " pools)\n"
+              << "speedup:               " << naiveTime / pooledTime << '\n';
+
+    vkDestroyDescriptorSetLayout(r_device.getDevice(), layout, r_device.getAllocationCallbacks());
+    return 0;
+}
@@ -0,0 +1,288 @@
+/// @file Compares recording draws that bind a descriptor set each with bindless draws that push an index.
+/// @details Every draw reads one of a number of materials, each a range of a storage buffer.
+///          The per-draw path allocates a set per material up front, and binds the draw's set
+///          before each draw. The bindless path writes every material into @ref BindlessDescriptors,
+///          binds its set once, and pushes the material index before each draw. Draws visit the
+///          materials in a scrambled order, so that consecutive draws rarely share one. Both
+///          recordings are submitted once to make sure they are valid.
+///          Options:
+///          - --draws N: number of draws per recording (default: 100000)
+///          - --materials N: number of materials (default: 1000)
+///          - --iterations N: number of recordings per path, the fastest is reported (default: 10)
+///          - --performance-warnings, --performance-baseline: see @ref benchmark::checkPerformanceWarnings
+/// @return 1 if new performance warnings showed up.
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "BindlessDescriptors.hpp"
+#include "StorageBuffer.hpp"
+#include "OffscreenTarget.hpp"
+#include "Pipeline.hpp"
+#include "Framebuffers.hpp"
+
+// --- STL Includes ---
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Sets with a single storage buffer each, one per material.
+struct MaterialSets
+{
+    MaterialSets(const std::shared_ptr<LogicalDevice>& rp_device,
+                 VkBuffer buffer,
+                 VkDeviceSize stride,
+                 std::size_t materialCount)
+        : p_device(rp_device),
+          setLayout(VK_NULL_HANDLE),
+          pool(VK_NULL_HANDLE),
+          layout(VK_NULL_HANDLE),
+          sets(materialCount)
+    {
+        const VkDevice device = p_device->getDevice();
+
+        VkDescriptorSetLayoutBinding binding {};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+
+        VkDescriptorSetLayoutCreateInfo setLayoutInfo {};
+        setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        setLayoutInfo.bindingCount = 1;
+        setLayoutInfo.pBindings = &binding;
+        if (vkCreateDescriptorSetLayout(device, &setLayoutInfo, p_device->getAllocationCallbacks(), &setLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor set layout");
+        }
+
+        const VkDescriptorPoolSize poolSize {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, static_cast<uint32_t>(materialCount)};
+        VkDescriptorPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.maxSets = static_cast<uint32_t>(materialCount);
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        if (vkCreateDescriptorPool(device, &poolInfo, p_device->getAllocationCallbacks(), &pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor pool");
+        }
+
+        const std::vector<VkDescriptorSetLayout> setLayouts(materialCount, setLayout);
+        VkDescriptorSetAllocateInfo setInfo {};
+        setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        setInfo.descriptorPool = pool;
+        setInfo.descriptorSetCount = static_cast<uint32_t>(materialCount);
+        setInfo.pSetLayouts = setLayouts.data();
+        if (vkAllocateDescriptorSets(device, &setInfo, sets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor sets");
+        }
+
+        for (std::size_t i_material=0; i_material<materialCount; ++i_material) {
+            const VkDescriptorBufferInfo bufferInfo {buffer, i_material * stride, stride};
+            VkWriteDescriptorSet write {};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = sets[i_material];
+            write.dstBinding = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.pBufferInfo = &bufferInfo;
+            vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+        }
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &setLayout;
+        if (vkCreatePipelineLayout(device, &layoutInfo, p_device->getAllocationCallbacks(), &layout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline layout");
+        }
+    }
+
+    ~MaterialSets()
+    {
+        const VkDevice device = p_device->getDevice();
+        vkDestroyPipelineLayout(device, layout, p_device->getAllocationCallbacks());
+        vkDestroyDescriptorPool(device, pool, p_device->getAllocationCallbacks());
+        vkDestroyDescriptorSetLayout(device, setLayout, p_device->getAllocationCallbacks());
+    }
+
+    std::shared_ptr<LogicalDevice> p_device;
+
+    VkDescriptorSetLayout setLayout;
+
+    VkDescriptorPool pool;
+
+    VkPipelineLayout layout;
+
+    std::vector<VkDescriptorSet> sets;
+}; // struct MaterialSets
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t drawCount = benchmark::getOption(argc, argv, "--draws", 100000);
+    const std::size_t materialCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--materials", 1000), 1);
+    const std::size_t iterationCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--iterations", 10), 1);
+
+    auto context = benchmark::makeHeadlessContext(benchmark::getInstanceSettings(argc, argv));
+    const auto& rp_device = context.p_logicalDevice;
+    const VkDevice device = rp_device->getDevice();
+
+    if (!rp_device->hasFeature(PhysicalDevice::Feature::DescriptorIndexing)) {
+        std::cout << rp_device->getPhysicalDevice() << " doesn't support descriptor indexing, skipping\n";
+        return 0;
+    }
+
+    // Materials are consecutive ranges of one buffer
+    const VkDeviceSize alignment = rp_device->getPhysicalDevice().getProperties().limits.minStorageBufferOffsetAlignment;
+    const VkDeviceSize stride = std::max<VkDeviceSize>(alignment, 16);
+    StorageBuffer buffer(rp_device, stride * materialCount);
+
+    MaterialSets materialSets(rp_device, buffer.get(), stride, materialCount);
+
+    BindlessDescriptors::Settings bindlessSettings;
+    bindlessSettings.textureCapacity = 0;
+    bindlessSettings.bufferCapacity = static_cast<uint32_t>(materialCount);
+    bindlessSettings.stages = VK_SHADER_STAGE_ALL_GRAPHICS;
+    BindlessDescriptors bindless(rp_device, 1, bindlessSettings);
+    if (bindless.getBufferSlots().getCapacity() < materialCount) {
+        throw std::runtime_error("Too many materials for the device's bindless limits");
+    }
+
+    std::vector<uint32_t> materialIndices(materialCount);
+    for (std::size_t i_material=0; i_material<materialCount; ++i_material) {
+        materialIndices[i_material] = bindless.addBuffer(buffer.get(), i_material * stride, stride);
+    }
+
+    // Render into a single offscreen image
+    OffscreenTarget::Settings targetSettings;
+    targetSettings.imageCount = 1;
+    targetSettings.unthrottled = true;
+    auto p_target = std::make_shared<OffscreenTarget>(rp_device, targetSettings);
+    auto p_views = std::make_shared<RenderTarget::ImageViews>(p_target);
+
+    Pipeline pipeline(rp_device,
+                      benchmark::makeShaderIO("vertexShader.vert.spv"),
+                      benchmark::makeShaderIO("fragmentShader.frag.spv"),
+                      p_target->getImageFormat(),
+                      p_target->getFinalLayout());
+    Framebuffers framebuffers(p_views, pipeline.getRenderPass());
+
+    // Command buffer and a fence to check the recordings with
+    const auto queueFamily = rp_device->getPhysicalDevice().getQueueFamily({});
+    VkCommandPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamily.graphics.value();
+    VkCommandPool commandPool;
+    if (vkCreateCommandPool(device, &poolInfo, rp_device->getAllocationCallbacks(), &commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create command pool");
+    }
+
+    VkCommandBufferAllocateInfo bufferInfo {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    bufferInfo.commandPool = commandPool;
+    bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    bufferInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(device, &bufferInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate command buffer");
+    }
+
+    VkFenceCreateInfo fenceInfo {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence;
+    if (vkCreateFence(device, &fenceInfo, rp_device->getAllocationCallbacks(), &fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create fence");
+    }
+
+    // Scramble the material order with a stride coprime to most material counts
+    const auto getMaterial = [materialCount](std::size_t i_draw) -> std::size_t {
+        return (i_draw * 7919) % materialCount;
+    };
+
+    const VkExtent2D extent = p_target->getImageExtent();
+    const auto run = [&](auto&& r_recordDraws) -> double {
+        double bestTime = std::numeric_limits<double>::max();
+        for (std::size_t i_iteration=0; i_iteration<iterationCount; ++i_iteration) {
+            vkResetCommandBuffer(commandBuffer, 0);
+
+            const double time = benchmark::measure([&]() {
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+                VkClearValue clearValue {};
+                VkRenderPassBeginInfo renderPassInfo {};
+                renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                renderPassInfo.renderPass = pipeline.getRenderPass();
+                renderPassInfo.framebuffer = framebuffers.get(0);
+                renderPassInfo.renderArea.extent = extent;
+                renderPassInfo.clearValueCount = 1;
+                renderPassInfo.pClearValues = &clearValue;
+                vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.get());
+                const VkViewport viewport {0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+                vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+                const VkRect2D scissor {{0, 0}, extent};
+                vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+                r_recordDraws();
+
+                vkCmdEndRenderPass(commandBuffer);
+                vkEndCommandBuffer(commandBuffer);
+            });
+            bestTime = std::min(bestTime, time);
+        }
+
+        // Execute the last recording once to make sure it's valid
+        VkSubmitInfo submitInfo {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        vkResetFences(device, 1, &fence);
+        if (vkQueueSubmit(rp_device->getQueue(), 1, &submitInfo, fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit recorded draws");
+        }
+        vkWaitForFences(device, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        return bestTime;
+    };
+
+    const double perDrawTime = run([&]() {
+        for (std::size_t i_draw=0; i_draw<drawCount; ++i_draw) {
+            vkCmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    materialSets.layout,
+                                    0,
+                                    1,
+                                    &materialSets.sets[getMaterial(i_draw)],
+                                    0,
+                                    nullptr);
+            vkCmdDraw(commandBuffer, 3, 1, 0, static_cast<uint32_t>(i_draw));
+        }
+    });
+
+    const double bindlessTime = run([&]() {
+        bindless.bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS);
+        for (std::size_t i_draw=0; i_draw<drawCount; ++i_draw) {
+            bindless.pushIndices(commandBuffer, {&materialIndices[getMaterial(i_draw)], 1});
+            vkCmdDraw(commandBuffer, 3, 1, 0, static_cast<uint32_t>(i_draw));
+        }
+    });
+
+    std::cout << "per-draw sets: " << drawCount / perDrawTime << " draws/s\n"
+              << "bindless:      " << drawCount / bindlessTime << " draws/s ("
+              << bindless.getStatistics().writeCount << " descriptors written)\n"
+              << "speedup:       " << perDrawTime / bindlessTime << '\n';
+
+    vkDestroyFence(device, fence, rp_device->getAllocationCallbacks());
+    vkDestroyCommandPool(device, commandPool, rp_device->getAllocationCallbacks());
+    return benchmark::checkPerformanceWarnings(context, argc, argv) ? 0 : 1;
+}
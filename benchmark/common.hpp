@@ -0,0 +1,245 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "VulkanInstance.hpp"
+#include "DebugMessenger.hpp"
+#include "PerformanceWarnings.hpp"
+#include "HostAllocator.hpp"
+#include "PhysicalDevice.hpp"
+#include "LogicalDevice.hpp"
+#include "Shader.hpp"
+
+// --- STL Includes ---
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+#ifndef VKTUTORIAL_SHADER_DIRECTORY
+#define VKTUTORIAL_SHADER_DIRECTORY "shaders"
+#endif
+
+
+namespace benchmark {
+
+
+/// @brief Instance and devices without any window or surface.
+/// @details Members are destroyed in reverse order of declaration.
+struct Context
+{
+    /// @brief Host allocator of the instance and devices.
+    std::shared_ptr<HostAllocator> p_hostAllocator;
+
+    std::shared_ptr<VulkanInstance> p_instance;
+
+    /// @brief Performance warnings of the validation layers; stays empty in release builds.
+    std::shared_ptr<PerformanceWarnings> p_performanceWarnings;
+
+    /// @brief nullptr in release builds.
+    std::shared_ptr<DebugMessenger> p_debugMessenger;
+
+    std::shared_ptr<PhysicalDevice> p_physicalDevice;
+
+    std::shared_ptr<LogicalDevice> p_logicalDevice;
+}; // struct Context
+
+
+/// @brief Get the instance extensions required without a window.
+inline std::vector<std::string> getHeadlessExtensions()
+{
+    std::vector<std::string> extensions;
+
+    #if defined(__APPLE__) && __APPLE__
+    extensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+    #endif
+
+    #ifndef NDEBUG
+    extensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    #endif
+
+    return extensions;
+}
+
+
+/// @brief Debug messenger callback of benchmarks; @a p_userData is the context's @ref PerformanceWarnings.
+inline VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                                                    VkDebugUtilsMessageTypeFlagsEXT type,
+                                                    const VkDebugUtilsMessengerCallbackDataEXT* p_data,
+                                                    void* p_userData)
+{
+    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT) {
+        static_cast<PerformanceWarnings*>(p_userData)->record(p_data);
+    }
+    DebugSink::getDefault().submit("Validation layer", severity, type, p_data);
+    return VK_FALSE;
+}
+
+
+/// @brief Create a headless context on the default device.
+/// @note Point the loader at a software driver (e.g.: lavapipe via VK_ICD_FILENAMES)
+///       for results that don't depend on the GPU.
+inline Context makeHeadlessContext(const VulkanInstance::Settings& r_instanceSettings)
+{
+    Context context;
+    context.p_hostAllocator = std::make_shared<HostAllocator>();
+    context.p_instance = std::make_shared<VulkanInstance>(getHeadlessExtensions(), r_instanceSettings, context.p_hostAllocator);
+    context.p_performanceWarnings = std::make_shared<PerformanceWarnings>();
+
+    #ifndef NDEBUG
+    VkDebugUtilsMessengerCreateInfoEXT createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    createInfo.messageSeverity = r_instanceSettings.debugSeverities | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT; // <== performance warnings are always captured
+    createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT
+                           | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
+                           | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    createInfo.pfnUserCallback = debugCallback;
+    context.p_debugMessenger = std::make_shared<DebugMessenger>(context.p_instance,
+                                                                createInfo,
+                                                                context.p_performanceWarnings);
+    #endif
+
+    const auto physicalDevice = PhysicalDevice::getDefaultDevice(context.p_instance->get(), std::nullopt);
+    if (!physicalDevice.has_value()) {
+        throw std::runtime_error("No suitable physical device found");
+    }
+    context.p_physicalDevice = std::make_shared<PhysicalDevice>(physicalDevice.value());
+    context.p_logicalDevice = std::make_shared<LogicalDevice>(context.p_physicalDevice,
+                                                              LogicalDevice::QueueSettings(),
+                                                              context.p_hostAllocator);
+
+    return context;
+}
+
+
+/// @brief Create a headless context on the default device, with default instance settings.
+inline Context makeHeadlessContext()
+{
+    return makeHeadlessContext(VulkanInstance::Settings());
+}
+
+
+/// @brief Load a compiled shader from the executable if it was embedded, or from the build tree otherwise.
+inline std::shared_ptr<ShaderIO> makeShaderIO(std::string_view name)
+{
+    if (EmbeddedShaderIO::isAvailable(name)) {
+        return std::make_shared<EmbeddedShaderIO>(name);
+    }
+    return std::make_shared<MappedSpirvShaderIO>(std::filesystem::path(VKTUTORIAL_SHADER_DIRECTORY) / name);
+}
+
+
+/// @brief Get the value of a "--name value" command line option.
+inline std::size_t getOption(int argc,
+                             const char* const* argv,
+                             std::string_view name,
+                             std::size_t defaultValue)
+{
+    for (int i_arg=1; i_arg<argc - 1; ++i_arg) {
+        if (argv[i_arg] == name) {
+            return std::stoull(argv[i_arg + 1]);
+        }
+    }
+    return defaultValue;
+}
+
+
+/// @brief Get the value of a "--name value" command line option as a string.
+inline std::string getStringOption(int argc,
+                                   const char* const* argv,
+                                   std::string_view name,
+                                   std::string_view defaultValue)
+{
+    for (int i_arg=1; i_arg<argc - 1; ++i_arg) {
+        if (argv[i_arg] == name) {
+            return argv[i_arg + 1];
+        }
+    }
+    return std::string(defaultValue);
+}
+
+
+/// @brief Check whether a "--name" command line flag was passed.
+inline bool hasFlag(int argc,
+                    const char* const* argv,
+                    std::string_view name)
+{
+    for (int i_arg=1; i_arg<argc; ++i_arg) {
+        if (argv[i_arg] == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/// @brief Get the instance settings for the performance warning options of @ref checkPerformanceWarnings.
+/// @details Best practices checks are enabled if either option is passed.
+inline VulkanInstance::Settings getInstanceSettings(int argc,
+                                                    const char* const* argv)
+{
+    VulkanInstance::Settings settings;
+    settings.bestPractices =    !getStringOption(argc, argv, "--performance-warnings", "").empty()
+                             || !getStringOption(argc, argv, "--performance-baseline", "").empty();
+    return settings;
+}
+
+
+/// @brief Export the context's performance warnings and compare them to a baseline.
+/// @details Options:
+///          - --performance-warnings PATH: JSON file to write the warnings to (default: none)
+///          - --performance-baseline PATH: JSON file of a previous run to compare against (default: none)
+/// @return false if a warning with a message ID not in the baseline showed up.
+inline bool checkPerformanceWarnings(const Context& r_context,
+                                     int argc,
+                                     const char* const* argv)
+{
+    const auto& r_warnings = *r_context.p_performanceWarnings;
+
+    const std::string outputPath = getStringOption(argc, argv, "--performance-warnings", "");
+    if (!outputPath.empty()) {
+        std::ofstream file(outputPath);
+        if (!file) {
+            throw std::runtime_error("Failed to open performance warnings output '" + outputPath + "'");
+        }
+        r_warnings.writeJSON(file);
+    }
+
+    const std::string baselinePath = getStringOption(argc, argv, "--performance-baseline", "");
+    if (baselinePath.empty()) {
+        return true;
+    }
+
+    std::ifstream file(baselinePath);
+    if (!file) {
+        throw std::runtime_error("Failed to open performance baseline '" + baselinePath + "'");
+    }
+    const auto newRecords = r_warnings.getNewRecords(PerformanceWarnings::readMessageIds(file));
+    for (const auto& r_record : newRecords) {
+        std::cerr << "new performance warning: " << r_record.messageIdName
+                  << " (" << r_record.count << " times)\n";
+    }
+    return newRecords.empty();
+}
+
+
+/// @brief Wall clock time spent executing a callable [s].
+template <class TFunction>
+double measure(TFunction&& r_function)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    r_function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+
+} // namespace benchmark
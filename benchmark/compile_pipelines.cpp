@@ -0,0 +1,106 @@
+/// @file Measures how pipeline compilation scales with the number of worker threads.
+/// @details Every run compiles the same batch of distinct pipelines on a fresh
+///          @ref PipelineCompiler with a fresh, shared @ref PipelineCache.
+///          Run it on a software driver to get CPU bound results, and disable
+///          the driver's own on-disk cache (e.g.: MESA_SHADER_CACHE_DISABLE=true).
+///          Options:
+///          - --pipelines N: number of pipelines per batch (default: 16)
+///          - --max-threads N: largest thread count to test (default: hardware threads)
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "PipelineCompiler.hpp"
+
+// --- STL Includes ---
+#include <iostream>
+#include <iomanip>
+#include <array>
+#include <thread>
+
+
+namespace {
+
+
+/// @brief Color formats and final layouts that make up distinct pipelines.
+constexpr std::array<VkFormat,8> colorFormats {VK_FORMAT_R8G8B8A8_UNORM,
+                                               VK_FORMAT_R8G8B8A8_SRGB,
+                                               VK_FORMAT_B8G8R8A8_UNORM,
+                                               VK_FORMAT_B8G8R8A8_SRGB,
+                                               VK_FORMAT_R16G16B16A16_SFLOAT,
+                                               VK_FORMAT_R32G32B32A32_SFLOAT,
+                                               VK_FORMAT_A2B10G10R10_UNORM_PACK32,
+                                               VK_FORMAT_R16G16B16A16_UNORM};
+
+constexpr std::array<VkImageLayout,2> finalLayouts {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t pipelineCount = benchmark::getOption(argc, argv, "--pipelines", colorFormats.size() * finalLayouts.size());
+    const std::size_t maxThreadCount = benchmark::getOption(argc, argv, "--max-threads", std::max(std::thread::hardware_concurrency(), 1u));
+
+    auto context = benchmark::makeHeadlessContext();
+
+    // Descriptions beyond the number of distinct combinations are cache hits
+    std::vector<Pipeline::Description> descriptions(pipelineCount);
+    for (std::size_t i_pipeline=0; i_pipeline<pipelineCount; ++i_pipeline) {
+        auto& r_description = descriptions[i_pipeline];
+        r_description.vertexShader = benchmark::makeShaderIO("vertexShader.vert.spv");
+        r_description.fragmentShader = benchmark::makeShaderIO("fragmentShader.frag.spv");
+        r_description.colorFormat = colorFormats[i_pipeline % colorFormats.size()];
+        r_description.finalLayout = finalLayouts[(i_pipeline / colorFormats.size()) % finalLayouts.size()];
+    }
+
+    const auto cachePath = std::filesystem::temp_directory_path() / "vktutorial_benchmark_compile_pipelines.cache";
+
+    std::cout << std::setw(8) << "threads"
+              << std::setw(12) << "time [ms]"
+              << std::setw(10) << "speedup"
+              << std::setw(8) << "hits"
+              << std::setw(8) << "misses"
+              << std::setw(9) << "unknown" << '\n';
+
+    double serialTime = 0.0;
+    for (std::size_t threadCount=1; threadCount<=maxThreadCount; threadCount*=2) {
+        // Start each run with a cold cache
+        std::filesystem::remove(cachePath);
+        auto p_cache = std::make_shared<PipelineCache>(context.p_logicalDevice, std::filesystem::path(cachePath));
+
+        std::vector<std::shared_ptr<Pipeline>> pipelines;
+        double time = 0.0;
+        {
+            PipelineCompiler compiler(context.p_logicalDevice, p_cache, threadCount);
+            time = benchmark::measure([&]() {
+                for (auto& r_result : compiler.compile(descriptions)) {
+                    pipelines.push_back(r_result.get());
+                }
+            });
+        }
+
+        if (threadCount == 1) {
+            serialTime = time;
+        }
+
+        const auto statistics = p_cache->getStatistics();
+        std::cout << std::setw(8) << threadCount
+                  << std::setw(12) << std::fixed << std::setprecision(2) << 1e3 * time
+                  << std::setw(10) << serialTime / time
+                  << std::setw(8) << statistics.hits
+                  << std::setw(8) << statistics.misses
+                  << std::setw(9) << statistics.unknown << '\n';
+
+        pipelines.clear();
+        p_cache.reset();
+
+        if (threadCount < maxThreadCount && maxThreadCount < 2 * threadCount) {
+            threadCount = maxThreadCount / 2; // <== make sure the largest thread count gets tested too
+        }
+    }
+
+    std::filesystem::remove(cachePath);
+    return 0;
+}
@@ -0,0 +1,218 @@
+/// @file Compares the kernels of @ref ComputeKernels with their CPU references in @ref CpuKernels.
+/// @details Runs saxpy, reduction and prefix scan on the same random values on the GPU, and on
+///          the CPU with every supported instruction set. Reports the fastest time of each and
+///          the resulting bandwidth, and checks all results against a double precision sum.
+///          GPU times include recording and submitting the batch, and waiting for it.
+///          Options:
+///          - --count N: number of values (default: 4194304)
+///          - --iterations N: number of runs per kernel and implementation, the fastest is reported (default: 10)
+///          - --performance-warnings, --performance-baseline: see @ref benchmark::checkPerformanceWarnings
+/// @return 1 if any result deviates from the reference by more than 1e-3 times the sum of the absolute values
+///         it is built from, or if new performance warnings showed up.
+/// @note Point the loader at a software driver (e.g.: lavapipe via VK_ICD_FILENAMES)
+///       to compare with the CPU on the same cores.
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "ComputeKernels.hpp"
+#include "CpuKernels.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+
+constexpr double tolerance = 1e-3;
+
+
+/// @brief Check a result against its reference, relative to the magnitude it was built from.
+bool isClose(double value, double reference, double magnitude) noexcept
+{
+    return std::abs(value - reference) <= tolerance * std::max(magnitude, 1.0);
+}
+
+
+void printRow(std::string_view kernel,
+              std::string_view implementation,
+              double time,
+              double byteCount,
+              bool isCorrect)
+{
+    std::cout << std::setw(10) << kernel
+              << std::setw(10) << implementation
+              << std::setw(12) << std::fixed << std::setprecision(3) << 1e3 * time
+              << std::setw(12) << std::setprecision(2) << byteCount / time / 1e9
+              << std::setw(8) << (isCorrect ? "ok" : "FAIL") << '\n';
+}
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t count = std::max<std::size_t>(benchmark::getOption(argc, argv, "--count", std::size_t(1) << 22), 1);
+    const std::size_t iterationCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--iterations", 10), 1);
+
+    auto context = benchmark::makeHeadlessContext(benchmark::getInstanceSettings(argc, argv));
+    const auto& rp_device = context.p_logicalDevice;
+
+    ComputeKernels::Settings kernelSettings;
+    kernelSettings.maxScanCount = count;
+    ComputeKernels kernels(rp_device, benchmark::makeShaderIO, kernelSettings);
+    ComputeDispatcher dispatcher(rp_device);
+
+    // Random inputs, and double precision references
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> x(count);
+    std::vector<float> y(count);
+    std::generate(x.begin(), x.end(), [&]() {return distribution(generator);});
+    std::generate(y.begin(), y.end(), [&]() {return distribution(generator);});
+    const float a = 0.5f;
+
+    std::vector<double> saxpyReference(count);
+    std::vector<double> scanReference(count);
+    std::vector<double> scanMagnitudes(count);
+    double sum = 0.0;
+    double magnitude = 0.0;
+    for (std::size_t i=0; i<count; ++i) {
+        saxpyReference[i] = double(a) * x[i] + y[i];
+        sum += x[i];
+        magnitude += std::abs(x[i]);
+        scanReference[i] = sum;
+        scanMagnitudes[i] = magnitude;
+    }
+
+    StorageBuffer xBuffer(rp_device, count * sizeof(float));
+    StorageBuffer yBuffer(rp_device, count * sizeof(float));
+    StorageBuffer sumBuffer(rp_device, sizeof(float));
+
+    std::vector<CpuKernels::InstructionSet> instructionSets;
+    for (auto instructionSet : {CpuKernels::InstructionSet::Scalar, CpuKernels::InstructionSet::AVX2, CpuKernels::InstructionSet::NEON}) {
+        if (CpuKernels::isSupported(instructionSet)) {
+            instructionSets.push_back(instructionSet);
+        }
+    }
+
+    // Run each implementation on fresh copies of the inputs, keeping the fastest time and the last result
+    const auto run = [iterationCount](auto&& r_reset, auto&& r_function) -> double {
+        double bestTime = std::numeric_limits<double>::max();
+        for (std::size_t i_iteration=0; i_iteration<iterationCount; ++i_iteration) {
+            r_reset();
+            bestTime = std::min(bestTime, benchmark::measure(r_function));
+        }
+        return bestTime;
+    };
+
+    const auto checkSaxpy = [&](std::span<const float> result) -> bool {
+        for (std::size_t i=0; i<count; ++i) {
+            if (!isClose(result[i], saxpyReference[i], std::abs(a * x[i]) + std::abs(y[i]))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const auto checkScan = [&](std::span<const float> result) -> bool {
+        for (std::size_t i=0; i<count; ++i) {
+            if (!isClose(result[i], scanReference[i], scanMagnitudes[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::cout << "device: " << rp_device->getPhysicalDevice().getName() << '\n'
+              << "values: " << count << "\n\n"
+              << std::setw(10) << "kernel"
+              << std::setw(10) << "impl"
+              << std::setw(12) << "time [ms]"
+              << std::setw(12) << "GB/s"
+              << std::setw(8) << "check" << '\n';
+
+    bool isCorrect = true;
+    const double valueSize = sizeof(float);
+
+    // saxpy: reads x and y, writes y
+    {
+        const double byteCount = 3.0 * count * valueSize;
+        const auto reset = [&]() {
+            std::copy(x.begin(), x.end(), xBuffer.view<float>().begin());
+            std::copy(y.begin(), y.end(), yBuffer.view<float>().begin());
+        };
+        const double time = run(reset, [&]() {
+            dispatcher.begin();
+            kernels.saxpy(dispatcher, a, xBuffer, yBuffer, count);
+            dispatcher.submit();
+        });
+        const bool isGpuCorrect = checkSaxpy(yBuffer.view<const float>().first(count));
+        printRow("saxpy", "GPU", time, byteCount, isGpuCorrect);
+        isCorrect &= isGpuCorrect;
+
+        std::vector<float> result(count);
+        for (auto instructionSet : instructionSets) {
+            const double cpuTime = run([&]() {result = y;},
+                                       [&]() {CpuKernels::saxpy(a, x, result, instructionSet);});
+            const bool isCpuCorrect = checkSaxpy(result);
+            printRow("saxpy", CpuKernels::getName(instructionSet), cpuTime, byteCount, isCpuCorrect);
+            isCorrect &= isCpuCorrect;
+        }
+    }
+
+    // reduce: reads x
+    {
+        const double byteCount = count * valueSize;
+        std::copy(x.begin(), x.end(), xBuffer.view<float>().begin());
+        const double time = run([]() {}, [&]() {
+            dispatcher.begin();
+            kernels.reduce(dispatcher, xBuffer, sumBuffer, count);
+            dispatcher.submit();
+        });
+        const bool isGpuCorrect = isClose(sumBuffer.view<const float>().front(), sum, magnitude);
+        printRow("reduce", "GPU", time, byteCount, isGpuCorrect);
+        isCorrect &= isGpuCorrect;
+
+        for (auto instructionSet : instructionSets) {
+            float result = 0.0f;
+            const double cpuTime = run([]() {}, [&]() {result = CpuKernels::reduce(x, instructionSet);});
+            const bool isCpuCorrect = isClose(result, sum, magnitude);
+            printRow("reduce", CpuKernels::getName(instructionSet), cpuTime, byteCount, isCpuCorrect);
+            isCorrect &= isCpuCorrect;
+        }
+    }
+
+    // scan: reads and writes x
+    {
+        const double byteCount = 2.0 * count * valueSize;
+        const double time = run([&]() {std::copy(x.begin(), x.end(), xBuffer.view<float>().begin());}, [&]() {
+            dispatcher.begin();
+            kernels.scan(dispatcher, xBuffer, count);
+            dispatcher.submit();
+        });
+        const bool isGpuCorrect = checkScan(xBuffer.view<const float>().first(count));
+        printRow("scan", "GPU", time, byteCount, isGpuCorrect);
+        isCorrect &= isGpuCorrect;
+
+        std::vector<float> result(count);
+        for (auto instructionSet : instructionSets) {
+            const double cpuTime = run([&]() {result = x;},
+                                       [&]() {CpuKernels::scan(result, instructionSet);});
+            const bool isCpuCorrect = checkScan(result);
+            printRow("scan", CpuKernels::getName(instructionSet), cpuTime, byteCount, isCpuCorrect);
+            isCorrect &= isCpuCorrect;
+        }
+    }
+
+    isCorrect &= benchmark::checkPerformanceWarnings(context, argc, argv);
+    return isCorrect ? 0 : 1;
+}
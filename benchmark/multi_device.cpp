@@ -0,0 +1,345 @@
+/// @file Measures rendering tiles of an offscreen image on all suitable devices at once.
+/// @details Creates a @ref LogicalDevice per suitable @ref PhysicalDevice, and lets a
+///          @ref DeviceScheduler split the tiles of a square image across them. Each device
+///          renders its tiles (the triangle pipeline, drawn repeatedly, offset so that every
+///          tile shows its part of the whole image), reads them back, and the tiles are
+///          copied into the final image as their chunks finish. Reports the throughput
+///          estimate and share of the tiles of each device after every run.
+///          Options:
+///          - --resolution N: width and height of the final image [pixels] (default: 2048)
+///          - --tile-size N: width and height of a tile [pixels] (default: 256)
+///          - --draws N: number of triangles drawn per tile (default: 100)
+///          - --iterations N: number of times to render the whole image (default: 10)
+///          - --replicas N: logical devices per physical device (default: 1)
+///          - --output PATH: write the final image of the last iteration to PATH as PPM
+/// @note Several replicas on a single software driver exercise the scheduling without
+///       multiple GPUs. The loader accepts several drivers at once, e.g.:
+///       VK_ICD_FILENAMES=lvp_icd.x86_64.json:radeon_icd.x86_64.json
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "DeviceScheduler.hpp"
+#include "OffscreenTarget.hpp"
+#include "Pipeline.hpp"
+#include "Framebuffers.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+
+namespace {
+
+
+/// @brief Everything a device needs to render and read back a tile.
+struct TileRenderer
+{
+    TileRenderer(const std::shared_ptr<LogicalDevice>& rp_device, uint32_t tileSize)
+        : p_device(rp_device),
+          p_target(),
+          p_views(),
+          p_pipeline(),
+          p_framebuffers(),
+          commandPool(VK_NULL_HANDLE),
+          commandBuffer(VK_NULL_HANDLE),
+          fence(VK_NULL_HANDLE),
+          readback(VK_NULL_HANDLE),
+          readbackMemory()
+    {
+        const VkDevice device = p_device->getDevice();
+
+        OffscreenTarget::Settings targetSettings;
+        targetSettings.extent = {tileSize, tileSize};
+        targetSettings.imageCount = 1;
+        targetSettings.unthrottled = true;
+        p_target = std::make_shared<OffscreenTarget>(p_device, targetSettings);
+        p_views = std::make_shared<RenderTarget::ImageViews>(p_target);
+
+        p_pipeline = std::make_unique<Pipeline>(p_device,
+                                                benchmark::makeShaderIO("vertexShader.vert.spv"),
+                                                benchmark::makeShaderIO("fragmentShader.frag.spv"),
+                                                p_target->getImageFormat(),
+                                                p_target->getFinalLayout());
+        p_framebuffers = std::make_unique<Framebuffers>(p_views, p_pipeline->getRenderPass());
+
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = p_device->getQueueFamilyIndex(LogicalDevice::QueueType::Graphics);
+        if (vkCreateCommandPool(device, &poolInfo, p_device->getAllocationCallbacks(), &commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create command pool");
+        }
+
+        VkCommandBufferAllocateInfo bufferInfo {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        bufferInfo.commandPool = commandPool;
+        bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        bufferInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &bufferInfo, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate command buffer");
+        }
+
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device, &fenceInfo, p_device->getAllocationCallbacks(), &fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create fence");
+        }
+
+        VkBufferCreateInfo readbackInfo {};
+        readbackInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        readbackInfo.size = VkDeviceSize(tileSize) * tileSize * sizeof(uint32_t);
+        readbackInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        readbackInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vkCreateBuffer(device, &readbackInfo, p_device->getAllocationCallbacks(), &readback) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create readback buffer");
+        }
+        readbackMemory = p_device->getAllocator().allocate(readback,
+                                                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                           VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    }
+
+    TileRenderer(const TileRenderer&) = delete;
+
+    ~TileRenderer()
+    {
+        const VkDevice device = p_device->getDevice();
+        vkDeviceWaitIdle(device);
+        vkDestroyBuffer(device, readback, p_device->getAllocationCallbacks());
+        p_device->getAllocator().free(readbackMemory);
+        vkDestroyFence(device, fence, p_device->getAllocationCallbacks());
+        vkDestroyCommandPool(device, commandPool, p_device->getAllocationCallbacks());
+    }
+
+    /// @brief Render the tile at @a offset of a @a resolution sized image and copy it to @a p_output.
+    void render(VkOffset2D offset,
+                uint32_t resolution,
+                std::size_t drawCount,
+                uint32_t* p_output)
+    {
+        const VkDevice device = p_device->getDevice();
+        const VkExtent2D extent = p_target->getImageExtent();
+
+        vkResetCommandBuffer(commandBuffer, 0);
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+        VkClearValue clearValue {};
+        VkRenderPassBeginInfo renderPassInfo {};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = p_pipeline->getRenderPass();
+        renderPassInfo.framebuffer = p_framebuffers->get(0);
+        renderPassInfo.renderArea.extent = extent;
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearValue;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, p_pipeline->get());
+
+        // The viewport covers the whole image, shifted so that the tile lands on the framebuffer
+        const VkViewport viewport {static_cast<float>(-offset.x),
+                                   static_cast<float>(-offset.y),
+                                   static_cast<float>(resolution),
+                                   static_cast<float>(resolution),
+                                   0.0f,
+                                   1.0f};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+        const VkRect2D scissor {{0, 0}, extent};
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        vkCmdDraw(commandBuffer, 3, static_cast<uint32_t>(drawCount), 0, 0);
+        vkCmdEndRenderPass(commandBuffer);
+
+        // The render pass leaves the image in its final (transfer source) layout
+        VkImageMemoryBarrier renderBarrier {};
+        renderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        renderBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        renderBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        renderBarrier.oldLayout = p_target->getFinalLayout();
+        renderBarrier.newLayout = p_target->getFinalLayout();
+        renderBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        renderBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        renderBarrier.image = p_target->getImages().front();
+        renderBarrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0, nullptr,
+                             0, nullptr,
+                             1, &renderBarrier);
+
+        VkBufferImageCopy region {};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {extent.width, extent.height, 1};
+        vkCmdCopyImageToBuffer(commandBuffer,
+                               p_target->getImages().front(),
+                               p_target->getFinalLayout(),
+                               readback,
+                               1,
+                               &region);
+
+        VkBufferMemoryBarrier readbackBarrier {};
+        readbackBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        readbackBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        readbackBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        readbackBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        readbackBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        readbackBarrier.buffer = readback;
+        readbackBarrier.size = VK_WHOLE_SIZE;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT,
+                             0,
+                             0, nullptr,
+                             1, &readbackBarrier,
+                             0, nullptr);
+
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to record tile");
+        }
+
+        VkSubmitInfo submitInfo {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+        vkResetFences(device, 1, &fence);
+        if (vkQueueSubmit(p_device->getQueue(), 1, &submitInfo, fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit tile");
+        }
+        vkWaitForFences(device, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+
+        std::memcpy(p_output, readbackMemory.p_mapped, std::size_t(extent.width) * extent.height * sizeof(uint32_t));
+    }
+
+    std::shared_ptr<LogicalDevice> p_device;
+
+    std::shared_ptr<OffscreenTarget> p_target;
+
+    std::shared_ptr<RenderTarget::ImageViews> p_views;
+
+    std::unique_ptr<Pipeline> p_pipeline;
+
+    std::unique_ptr<Framebuffers> p_framebuffers;
+
+    VkCommandPool commandPool;
+
+    VkCommandBuffer commandBuffer;
+
+    VkFence fence;
+
+    VkBuffer readback;
+
+    DeviceAllocator::Allocation readbackMemory;
+}; // struct TileRenderer
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const auto resolution = static_cast<uint32_t>(std::max<std::size_t>(benchmark::getOption(argc, argv, "--resolution", 2048), 1));
+    const auto tileSize = static_cast<uint32_t>(std::clamp<std::size_t>(benchmark::getOption(argc, argv, "--tile-size", 256), 1, resolution));
+    const std::size_t drawCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--draws", 100), 1);
+    const std::size_t iterationCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--iterations", 10), 1);
+    const std::size_t replicaCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--replicas", 1), 1);
+    const std::string outputPath = benchmark::getStringOption(argc, argv, "--output", "");
+
+    // Locals are destroyed in reverse order of declaration, so devices outlive the renderers
+    auto p_instance = std::make_shared<VulkanInstance>(benchmark::getHeadlessExtensions());
+    DeviceScheduler scheduler(DeviceScheduler::createDevices(p_instance->get(), replicaCount));
+
+    std::vector<std::unique_ptr<TileRenderer>> renderers;
+    for (std::size_t i_device=0; i_device<scheduler.getDeviceCount(); ++i_device) {
+        const auto& rp_device = scheduler.getDevice(i_device);
+        renderers.push_back(std::make_unique<TileRenderer>(rp_device, tileSize));
+        std::cout << "device " << i_device << ": " << rp_device->getPhysicalDevice().getName() << '\n';
+    }
+
+    // Tiles are numbered row by row; the last row and column are cropped
+    const uint32_t tilesPerRow = (resolution + tileSize - 1) / tileSize;
+    const std::size_t tileCount = std::size_t(tilesPerRow) * tilesPerRow;
+    const std::size_t tilePixelCount = std::size_t(tileSize) * tileSize;
+    const auto getTileOffset = [tilesPerRow, tileSize](std::size_t i_tile) -> VkOffset2D {
+        return {static_cast<int32_t>((i_tile % tilesPerRow) * tileSize),
+                static_cast<int32_t>((i_tile / tilesPerRow) * tileSize)};
+    };
+
+    std::vector<uint32_t> tiles(tileCount * tilePixelCount);
+    std::vector<uint32_t> image(std::size_t(resolution) * resolution);
+
+    const auto execute = [&](std::size_t i_device, std::size_t begin, std::size_t end) {
+        for (std::size_t i_tile=begin; i_tile<end; ++i_tile) {
+            renderers[i_device]->render(getTileOffset(i_tile),
+                                        resolution,
+                                        drawCount,
+                                        tiles.data() + i_tile * tilePixelCount);
+        }
+    };
+
+    const auto merge = [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i_tile=begin; i_tile<end; ++i_tile) {
+            const VkOffset2D offset = getTileOffset(i_tile);
+            const uint32_t width = std::min(tileSize, resolution - static_cast<uint32_t>(offset.x));
+            const uint32_t height = std::min(tileSize, resolution - static_cast<uint32_t>(offset.y));
+            for (uint32_t i_row=0; i_row<height; ++i_row) {
+                std::copy_n(tiles.data() + i_tile * tilePixelCount + std::size_t(i_row) * tileSize,
+                            width,
+                            image.data() + (std::size_t(offset.y) + i_row) * resolution + offset.x);
+            }
+        }
+    };
+
+    std::cout << std::setw(10) << "iteration"
+              << std::setw(12) << "time [ms]"
+              << std::setw(12) << "tiles/s";
+    for (std::size_t i_device=0; i_device<scheduler.getDeviceCount(); ++i_device) {
+        std::cout << std::setw(16) << ("device " + std::to_string(i_device) + " [%]");
+    }
+    std::cout << '\n';
+
+    for (std::size_t i_iteration=0; i_iteration<iterationCount; ++i_iteration) {
+        const auto chunks = scheduler.split(tileCount);
+        const double time = benchmark::measure([&]() {
+            scheduler.run(tileCount, execute, merge);
+        });
+
+        std::cout << std::setw(10) << i_iteration
+                  << std::setw(12) << std::fixed << std::setprecision(2) << 1e3 * time
+                  << std::setw(12) << std::setprecision(0) << tileCount / time;
+        for (const auto& r_chunk : chunks) {
+            std::cout << std::setw(16) << std::setprecision(1) << 1e2 * r_chunk.size() / tileCount;
+        }
+        std::cout << '\n';
+    }
+
+    std::cout << "\nthroughput estimates [tiles/s]:";
+    for (double throughput : scheduler.getThroughputs()) {
+        std::cout << ' ' << std::setprecision(0) << throughput;
+    }
+    std::cout << '\n';
+
+    if (!outputPath.empty()) {
+        // Binary PPM; the target's format is R8G8B8A8, so alpha is dropped
+        std::ofstream file(outputPath, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Failed to open " + outputPath);
+        }
+        file << "P6\n" << resolution << ' ' << resolution << "\n255\n";
+        for (uint32_t pixel : image) {
+            const char rgb[3] {static_cast<char>(pixel & 0xff),
+                               static_cast<char>((pixel >> 8) & 0xff),
+                               static_cast<char>((pixel >> 16) & 0xff)};
+            file.write(rgb, 3);
+        }
+    }
+
+    return 0;
+}
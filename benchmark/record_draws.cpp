@@ -0,0 +1,164 @@
+/// @file Measures how recording a scene of many draws scales with the number of threads.
+/// @details Records the draws into secondary command buffers with @ref CommandRecorder,
+///          executes them from a primary buffer within the offscreen target's render pass,
+///          and submits the result once per thread count to make sure it is valid.
+///          Options:
+///          - --draws N: number of draws in the scene (default: 100000)
+///          - --iterations N: number of recordings per thread count, the fastest is reported (default: 10)
+///          - --max-threads N: largest thread count to test (default: hardware threads)
+///          - --performance-warnings, --performance-baseline: see @ref benchmark::checkPerformanceWarnings
+/// @return 1 if new performance warnings showed up.
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "CommandRecorder.hpp"
+#include "OffscreenTarget.hpp"
+#include "Pipeline.hpp"
+#include "Framebuffers.hpp"
+
+// --- STL Includes ---
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <thread>
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t drawCount = benchmark::getOption(argc, argv, "--draws", 100000);
+    const std::size_t iterationCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--iterations", 10), 1);
+    const std::size_t maxThreadCount = benchmark::getOption(argc, argv, "--max-threads", std::max(std::thread::hardware_concurrency(), 1u));
+
+    auto context = benchmark::makeHeadlessContext(benchmark::getInstanceSettings(argc, argv));
+    const auto& rp_device = context.p_logicalDevice;
+    const VkDevice device = rp_device->getDevice();
+
+    // Render into a single offscreen image
+    OffscreenTarget::Settings targetSettings;
+    targetSettings.imageCount = 1;
+    targetSettings.unthrottled = true;
+    auto p_target = std::make_shared<OffscreenTarget>(rp_device, targetSettings);
+    auto p_views = std::make_shared<RenderTarget::ImageViews>(p_target);
+
+    Pipeline pipeline(rp_device,
+                      benchmark::makeShaderIO("vertexShader.vert.spv"),
+                      benchmark::makeShaderIO("fragmentShader.frag.spv"),
+                      p_target->getImageFormat(),
+                      p_target->getFinalLayout());
+    Framebuffers framebuffers(p_views, pipeline.getRenderPass());
+
+    // Primary command buffer and a fence to check the recording with
+    const auto queueFamily = rp_device->getPhysicalDevice().getQueueFamily({});
+    VkCommandPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamily.graphics.value();
+    VkCommandPool commandPool;
+    if (vkCreateCommandPool(device, &poolInfo, rp_device->getAllocationCallbacks(), &commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create command pool");
+    }
+
+    VkCommandBufferAllocateInfo bufferInfo {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    bufferInfo.commandPool = commandPool;
+    bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    bufferInfo.commandBufferCount = 1;
+    VkCommandBuffer primary;
+    if (vkAllocateCommandBuffers(device, &bufferInfo, &primary) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate primary command buffer");
+    }
+
+    VkFenceCreateInfo fenceInfo {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence;
+    if (vkCreateFence(device, &fenceInfo, rp_device->getAllocationCallbacks(), &fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create fence");
+    }
+
+    const VkExtent2D extent = p_target->getImageExtent();
+    const auto recordBatch = [&pipeline, extent](VkCommandBuffer commandBuffer, std::size_t begin, std::size_t end) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.get());
+
+        const VkViewport viewport {0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height), 0.0f, 1.0f};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+        const VkRect2D scissor {{0, 0}, extent};
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        for (std::size_t i_draw=begin; i_draw<end; ++i_draw) {
+            vkCmdDraw(commandBuffer, 3, 1, 0, static_cast<uint32_t>(i_draw));
+        }
+    };
+
+    std::cout << std::setw(8) << "threads"
+              << std::setw(12) << "time [ms]"
+              << std::setw(14) << "draws/s"
+              << std::setw(10) << "speedup" << '\n';
+
+    double serialTime = 0.0;
+    for (std::size_t threadCount=1; threadCount<=maxThreadCount; threadCount*=2) {
+        CommandRecorder recorder(rp_device, 1, threadCount);
+
+        double bestTime = std::numeric_limits<double>::max();
+        for (std::size_t i_iteration=0; i_iteration<iterationCount; ++i_iteration) {
+            recorder.beginFrame();
+            vkResetCommandBuffer(primary, 0);
+
+            const double time = benchmark::measure([&]() {
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(primary, &beginInfo);
+
+                VkClearValue clearValue {};
+                VkRenderPassBeginInfo renderPassInfo {};
+                renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                renderPassInfo.renderPass = pipeline.getRenderPass();
+                renderPassInfo.framebuffer = framebuffers.get(0);
+                renderPassInfo.renderArea.extent = extent;
+                renderPassInfo.clearValueCount = 1;
+                renderPassInfo.pClearValues = &clearValue;
+                vkCmdBeginRenderPass(primary, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+                CommandRecorder::Inheritance inheritance;
+                inheritance.renderPass = pipeline.getRenderPass();
+                inheritance.framebuffer = framebuffers.get(0);
+                recorder.record(primary, inheritance, drawCount, recordBatch);
+
+                vkCmdEndRenderPass(primary);
+                vkEndCommandBuffer(primary);
+            });
+            bestTime = std::min(bestTime, time);
+
+            // Execute the last recording once to make sure it's valid
+            if (i_iteration + 1 == iterationCount) {
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers = &primary;
+                vkResetFences(device, 1, &fence);
+                if (vkQueueSubmit(rp_device->getQueue(), 1, &submitInfo, fence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit recorded draws");
+                }
+                vkWaitForFences(device, 1, &fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+            }
+        }
+
+        if (threadCount == 1) {
+            serialTime = bestTime;
+        }
+
+        std::cout << std::setw(8) << threadCount
+                  << std::setw(12) << std::fixed << std::setprecision(2) << 1e3 * bestTime
+                  << std::setw(14) << std::setprecision(0) << drawCount / bestTime
+                  << std::setw(10) << std::setprecision(2) << serialTime / bestTime << '\n';
+
+        if (threadCount < maxThreadCount && maxThreadCount < 2 * threadCount) {
+            threadCount = maxThreadCount / 2; // <== make sure the largest thread count gets tested too
+        }
+    }
+
+    vkDestroyFence(device, fence, rp_device->getAllocationCallbacks());
+    vkDestroyCommandPool(device, commandPool, rp_device->getAllocationCallbacks());
+    return benchmark::checkPerformanceWarnings(context, argc, argv) ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+/// @file Measures the bootstrap steps behind @ref Application::Application without a window.
+/// @details Every iteration constructs, then destroys:
+///          - a @ref VulkanInstance
+///          - the default @ref PhysicalDevice
+///          - a @ref GraphicsLogicalDevice
+///          - an @ref OffscreenTarget, standing in for the @ref SwapChain
+///          - the vertex and fragment @ref Shader "Shaders"
+///          and reports the first (cold) timing, and the minimum, median, 90th and 99th
+///          percentile and maximum of each step.
+///          Options:
+///          - --iterations N: number of times to run the whole sequence (default: 20)
+///          - --csv PATH: also write the statistics as comma separated values, for diffing across commits
+///          - --no-swapchain: construct a plain @ref LogicalDevice, for drivers without VK_KHR_swapchain
+///          - --capability-cache PATH: pick the device through a @ref CapabilityCache stored at PATH,
+///            loaded and saved within the step. Only the first iteration is cold if PATH didn't exist.
+/// @note Point the loader at a software driver (e.g.: lavapipe via VK_ICD_FILENAMES)
+///       for results that don't depend on the GPU.
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "OffscreenTarget.hpp"
+#include "CapabilityCache.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+
+struct Step
+{
+    std::string name;
+
+    /// @brief Time of each iteration [s].
+    std::vector<double> times;
+}; // struct Step
+
+
+/// @brief Summary of a @ref Step [ms].
+struct Summary
+{
+    double first;
+
+    double min;
+
+    double median;
+
+    double p90;
+
+    double p99;
+
+    double max;
+}; // struct Summary
+
+
+Summary summarize(const std::vector<double>& r_times)
+{
+    std::vector<double> sorted = r_times;
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest-rank percentiles
+    const auto percentile = [&sorted](double fraction) -> double {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+        return 1e3 * sorted[std::max<std::size_t>(rank, 1) - 1];
+    };
+
+    return Summary {
+        1e3 * r_times.front(),
+        1e3 * sorted.front(),
+        percentile(0.5),
+        percentile(0.9),
+        percentile(0.99),
+        1e3 * sorted.back()
+    };
+}
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t iterationCount = std::max<std::size_t>(benchmark::getOption(argc, argv, "--iterations", 20), 1);
+    const std::string csvPath = benchmark::getStringOption(argc, argv, "--csv", "");
+    const bool useSwapChainDevice = !benchmark::hasFlag(argc, argv, "--no-swapchain");
+    const std::string capabilityCachePath = benchmark::getStringOption(argc, argv, "--capability-cache", "");
+
+    std::vector<Step> steps {
+        {"instance", {}},
+        {"physical device", {}},
+        {"logical device", {}},
+        {"render target", {}},
+        {"shaders", {}},
+        {"teardown", {}},
+        {"total", {}}
+    };
+
+    for (std::size_t i_iteration=0; i_iteration<iterationCount; ++i_iteration) {
+        std::shared_ptr<VulkanInstance> p_instance;
+        std::shared_ptr<PhysicalDevice> p_physicalDevice;
+        std::shared_ptr<LogicalDevice> p_logicalDevice;
+        std::shared_ptr<OffscreenTarget> p_target;
+        std::unique_ptr<Shader> p_vertexShader, p_fragmentShader;
+
+        std::vector<double> times;
+        times.push_back(benchmark::measure([&]() {
+            p_instance = std::make_shared<VulkanInstance>(benchmark::getHeadlessExtensions());
+        }));
+
+        times.push_back(benchmark::measure([&]() {
+            std::optional<PhysicalDevice> physicalDevice;
+            if (capabilityCachePath.empty()) {
+                physicalDevice = PhysicalDevice::getDefaultDevice(p_instance->get(), std::nullopt);
+            } else {
+                CapabilityCache cache{std::filesystem::path(capabilityCachePath)};
+                physicalDevice = cache.getDefaultDevice(p_instance->get(), std::nullopt);
+            }
+            if (!physicalDevice.has_value()) {
+                throw std::runtime_error("No suitable physical device found");
+            }
+            p_physicalDevice = std::make_shared<PhysicalDevice>(physicalDevice.value());
+        }));
+
+        times.push_back(benchmark::measure([&]() {
+            if (useSwapChainDevice) {
+                p_logicalDevice = std::make_shared<GraphicsLogicalDevice>(p_physicalDevice);
+            } else {
+                p_logicalDevice = std::make_shared<LogicalDevice>(p_physicalDevice);
+            }
+        }));
+
+        times.push_back(benchmark::measure([&]() {
+            p_target = std::make_shared<OffscreenTarget>(p_logicalDevice, OffscreenTarget::Settings());
+        }));
+
+        times.push_back(benchmark::measure([&]() {
+            p_vertexShader = std::make_unique<Shader>(*benchmark::makeShaderIO("vertexShader.vert.spv"), *p_logicalDevice);
+            p_fragmentShader = std::make_unique<Shader>(*benchmark::makeShaderIO("fragmentShader.frag.spv"), *p_logicalDevice);
+        }));
+
+        // In the reverse order of construction, like Application
+        times.push_back(benchmark::measure([&]() {
+            p_fragmentShader.reset();
+            p_vertexShader.reset();
+            p_target.reset();
+            p_logicalDevice.reset();
+            p_physicalDevice.reset();
+            p_instance.reset();
+        }));
+
+        times.push_back(std::accumulate(times.begin(), times.end(), 0.0));
+        for (std::size_t i_step=0; i_step<steps.size(); ++i_step) {
+            steps[i_step].times.push_back(times[i_step]);
+        }
+    }
+
+    std::cout << iterationCount << " iterations [ms]\n"
+              << std::left << std::setw(16) << "step" << std::right
+              << std::setw(10) << "first"
+              << std::setw(10) << "min"
+              << std::setw(10) << "median"
+              << std::setw(10) << "p90"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "max" << '\n'
+              << std::fixed << std::setprecision(3);
+    for (const Step& r_step : steps) {
+        const Summary summary = summarize(r_step.times);
+        std::cout << std::left << std::setw(16) << r_step.name << std::right
+                  << std::setw(10) << summary.first
+                  << std::setw(10) << summary.min
+                  << std::setw(10) << summary.median
+                  << std::setw(10) << summary.p90
+                  << std::setw(10) << summary.p99
+                  << std::setw(10) << summary.max << '\n';
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream file(csvPath);
+        if (!file) {
+            throw std::runtime_error("Failed to open '" + csvPath + "'");
+        }
+
+        file << "step,iterations,first_ms,min_ms,median_ms,p90_ms,p99_ms,max_ms\n"
+             << std::fixed << std::setprecision(3);
+        for (const Step& r_step : steps) {
+            const Summary summary = summarize(r_step.times);
+            file << r_step.name << ','
+                 << iterationCount << ','
+                 << summary.first << ','
+                 << summary.min << ','
+                 << summary.median << ','
+                 << summary.p90 << ','
+                 << summary.p99 << ','
+                 << summary.max << '\n';
+        }
+    }
+
+    return 0;
+}
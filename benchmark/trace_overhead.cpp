@@ -0,0 +1,122 @@
+/// @file Measures the cost of recording a @ref Trace::Span.
+/// @details Compares an empty loop against one that opens a span per iteration, both through
+///          @ref Trace::Span directly (always recorded) and through @ref VKTUTORIAL_TRACE_SCOPE
+///          (recorded only if built with VKTUTORIAL_ENABLE_TRACING). Then repeats the direct
+///          measurement with an increasing number of threads recording concurrently.
+///          Options:
+///          - --spans N: number of spans per thread and measurement (default: 200000)
+///          - --threads N: maximum number of recording threads (default: number of hardware threads)
+/// @note Recorded spans are kept until the process exits.
+
+// --- Internal Includes ---
+#include "common.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Keeps the compiler from optimizing empty loop bodies away.
+void touch() noexcept
+{
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+
+double runEmpty(std::size_t spanCount)
+{
+    return benchmark::measure([spanCount]() {
+        for (std::size_t i_span=0; i_span<spanCount; ++i_span) {
+            touch();
+        }
+    });
+}
+
+
+double runSpans(std::size_t spanCount)
+{
+    return benchmark::measure([spanCount]() {
+        for (std::size_t i_span=0; i_span<spanCount; ++i_span) {
+            const Trace::Span span("benchmark");
+            touch();
+        }
+    });
+}
+
+
+double runMacro(std::size_t spanCount)
+{
+    return benchmark::measure([spanCount]() {
+        for (std::size_t i_span=0; i_span<spanCount; ++i_span) {
+            VKTUTORIAL_TRACE_SCOPE("benchmark");
+            touch();
+        }
+    });
+}
+
+
+/// @brief Record spans on @a threadCount threads at once.
+/// @return the average time per span on each thread [s].
+double runThreads(std::size_t threadCount, std::size_t spanCount)
+{
+    std::vector<double> times(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    for (std::size_t i_thread=0; i_thread<threadCount; ++i_thread) {
+        threads.emplace_back([&r_time = times[i_thread], spanCount]() {
+            // Register the thread's buffer outside of the measurement
+            Trace::record("register", 0, 0);
+            r_time = runSpans(spanCount);
+        });
+    }
+    for (auto& r_thread : threads) {
+        r_thread.join();
+    }
+
+    return *std::max_element(times.begin(), times.end()) / spanCount;
+}
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv)
+{
+    const std::size_t spanCount = benchmark::getOption(argc, argv, "--spans", 200000);
+    const std::size_t maxThreadCount = std::max<std::size_t>(
+        benchmark::getOption(argc, argv, "--threads", std::thread::hardware_concurrency()),
+        1
+    );
+
+    // Warm up, and register the main thread's buffer
+    runSpans(spanCount);
+
+    const double emptyTime = runEmpty(spanCount) / spanCount;
+    const double spanTime = runSpans(spanCount) / spanCount;
+    const double macroTime = runMacro(spanCount) / spanCount;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "empty loop:             " << 1e9 * emptyTime << " ns/iteration\n"
+              << "Trace::Span:            " << 1e9 * (spanTime - emptyTime) << " ns/span\n"
+              << "VKTUTORIAL_TRACE_SCOPE: " << 1e9 * (macroTime - emptyTime) << " ns/span"
+              << (Trace::isEnabled() ? "" : " (compiled out)") << '\n';
+
+    std::cout << "\nthreads  ns/span\n";
+    for (std::size_t threadCount=1; threadCount<=maxThreadCount; threadCount*=2) {
+        const double time = runThreads(threadCount, spanCount);
+        std::cout << std::setw(7) << threadCount << "  "
+                  << std::setw(7) << 1e9 * (time - emptyTime) << '\n';
+    }
+
+    std::cout << "\n" << Trace::getEventCount() << " spans recorded\n";
+    return 0;
+}
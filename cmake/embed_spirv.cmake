@@ -0,0 +1,74 @@
+# Generate a header embedding compiled SPIR-V modules as constexpr word arrays.
+# Usage:
+#   cmake -DOUTPUT=<header> -DSPIRVS=<spirv>[|<spirv>...] -P embed_spirv.cmake
+#
+# Words are assembled in little endian byte order, which is how glslc writes
+# them on the hosts this project supports. EmbeddedShaderIO checks the magic
+# number at runtime anyway.
+
+if(NOT OUTPUT OR NOT SPIRVS)
+    message(FATAL_ERROR "embed_spirv.cmake requires OUTPUT and SPIRVS")
+endif()
+
+string(REPLACE "|" ";" spirvs "${SPIRVS}")
+
+set(arrays "")
+set(entries "")
+foreach(spirv ${spirvs})
+    get_filename_component(spirv_name "${spirv}" NAME)
+    string(MAKE_C_IDENTIFIER "${spirv_name}" identifier)
+
+    file(READ "${spirv}" bytes HEX)
+    string(LENGTH "${bytes}" byte_count)
+    math(EXPR remainder "${byte_count} % 8")
+    if(byte_count EQUAL 0 OR NOT remainder EQUAL 0)
+        message(FATAL_ERROR "${spirv} is not a sequence of 32 bit SPIR-V words")
+    endif()
+
+    # 4 bytes => 1 little endian word, 8 words per line
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u, " words "${bytes}")
+    set(word "0x[0-9a-f]+u, ")
+    string(REGEX REPLACE "(${word}${word}${word}${word}${word}${word}${word}${word})" "\\1\n    " words "${words}")
+    string(REGEX REPLACE ", \n" ",\n" words "${words}")
+    string(REGEX REPLACE "[ \n]+$" "" words "${words}")
+
+    string(APPEND arrays "alignas(uint32_t) inline constexpr uint32_t ${identifier}[] = {\n    ${words}\n};\n\n")
+    string(APPEND entries "    Entry {\"${spirv_name}\", ${identifier}},\n")
+endforeach()
+
+set(content "#pragma once
+// Generated by cmake/embed_spirv.cmake, do not edit.
+
+// --- STL Includes ---
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+namespace embedded {
+
+
+${arrays}
+struct Entry
+{
+    std::string_view name;
+
+    std::span<const uint32_t> spirv;
+}; // struct Entry
+
+
+inline constexpr Entry shaders[] = {
+${entries}};
+
+
+} // namespace embedded
+")
+
+# Avoid touching the header (and rebuilding its dependents) if nothing changed
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" existing)
+    if(existing STREQUAL content)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
@@ -2,13 +2,25 @@
 #include "Application.hpp"
 #include "VulkanInstance.hpp"
 #include "DebugMessenger.hpp"
+#include "DebugSink.hpp"
+#include "PerformanceWarnings.hpp"
 #include "WindowSurface.hpp"
 #include "PhysicalDevice.hpp"
+#include "CapabilityCache.hpp"
 #include "LogicalDevice.hpp"
 #include "SwapChain.hpp"
+#include "OffscreenTarget.hpp"
+#include "FrameLoop.hpp"
+#include "GpuProfiler.hpp"
+#include "PipelineCache.hpp"
+#include "Pipeline.hpp"
+#include "Framebuffers.hpp"
+#include "Shader.hpp"
+#include "Trace.hpp"
 
 // --- STL Includes ---
 #include <iostream>
+#include <fstream>
 #include <stdexcept>
 #include <vector>
 #include <cstdlib>
@@ -18,18 +30,47 @@
 #include <sstream>
 #include <type_traits>
 #include <optional>
+#include <cmath>
+
+
+namespace {
+
+
+const char* getPresentModeName(VkPresentModeKHR mode) noexcept
+{
+    switch (mode) {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR: return "immediate";
+        case VK_PRESENT_MODE_MAILBOX_KHR: return "mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR: return "fifo";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "fifo relaxed";
+        default: return "unknown";
+    }
+}
+
+
+} // unnamed namespace
 
 
 struct Application::Impl
 {
-    Impl()
-        : _p_window(nullptr),
+    Impl(const Settings& r_settings)
+        : _settings(r_settings),
+          _p_window(nullptr),
+          _p_hostAllocator(),
           _p_vulkanInstance(),
           _p_windowSurface(),
+          _p_capabilityCache(),
           _p_physicalDevice(),
           _p_logicalDevice(),
-          _p_swapChain(),
-          _p_imageViews()
+          _p_renderTarget(),
+          _p_imageViews(),
+          _p_pipelineCache(),
+          _p_pipeline(),
+          _p_framebuffers(),
+          _p_frameLoop(),
+          _p_gpuProfiler(),
+          _p_performanceWarnings(std::make_shared<PerformanceWarnings>()),
+          _framebufferResized(false)
     {
     }
 
@@ -38,28 +79,61 @@ struct Application::Impl
         #ifndef NDEBUG
         _debugMessenger.reset();
         #endif
+        _p_frameLoop.reset();
+        _p_gpuProfiler.reset();
+        _p_framebuffers.reset();
+        _p_pipeline.reset();
+        _p_pipelineCache.reset();
         _p_imageViews.reset();
-        _p_swapChain.reset();
+        _p_renderTarget.reset();
         _p_logicalDevice.reset();
         _p_physicalDevice.reset();
+        _p_capabilityCache.reset();
         _p_windowSurface.reset();
         _p_vulkanInstance.reset();
-        glfwDestroyWindow(_p_window);
+        if (_p_window) {
+            glfwDestroyWindow(_p_window);
+        }
     }
 
+    Settings _settings;
+
     GLFWwindow* _p_window;
 
+    /// @brief Shared by the instance and the device, and kept alive by them; nullptr without a host allocator.
+    std::shared_ptr<HostAllocator> _p_hostAllocator;
+
     std::shared_ptr<VulkanInstance> _p_vulkanInstance;
 
     std::shared_ptr<WindowSurface> _p_windowSurface;
 
+    std::unique_ptr<CapabilityCache> _p_capabilityCache;
+
     std::shared_ptr<PhysicalDevice> _p_physicalDevice;
 
-    std::shared_ptr<GraphicsLogicalDevice> _p_logicalDevice;
+    /// @brief @ref GraphicsLogicalDevice if rendering to a window, plain @ref LogicalDevice in headless mode.
+    std::shared_ptr<LogicalDevice> _p_logicalDevice;
+
+    /// @brief @ref SwapChain if rendering to a window, @ref OffscreenTarget in headless mode.
+    std::shared_ptr<RenderTarget> _p_renderTarget;
+
+    std::shared_ptr<RenderTarget::ImageViews> _p_imageViews;
+
+    std::shared_ptr<PipelineCache> _p_pipelineCache;
 
-    std::shared_ptr<SwapChain> _p_swapChain;
+    std::unique_ptr<Pipeline> _p_pipeline;
 
-    std::shared_ptr<SwapChain::ImageViews> _p_imageViews;
+    std::shared_ptr<Framebuffers> _p_framebuffers;
+
+    std::unique_ptr<FrameLoop> _p_frameLoop;
+
+    std::unique_ptr<GpuProfiler> _p_gpuProfiler;
+
+    /// @brief Filled by the debug messenger through its user data; stays empty without validation layers.
+    std::shared_ptr<PerformanceWarnings> _p_performanceWarnings;
+
+    /// @brief Set by GLFW when the window's framebuffer changed size.
+    bool _framebufferResized;
 
     #ifndef NDEBUG
     std::optional<DebugMessenger> _debugMessenger;
@@ -76,16 +150,48 @@ struct Application::Impl
 
 
 Application::Application()
-    : _p_impl(new Impl)
+    : Application(Settings {})
+{
+}
+
+
+Application::Application(const Settings& r_settings)
+    : _p_impl(new Impl(r_settings))
 {
-    this->initWindow();
+    if constexpr (Trace::isEnabled()) {
+        Trace::setThreadName("main");
+    }
+    VKTUTORIAL_TRACE_SCOPE("Application::Application");
+
+    if (_p_impl->_settings.headless && _p_impl->_settings.frameCount == 0) {
+        throw std::runtime_error("Headless runs require a frame count");
+    }
+
+    // Messages reported while creating the instance already go through the filter
+    DebugSink::getDefault().setSeverities(_p_impl->_settings.debugSeverities);
+
+    if (!_p_impl->_settings.headless) {
+        this->initWindow();
+    }
     this->initVulkan();
     this->initDebugMessenger();
-    this->createSurface();
+    if (!_p_impl->_settings.headless) {
+        this->createSurface();
+    }
+    this->createCapabilityCache();
     this->createPhysicalDevice();
     this->createLogicalDevice();
-    this->createSwapChain();
+    if (_p_impl->_settings.headless) {
+        this->createOffscreenTarget();
+    } else {
+        this->createSwapChain();
+    }
     this->createImageViews();
+    this->createPipelineCache();
+    this->createPipeline();
+    this->createFramebuffers();
+    this->createFrameLoop();
+    this->createGpuProfiler();
 }
 
 
@@ -100,24 +206,65 @@ void Application::run()
 {
     //this->getExtensions();
     this->mainLoop();
+
+    if (!_p_impl->_settings.trace.empty()) {
+        if (!Trace::isEnabled()) {
+            std::cerr << "Tracing was disabled at compile time (VKTUTORIAL_ENABLE_TRACING), the trace will be empty\n";
+        }
+
+        std::ofstream file(_p_impl->_settings.trace);
+        if (!file) {
+            throw std::runtime_error("Failed to open trace output '" + _p_impl->_settings.trace.string() + "'");
+        }
+        Trace::writeChromeJSON(file);
+    }
+
+    // Fail last, so that every output of the run is still written
+    if (!_p_impl->_settings.performanceBaseline.empty()) {
+        std::ifstream file(_p_impl->_settings.performanceBaseline);
+        if (!file) {
+            throw std::runtime_error("Failed to open performance baseline '" + _p_impl->_settings.performanceBaseline.string() + "'");
+        }
+        const auto baseline = PerformanceWarnings::readMessageIds(file);
+        const auto newRecords = _p_impl->_p_performanceWarnings->getNewRecords(baseline);
+        if (!newRecords.empty()) {
+            std::stringstream message;
+            message << newRecords.size() << " new performance warnings:";
+            for (const auto& r_record : newRecords) {
+                message << ' ' << r_record.messageIdName;
+            }
+            throw std::runtime_error(message.str());
+        }
+    }
 }
 
 
 void Application::initWindow()
 {
+    VKTUTORIAL_TRACE_SCOPE("Application::initWindow");
+
     glfwInit();
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API); // <== GLFW without OpenGL
 
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE); // <== todo, disable window resizing for now
+    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
     _p_impl->_p_window = glfwCreateWindow(_p_impl->_windowWidth,
                                           _p_impl->_windowHeight,
                                           "vktutorial",
                                           nullptr,
                                           nullptr);
+
+    // Not every platform reports resizes through VK_ERROR_OUT_OF_DATE_KHR,
+    // so keep track of them explicitly.
+    glfwSetWindowUserPointer(_p_impl->_p_window, _p_impl.get());
+    glfwSetFramebufferSizeCallback(_p_impl->_p_window, [](GLFWwindow* p_window, int, int) {
+        static_cast<Impl*>(glfwGetWindowUserPointer(p_window))->_framebufferResized = true;
+    });
 }
 
 void Application::initVulkan()
 {
+    VKTUTORIAL_TRACE_SCOPE("Application::initVulkan");
+
     this->createVkInstance();
 }
 
@@ -138,10 +285,13 @@ void Application::getExtensions(ItOutput it_out)
 template <concepts::Iterator OutputIt>
 void Application::getRequiredExtensions(OutputIt it)
 {
-    uint32_t numberOfGLFWExtensions = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&numberOfGLFWExtensions);
-    for (uint32_t i=0; i<numberOfGLFWExtensions; ++i) {
-        *it++ = *glfwExtensions++;
+    // Headless runs never touch GLFW, so they don't need its surface extensions
+    if (!_p_impl->_settings.headless) {
+        uint32_t numberOfGLFWExtensions = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&numberOfGLFWExtensions);
+        for (uint32_t i=0; i<numberOfGLFWExtensions; ++i) {
+            *it++ = *glfwExtensions++;
+        }
     }
 
     #if defined(__APPLE__) && __APPLE__
@@ -176,35 +326,22 @@ VKAPI_ATTR VkBool32 VKAPI_CALL Application::debugCallback(VkDebugUtilsMessageSev
                                                           const VkDebugUtilsMessengerCallbackDataEXT* p_data,
                                                           void* p_userData)
 {
-    std::cerr << "Validation layer";
-
-    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT)
-        std::cerr << " [VERBOSE]";
-    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
-        std::cerr << " [INFO]";
-    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
-        std::cerr << " [WARNING]";
-    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
-        std::cerr << " [ERROR]";
-
-    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT)
-        std::cerr << " (GENERAL)";
-    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT)
-        std::cerr << " (VALIDATION)";
-    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
-        std::cerr << " (PERFORMANCE)";
-
-    std::cerr << ": " << p_data->pMessage << std::endl;
+    // Performance warnings are captured regardless of the output filters
+    if (p_userData && (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)) {
+        static_cast<PerformanceWarnings*>(p_userData)->record(p_data);
+    }
+
+    // Drivers call this from their own threads; never block them on output
+    DebugSink::getDefault().submit("Validation layer", severity, type, p_data);
     return VK_FALSE;
 }
 
-void Application::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo)
+void Application::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo,
+                                                   VkDebugUtilsMessageSeverityFlagsEXT severities)
 {
+    // Don't have the layers format messages that the sink would drop anyway
     createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-    createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT
-                                    | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT
-                                    | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
-                                    | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    createInfo.messageSeverity = severities | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
     createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT
                                 | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
                                 | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
@@ -213,62 +350,405 @@ void Application::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateIn
 
 void Application::initDebugMessenger()
 {
+    VKTUTORIAL_TRACE_SCOPE("Application::initDebugMessenger");
+
     #ifndef NDEBUG
     VkDebugUtilsMessengerCreateInfoEXT createInfo {};
-    this->populateDebugMessengerCreateInfo(createInfo);
-    createInfo.pUserData = nullptr;
+    this->populateDebugMessengerCreateInfo(createInfo, _p_impl->_settings.debugSeverities);
 
-    _p_impl->_debugMessenger.emplace(_p_impl->_p_vulkanInstance, createInfo);
+    _p_impl->_debugMessenger.emplace(_p_impl->_p_vulkanInstance,
+                                     createInfo,
+                                     _p_impl->_p_performanceWarnings);
     #endif
 }
 
 void Application::createVkInstance()
 {
+    VKTUTORIAL_TRACE_SCOPE("Application::createVkInstance");
+
     std::vector<std::string> extensions;
     this->getRequiredExtensions(std::back_inserter(extensions));
-    _p_impl->_p_vulkanInstance = std::make_shared<VulkanInstance>(extensions);
+    if (_p_impl->_settings.hostAllocator.has_value()) {
+        _p_impl->_p_hostAllocator = std::make_shared<HostAllocator>(_p_impl->_settings.hostAllocator.value());
+    }
+
+    // Most performance warnings come from the best practices checks, which are only worth their overhead if warnings are captured
+    VulkanInstance::Settings instanceSettings;
+    instanceSettings.debugSeverities = _p_impl->_settings.debugSeverities;
+    instanceSettings.bestPractices = !_p_impl->_settings.performanceWarnings.empty() || !_p_impl->_settings.performanceBaseline.empty();
+
+    _p_impl->_p_vulkanInstance = std::make_shared<VulkanInstance>(extensions, instanceSettings, _p_impl->_p_hostAllocator);
 }
 
 
 void Application::createSurface()
 {
+    VKTUTORIAL_TRACE_SCOPE("Application::createSurface");
+
     _p_impl->_p_windowSurface = std::make_shared<WindowSurface>(_p_impl->_p_vulkanInstance, _p_impl->_p_window);
 }
 
 
+void Application::createCapabilityCache()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createCapabilityCache");
+
+    _p_impl->_p_capabilityCache = std::make_unique<CapabilityCache>(std::filesystem::path(_p_impl->_settings.capabilityCache));
+}
+
+
 void Application::createPhysicalDevice()
 {
-    _p_impl->_p_physicalDevice = std::make_shared<PhysicalDevice>(VK_NULL_HANDLE);
-    *_p_impl->_p_physicalDevice = PhysicalDevice::getDefaultDevice(
-        _p_impl->_p_vulkanInstance->get(),
-        _p_impl->_p_windowSurface->get()
-    ).value();
+    VKTUTORIAL_TRACE_SCOPE("Application::createPhysicalDevice");
+
+    std::optional<VkSurfaceKHR> surface;
+    if (_p_impl->_p_windowSurface) {
+        surface.emplace(_p_impl->_p_windowSurface->get());
+    }
+
+    const auto physicalDevice = _p_impl->_p_capabilityCache->getDefaultDevice(_p_impl->_p_vulkanInstance->get(), surface);
+    if (!physicalDevice.has_value()) {
+        throw std::runtime_error("No suitable physical device found");
+    }
+    _p_impl->_p_physicalDevice = std::make_shared<PhysicalDevice>(physicalDevice.value());
 }
 
 
 void Application::createLogicalDevice()
 {
-    _p_impl->_p_logicalDevice = std::make_shared<GraphicsLogicalDevice>(_p_impl->_p_physicalDevice);
+    VKTUTORIAL_TRACE_SCOPE("Application::createLogicalDevice");
+
+    // Headless runs don't present anything, so they don't need swap chain support
+    if (_p_impl->_settings.headless) {
+        _p_impl->_p_logicalDevice = std::make_shared<LogicalDevice>(_p_impl->_p_physicalDevice,
+                                                                    LogicalDevice::QueueSettings(),
+                                                                    _p_impl->_p_hostAllocator);
+    } else {
+        _p_impl->_p_logicalDevice = std::make_shared<GraphicsLogicalDevice>(_p_impl->_p_physicalDevice,
+                                                                            _p_impl->_p_windowSurface->get(),
+                                                                            LogicalDevice::QueueSettings(),
+                                                                            _p_impl->_p_hostAllocator);
+    }
 }
 
 
 void Application::createSwapChain()
 {
-    _p_impl->_p_swapChain = std::make_shared<SwapChain>(_p_impl->_p_logicalDevice,
-                                                        _p_impl->_p_windowSurface);
+    VKTUTORIAL_TRACE_SCOPE("Application::createSwapChain");
+
+    // The logical device is always a GraphicsLogicalDevice when rendering to a window
+    const auto p_swapChain = std::make_shared<SwapChain>(std::static_pointer_cast<GraphicsLogicalDevice>(_p_impl->_p_logicalDevice),
+                                                         _p_impl->_p_windowSurface,
+                                                         _p_impl->_settings.presentPolicy);
+    _p_impl->_p_renderTarget = p_swapChain;
+
+    std::cout << "swap chain: " << getPresentModeName(p_swapChain->getPresentMode())
+              << " present mode with " << p_swapChain->getImages().size() << " images\n";
+}
+
+
+void Application::createOffscreenTarget()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createOffscreenTarget");
+
+    _p_impl->_p_renderTarget = std::make_shared<OffscreenTarget>(_p_impl->_p_logicalDevice,
+                                                                 _p_impl->_settings.offscreen);
 }
 
 
 void Application::createImageViews()
 {
-    _p_impl->_p_imageViews = std::make_shared<SwapChain::ImageViews>(_p_impl->_p_swapChain);
+    VKTUTORIAL_TRACE_SCOPE("Application::createImageViews");
+
+    _p_impl->_p_imageViews = std::make_shared<RenderTarget::ImageViews>(_p_impl->_p_renderTarget);
+}
+
+
+void Application::createPipelineCache()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createPipelineCache");
+
+    _p_impl->_p_pipelineCache = std::make_shared<PipelineCache>(_p_impl->_p_logicalDevice,
+                                                                std::filesystem::path(_p_impl->_settings.pipelineCache));
+}
+
+
+void Application::createPipeline()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createPipeline");
+
+    // Prefer shaders compiled into the executable, and fall back to
+    // mapping them from the shader directory.
+    const auto& r_shaderDirectory = _p_impl->_settings.shaderDirectory;
+    const auto makeShaderIO = [&r_shaderDirectory](std::string_view name) -> std::shared_ptr<ShaderIO> {
+        if (EmbeddedShaderIO::isAvailable(name)) {
+            return std::make_shared<EmbeddedShaderIO>(name);
+        }
+        return std::make_shared<MappedSpirvShaderIO>(r_shaderDirectory / name);
+    };
+
+    _p_impl->_p_pipeline = std::make_unique<Pipeline>(
+        _p_impl->_p_logicalDevice,
+        makeShaderIO("vertexShader.vert.spv"),
+        makeShaderIO("fragmentShader.frag.spv"),
+        _p_impl->_p_renderTarget->getImageFormat(),
+        _p_impl->_p_renderTarget->getFinalLayout(),
+        _p_impl->_p_pipelineCache
+    );
+}
+
+
+void Application::createFramebuffers()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createFramebuffers");
+
+    _p_impl->_p_framebuffers = std::make_shared<Framebuffers>(_p_impl->_p_imageViews,
+                                                              _p_impl->_p_pipeline->getRenderPass());
+}
+
+
+void Application::createFrameLoop()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createFrameLoop");
+
+    _p_impl->_p_frameLoop = std::make_unique<FrameLoop>(_p_impl->_p_renderTarget,
+                                                        _p_impl->_settings.framesInFlight);
+}
+
+
+void Application::createGpuProfiler()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::createGpuProfiler");
+
+    _p_impl->_p_gpuProfiler = std::make_unique<GpuProfiler>(_p_impl->_p_logicalDevice,
+                                                            _p_impl->_settings.framesInFlight);
+}
+
+
+void Application::recreateSwapChain()
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::recreateSwapChain");
+
+    // Minimized windows have no area to render to, so wait until they are restored
+    int width = 0, height = 0;
+    glfwGetFramebufferSize(_p_impl->_p_window, &width, &height);
+    while ((width == 0 || height == 0) && !glfwWindowShouldClose(_p_impl->_p_window)) {
+        glfwWaitEvents();
+        glfwGetFramebufferSize(_p_impl->_p_window, &width, &height);
+    }
+    if (width == 0 || height == 0) {
+        return;
+    }
+    _p_impl->_framebufferResized = false;
+
+    // The old swap chain, its image views and framebuffers may still be used by frames
+    // in flight, so they are retired through the frame loop instead of idling the device.
+    // The framebuffers keep the views alive, which in turn keep the old swap chain alive.
+    auto& r_frameLoop = *_p_impl->_p_frameLoop;
+    const VkFormat oldFormat = _p_impl->_p_renderTarget->getImageFormat();
+    _p_impl->_p_renderTarget = std::make_shared<SwapChain>(std::static_pointer_cast<SwapChain>(_p_impl->_p_renderTarget));
+    r_frameLoop.retire(std::move(_p_impl->_p_framebuffers));
+    r_frameLoop.setTarget(_p_impl->_p_renderTarget);
+
+    // The render pass only depends on the image format, which rarely changes
+    if (_p_impl->_p_renderTarget->getImageFormat() != oldFormat) {
+        r_frameLoop.retire(std::shared_ptr<const Pipeline>(std::move(_p_impl->_p_pipeline)));
+        this->createPipeline();
+    }
+
+    this->createImageViews();
+    this->createFramebuffers();
+}
+
+
+void Application::recordFrame(VkCommandBuffer commandBuffer, uint32_t i_image)
+{
+    VKTUTORIAL_TRACE_SCOPE("Application::recordFrame");
+
+    const VkExtent2D extent = _p_impl->_p_renderTarget->getImageExtent();
+
+    // Cycle the clear color so that consecutive frames are distinguishable
+    const float phase = 0.01f * static_cast<float>(_p_impl->_p_frameLoop->getStatistics().frameCount);
+    VkClearValue clearValue {};
+    clearValue.color.float32[0] = 0.5f + 0.5f * std::sin(phase);
+    clearValue.color.float32[1] = 0.5f + 0.5f * std::sin(phase + 2.094f);
+    clearValue.color.float32[2] = 0.5f + 0.5f * std::sin(phase + 4.189f);
+    clearValue.color.float32[3] = 1.0f;
+
+    // The frame loop waited on the slot, so the profiler can read back its results
+    auto& r_profiler = *_p_impl->_p_gpuProfiler;
+    r_profiler.beginFrame(commandBuffer);
+    GpuProfiler::Scope scope(r_profiler, commandBuffer, "main pass");
+
+    // The render pass clears the image and leaves it in the layout the render target expects
+    VkRenderPassBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    beginInfo.renderPass = _p_impl->_p_pipeline->getRenderPass();
+    beginInfo.framebuffer = _p_impl->_p_framebuffers->get(i_image);
+    beginInfo.renderArea.offset = {0, 0};
+    beginInfo.renderArea.extent = extent;
+    beginInfo.clearValueCount = 1;
+    beginInfo.pClearValues = &clearValue;
+    vkCmdBeginRenderPass(commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _p_impl->_p_pipeline->get());
+
+    VkViewport viewport {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor {};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+
+    vkCmdEndRenderPass(commandBuffer);
 }
 
 
 void Application::mainLoop()
 {
-    while (!glfwWindowShouldClose(_p_impl->_p_window)) {
-        glfwPollEvents();
-        break;
-    } // while not window_should_close
+    auto& r_frameLoop = *_p_impl->_p_frameLoop;
+    const std::size_t frameCount = _p_impl->_settings.frameCount;
+    const auto recorder = [this](VkCommandBuffer commandBuffer, uint32_t i_image) {
+        this->recordFrame(commandBuffer, i_image);
+    };
+
+    auto& r_performanceWarnings = *_p_impl->_p_performanceWarnings;
+
+    if (_p_impl->_settings.headless) {
+        for (std::size_t i_frame=0; i_frame<frameCount; ++i_frame) {
+            r_frameLoop.render(recorder);
+            r_performanceWarnings.nextFrame();
+        }
+    } else {
+        while (!glfwWindowShouldClose(_p_impl->_p_window)
+               && (frameCount == 0 || r_frameLoop.getStatistics().frameCount < frameCount)) {
+            glfwPollEvents();
+
+            // Frames aren't rendered while the swap chain is out of date, so
+            // recreate it before the next attempt.
+            if (_p_impl->_framebufferResized || _p_impl->_p_renderTarget->isOutOfDate()) {
+                this->recreateSwapChain();
+            }
+            r_frameLoop.render(recorder);
+            r_performanceWarnings.nextFrame();
+        } // while not window_should_close
+    }
+
+    r_frameLoop.waitIdle();
+
+    const auto& r_statistics = r_frameLoop.getStatistics();
+    std::cout << r_statistics.frameCount << " frames with "
+              << r_frameLoop.getFramesInFlight() << " in flight, fence wait avg "
+              << 1e3 * r_statistics.getAverageFenceWait() << " ms, max "
+              << 1e3 * r_statistics.maxFenceWait.count() << " ms, acquire avg "
+              << 1e3 * r_statistics.getAverageAcquire() << " ms, max "
+              << 1e3 * r_statistics.maxAcquire.count() << " ms\n";
+
+    const auto cacheStatistics = _p_impl->_p_pipelineCache->getStatistics();
+    std::cout << "pipeline cache (" << (_p_impl->_p_pipelineCache->isWarm() ? "warm" : "cold") << "): "
+              << cacheStatistics.hits << " hits, "
+              << cacheStatistics.misses << " misses, "
+              << cacheStatistics.unknown << " unknown\n";
+
+    const auto& r_capabilityCache = *_p_impl->_p_capabilityCache;
+    std::cout << "capability cache (" << (r_capabilityCache.isWarm() ? "warm" : "cold") << "): "
+              << 1e3 * r_capabilityCache.getSkippedTime() << " ms of device queries skipped\n";
+
+    const auto moduleStatistics = _p_impl->_p_logicalDevice->getShaderModuleCache().getStatistics();
+    std::cout << "shader modules: "
+              << moduleStatistics.hits << " hits, "
+              << moduleStatistics.misses << " misses, "
+              << moduleStatistics.bytesReused << " of "
+              << moduleStatistics.bytesReused + moduleStatistics.bytesCreated << " bytes reused\n";
+
+    const auto memoryStatistics = _p_impl->_p_logicalDevice->getAllocator().getStatistics();
+    std::cout << "device memory: "
+              << memoryStatistics.allocationCount << " allocations in "
+              << memoryStatistics.blockCount << " blocks (+"
+              << memoryStatistics.dedicatedCount << " dedicated), "
+              << memoryStatistics.usedBytes << " of "
+              << memoryStatistics.reservedBytes << " bytes used, "
+              << 100.0 * memoryStatistics.getFragmentation() << "% fragmented\n";
+
+    if (_p_impl->_p_hostAllocator) {
+        const auto hostStatistics = _p_impl->_p_hostAllocator->getStatistics();
+        std::cout << "host memory: "
+                  << hostStatistics.getAllocationCount() << " allocations, "
+                  << hostStatistics.getBytes() << " bytes in use, "
+                  << hostStatistics.reservedBytes << " reserved (peak "
+                  << hostStatistics.peakReservedBytes << "), "
+                  << hostStatistics.chunkCount << " chunks, "
+                  << hostStatistics.inPlaceCount << " in place reallocations, "
+                  << hostStatistics.failedCount << " failed\n";
+        for (std::size_t i_scope=0; i_scope<HostAllocator::scopeCount; ++i_scope) {
+            const auto& r_scope = hostStatistics.scopes[i_scope];
+            std::cout << "  " << HostAllocator::getScopeName(static_cast<VkSystemAllocationScope>(i_scope)) << ": "
+                      << r_scope.allocateCalls << " allocations, "
+                      << r_scope.reallocateCalls << " reallocations, "
+                      << r_scope.freeCalls << " frees, peak "
+                      << r_scope.peakBytes << " bytes, "
+                      << r_scope.internalBytes << " internal bytes\n";
+        }
+    }
+
+    const auto debugStatistics = DebugSink::getDefault().getStatistics();
+    std::cout << "debug messages: "
+              << debugStatistics.writtenCount << " of "
+              << debugStatistics.receivedCount << " written, "
+              << debugStatistics.filteredCount << " filtered, "
+              << debugStatistics.duplicateCount << " repeats, "
+              << debugStatistics.overflowCount << " overflowed\n";
+
+    const auto performanceRecords = r_performanceWarnings.getRecords();
+    std::cout << "performance warnings: "
+              << performanceRecords.size() << " distinct, "
+              << r_performanceWarnings.getCount() << " occurrences\n";
+    for (const auto& r_record : performanceRecords) {
+        std::cout << "  " << r_record.messageIdName << " (0x"
+                  << std::hex << static_cast<uint32_t>(r_record.messageId) << std::dec << "): "
+                  << r_record.count << " times in "
+                  << r_record.frameCounts.size() << " frames\n";
+    }
+
+    for (const auto& r_result : _p_impl->_p_gpuProfiler->getResults()) {
+        std::cout << "gpu '" << r_result.name << "': avg "
+                  << r_result.average << " ms, min "
+                  << r_result.min << " ms, max "
+                  << r_result.max << " ms, p99 "
+                  << r_result.p99 << " ms over "
+                  << r_result.sampleCount << " frames\n";
+    }
+
+    if (!_p_impl->_settings.gpuProfile.empty()) {
+        std::ofstream file(_p_impl->_settings.gpuProfile);
+        if (!file) {
+            throw std::runtime_error("Failed to open GPU profile output '" + _p_impl->_settings.gpuProfile.string() + "'");
+        }
+        _p_impl->_p_gpuProfiler->writeCSV(file);
+    }
+
+    if (!_p_impl->_settings.performanceWarnings.empty()) {
+        std::ofstream file(_p_impl->_settings.performanceWarnings);
+        if (!file) {
+            throw std::runtime_error("Failed to open performance warnings output '" + _p_impl->_settings.performanceWarnings.string() + "'");
+        }
+        r_performanceWarnings.writeJSON(file);
+    }
+
+    if (_p_impl->_settings.headless) {
+        const auto& r_target = static_cast<const OffscreenTarget&>(*_p_impl->_p_renderTarget);
+        std::cout << r_target.getFrameCount() << " frames at "
+                  << r_target.getFramesPerSecond() << " FPS"
+                  << (r_target.getSettings().unthrottled ? " (unthrottled)" : "")
+                  << '\n';
+    }
 }
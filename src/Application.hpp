@@ -6,17 +6,77 @@
 
 // --- Internal Includes ---
 #include "utilities.hpp"
+#include "OffscreenTarget.hpp"
+#include "SwapChain.hpp"
+#include "HostAllocator.hpp"
 
 // --- STL Includes ---
 #include <string>
 #include <memory>
+#include <filesystem>
+#include <optional>
 
 
 class Application
 {
+public:
+    struct Settings
+    {
+        /// @brief Render into an @ref OffscreenTarget without creating a window.
+        bool headless = false;
+
+        /// @brief Number of frames to render before exiting; 0 runs until the window is closed.
+        /// @note Headless runs must specify a frame count.
+        std::size_t frameCount = 0;
+
+        /// @brief Number of frames the CPU may record ahead of the GPU.
+        std::size_t framesInFlight = 2;
+
+        /// @brief Present mode and swap chain size trade-off when rendering to a window.
+        SwapChain::PresentPolicy presentPolicy = SwapChain::PresentPolicy::VSync;
+
+        /// @brief Configuration of the render target in headless mode.
+        OffscreenTarget::Settings offscreen = {};
+
+        /// @brief Host allocator for every Vulkan object; nullopt leaves host memory to the implementation.
+        std::optional<HostAllocator::Settings> hostAllocator = HostAllocator::Settings();
+
+        /// @brief Directory containing the compiled SPIR-V shaders.
+        std::filesystem::path shaderDirectory = "shaders";
+
+        /// @brief File the pipeline cache is loaded from and saved to.
+        std::filesystem::path pipelineCache = "pipeline.cache";
+
+        /// @brief File device selection is cached in (see @ref CapabilityCache).
+        std::filesystem::path capabilityCache = "capabilities.cache";
+
+        /// @brief CSV file GPU scope timings are written to after the run; empty to skip.
+        std::filesystem::path gpuProfile = {};
+
+        /// @brief Severities of debug messenger messages that get written (see @ref DebugSink).
+        VkDebugUtilsMessageSeverityFlagsEXT debugSeverities = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
+                                                              | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+
+        /// @brief JSON file performance warnings are written to after the run; empty to skip.
+        /// @details Setting this or @ref performanceBaseline enables the best practices checks
+        ///          of the validation layers (see @ref VulkanInstance::Settings::bestPractices).
+        /// @note Performance warnings are only reported by the validation layers of debug builds.
+        std::filesystem::path performanceWarnings = {};
+
+        /// @brief JSON file of a previous run's performance warnings; the run fails if any
+        ///        warning with a message ID not in this file shows up. Empty to skip.
+        std::filesystem::path performanceBaseline = {};
+
+        /// @brief Chrome trace JSON file CPU spans are written to after the run; empty to skip.
+        /// @note Spans are only recorded if built with @a VKTUTORIAL_ENABLE_TRACING.
+        std::filesystem::path trace = {};
+    }; // struct Settings
+
 public:
     Application();
 
+    Application(const Settings& r_settings);
+
     ~Application();
 
     void run();
@@ -40,18 +100,39 @@ private:
 
     void createSurface();
 
+    void createCapabilityCache();
+
     void createPhysicalDevice();
 
     void createLogicalDevice();
 
     void createSwapChain();
 
+    void createOffscreenTarget();
+
     void createImageViews();
 
+    void createPipelineCache();
+
+    void createPipeline();
+
+    void createFramebuffers();
+
+    void createFrameLoop();
+
+    void createGpuProfiler();
+
+    /// @brief Replace the swap chain and everything referencing its images after a resize.
+    void recreateSwapChain();
+
+    void recordFrame(VkCommandBuffer commandBuffer, uint32_t i_image);
+
     template <concepts::Iterator TOutputIt>
     static void getExtensions(TOutputIt it);
 
-    static void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
+    /// @param severities severities the messenger subscribes to; warnings are added so that performance warnings are always captured.
+    static void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo,
+                                                 VkDebugUtilsMessageSeverityFlagsEXT severities);
 
     static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
                                                         VkDebugUtilsMessageTypeFlagsEXT type,
@@ -0,0 +1,316 @@
+// --- Internal Includes ---
+#include "BindlessDescriptors.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Clamp the array sizes to the update-after-bind limits of the device.
+BindlessDescriptors::Settings clampSettings(const LogicalDevice& r_device,
+                                            BindlessDescriptors::Settings settings)
+{
+    if (!r_device.hasFeature(PhysicalDevice::Feature::DescriptorIndexing)) {
+        throw std::runtime_error("Bindless descriptors require descriptor indexing");
+    }
+
+    const auto& r_physicalDevice = r_device.getPhysicalDevice();
+    const auto& r_limits = r_physicalDevice.getCapabilities().descriptorIndexingProperties;
+
+    // Combined image samplers count as both a sampled image and a sampler
+    settings.textureCapacity = std::min({settings.textureCapacity,
+                                         r_limits.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                         r_limits.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                         r_limits.maxDescriptorSetUpdateAfterBindSampledImages,
+                                         r_limits.maxDescriptorSetUpdateAfterBindSamplers});
+    settings.bufferCapacity = std::min({settings.bufferCapacity,
+                                        r_limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+                                        r_limits.maxDescriptorSetUpdateAfterBindStorageBuffers});
+
+    const uint64_t descriptorCount = uint64_t(settings.textureCapacity) + settings.bufferCapacity;
+    if (r_limits.maxPerStageUpdateAfterBindResources < descriptorCount
+        || r_limits.maxUpdateAfterBindDescriptorsInAllPools < descriptorCount) {
+        throw std::runtime_error("Bindless arrays exceed the device's update-after-bind resource limit");
+    }
+
+    if (r_physicalDevice.getProperties().limits.maxPushConstantsSize < settings.pushConstantSize) {
+        throw std::runtime_error("Push constant block exceeds the device's limit");
+    }
+
+    return settings;
+}
+
+
+} // unnamed namespace
+
+
+BindlessDescriptors::BindlessDescriptors(const std::shared_ptr<LogicalDevice>& rp_device,
+                                         std::size_t framesInFlight)
+    : BindlessDescriptors(rp_device, framesInFlight, Settings())
+{
+}
+
+
+BindlessDescriptors::BindlessDescriptors(const std::shared_ptr<LogicalDevice>& rp_device,
+                                         std::size_t framesInFlight,
+                                         const Settings& r_settings)
+    : _p_device(rp_device),
+      _settings(clampSettings(*rp_device, r_settings)),
+      _setLayout(VK_NULL_HANDLE),
+      _pool(VK_NULL_HANDLE),
+      _set(VK_NULL_HANDLE),
+      _pipelineLayout(VK_NULL_HANDLE),
+      _textureSlots(_settings.textureCapacity, framesInFlight),
+      _bufferSlots(_settings.bufferCapacity, framesInFlight),
+      _statistics()
+{
+    const VkDevice device = _p_device->getDevice();
+    const auto p_allocationCallbacks = _p_device->getAllocationCallbacks();
+
+    // Set layout: both arrays may have unwritten elements, and get written while the set is bound
+    std::array<VkDescriptorSetLayoutBinding,2> bindings {};
+    bindings[textureBinding].binding = textureBinding;
+    bindings[textureBinding].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    bindings[textureBinding].descriptorCount = _settings.textureCapacity;
+    bindings[textureBinding].stageFlags = _settings.stages;
+    bindings[bufferBinding].binding = bufferBinding;
+    bindings[bufferBinding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[bufferBinding].descriptorCount = _settings.bufferCapacity;
+    bindings[bufferBinding].stageFlags = _settings.stages;
+
+    const VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT
+                                                | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT
+                                                | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+    const std::array<VkDescriptorBindingFlags,2> flags {bindingFlags, bindingFlags};
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT flagsInfo {};
+    flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    flagsInfo.bindingCount = static_cast<uint32_t>(flags.size());
+    flagsInfo.pBindingFlags = flags.data();
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo {};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.pNext = &flagsInfo;
+    setLayoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    setLayoutInfo.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &setLayoutInfo, p_allocationCallbacks, &_setLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create bindless descriptor set layout");
+    }
+
+    // Pool holding nothing but the one set
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    if (_settings.textureCapacity) {
+        poolSizes.push_back({VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, _settings.textureCapacity});
+    }
+    if (_settings.bufferCapacity) {
+        poolSizes.push_back({VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, _settings.bufferCapacity});
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    poolInfo.pPoolSizes = poolSizes.data();
+    if (vkCreateDescriptorPool(device, &poolInfo, p_allocationCallbacks, &_pool) != VK_SUCCESS) {
+        vkDestroyDescriptorSetLayout(device, _setLayout, p_allocationCallbacks);
+        throw std::runtime_error("Failed to create bindless descriptor pool");
+    }
+
+    VkDescriptorSetAllocateInfo setInfo {};
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setInfo.descriptorPool = _pool;
+    setInfo.descriptorSetCount = 1;
+    setInfo.pSetLayouts = &_setLayout;
+    if (vkAllocateDescriptorSets(device, &setInfo, &_set) != VK_SUCCESS) {
+        vkDestroyDescriptorPool(device, _pool, p_allocationCallbacks);
+        vkDestroyDescriptorSetLayout(device, _setLayout, p_allocationCallbacks);
+        throw std::runtime_error("Failed to allocate bindless descriptor set");
+    }
+
+    // Pipeline layout
+    VkPushConstantRange pushConstantRange {};
+    pushConstantRange.stageFlags = _settings.stages;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = _settings.pushConstantSize;
+
+    VkPipelineLayoutCreateInfo layoutInfo {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &_setLayout;
+    layoutInfo.pushConstantRangeCount = _settings.pushConstantSize ? 1 : 0;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &layoutInfo, p_allocationCallbacks, &_pipelineLayout) != VK_SUCCESS) {
+        vkDestroyDescriptorPool(device, _pool, p_allocationCallbacks);
+        vkDestroyDescriptorSetLayout(device, _setLayout, p_allocationCallbacks);
+        throw std::runtime_error("Failed to create bindless pipeline layout");
+    }
+}
+
+
+BindlessDescriptors::~BindlessDescriptors()
+{
+    const VkDevice device = _p_device->getDevice();
+    vkDestroyPipelineLayout(device, _pipelineLayout, _p_device->getAllocationCallbacks());
+    vkDestroyDescriptorPool(device, _pool, _p_device->getAllocationCallbacks());
+    vkDestroyDescriptorSetLayout(device, _setLayout, _p_device->getAllocationCallbacks());
+}
+
+
+void BindlessDescriptors::beginFrame()
+{
+    _textureSlots.beginFrame();
+    _bufferSlots.beginFrame();
+}
+
+
+uint32_t BindlessDescriptors::addTexture(VkImageView imageView,
+                                         VkSampler sampler,
+                                         VkImageLayout layout)
+{
+    const auto slot = _textureSlots.allocate();
+    if (!slot.has_value()) {
+        throw std::runtime_error("Bindless texture array is full");
+    }
+
+    VkDescriptorImageInfo imageInfo {};
+    imageInfo.sampler = sampler;
+    imageInfo.imageView = imageView;
+    imageInfo.imageLayout = layout;
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = _set;
+    write.dstBinding = textureBinding;
+    write.dstArrayElement = slot.value();
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+    this->write(write);
+
+    return slot.value();
+}
+
+
+uint32_t BindlessDescriptors::addBuffer(VkBuffer buffer)
+{
+    return this->addBuffer(buffer, 0, VK_WHOLE_SIZE);
+}
+
+
+uint32_t BindlessDescriptors::addBuffer(VkBuffer buffer,
+                                        VkDeviceSize offset,
+                                        VkDeviceSize range)
+{
+    const auto slot = _bufferSlots.allocate();
+    if (!slot.has_value()) {
+        throw std::runtime_error("Bindless buffer array is full");
+    }
+
+    VkDescriptorBufferInfo bufferInfo {};
+    bufferInfo.buffer = buffer;
+    bufferInfo.offset = offset;
+    bufferInfo.range = range;
+
+    VkWriteDescriptorSet write {};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = _set;
+    write.dstBinding = bufferBinding;
+    write.dstArrayElement = slot.value();
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &bufferInfo;
+    this->write(write);
+
+    return slot.value();
+}
+
+
+void BindlessDescriptors::removeTexture(uint32_t i_texture)
+{
+    // The element keeps its descriptor until it is reused; partially bound arrays don't mind
+    _textureSlots.free(i_texture);
+}
+
+
+void BindlessDescriptors::removeBuffer(uint32_t i_buffer)
+{
+    _bufferSlots.free(i_buffer);
+}
+
+
+void BindlessDescriptors::bind(VkCommandBuffer commandBuffer,
+                               VkPipelineBindPoint bindPoint) const
+{
+    vkCmdBindDescriptorSets(commandBuffer,
+                            bindPoint,
+                            _pipelineLayout,
+                            0,
+                            1,
+                            &_set,
+                            0,
+                            nullptr);
+}
+
+
+void BindlessDescriptors::pushIndices(VkCommandBuffer commandBuffer,
+                                      std::span<const uint32_t> indices) const
+{
+    assert(indices.size_bytes() <= _settings.pushConstantSize);
+    vkCmdPushConstants(commandBuffer,
+                       _pipelineLayout,
+                       _settings.stages,
+                       0,
+                       static_cast<uint32_t>(indices.size_bytes()),
+                       indices.data());
+}
+
+
+VkDescriptorSetLayout BindlessDescriptors::getSetLayout() const noexcept
+{
+    return _setLayout;
+}
+
+
+VkDescriptorSet BindlessDescriptors::getSet() const noexcept
+{
+    return _set;
+}
+
+
+VkPipelineLayout BindlessDescriptors::getPipelineLayout() const noexcept
+{
+    return _pipelineLayout;
+}
+
+
+const SlotAllocator& BindlessDescriptors::getTextureSlots() const noexcept
+{
+    return _textureSlots;
+}
+
+
+const SlotAllocator& BindlessDescriptors::getBufferSlots() const noexcept
+{
+    return _bufferSlots;
+}
+
+
+const BindlessDescriptors::Statistics& BindlessDescriptors::getStatistics() const noexcept
+{
+    return _statistics;
+}
+
+
+void BindlessDescriptors::write(const VkWriteDescriptorSet& r_write)
+{
+    vkUpdateDescriptorSets(_p_device->getDevice(), 1, &r_write, 0, nullptr);
+    _statistics.writeCount += r_write.descriptorCount;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "SlotAllocator.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+
+/// @brief Every texture and buffer of a scene in one descriptor set, indexed by push constants.
+/// @details The set has two bindings, each a large array marked update-after-bind and partially
+///          bound: combined image samplers at binding 0 and storage buffers at binding 1.
+///          Resources are written into a free array element when they are added, and shaders
+///          pick them by the indices passed through push constants, e.g.
+///          @code
+///          layout(set = 0, binding = 0) uniform sampler2D textures[];
+///          layout(set = 0, binding = 1) buffer Materials {vec4 values[];} buffers[];
+///          layout(push_constant) uniform Indices {uint texture; uint buffer;} indices;
+///          ... texture(textures[nonuniformEXT(indices.texture)], uv) ...
+///          @endcode
+///          The set is bound once per command buffer with @ref bind, after which draws only
+///          push their indices with @ref pushIndices instead of binding sets of their own.
+///
+///          Array elements are handed out by a @ref SlotAllocator each, so removed resources
+///          keep their element until the frames in flight that may reference them are done.
+///          Elements that are in use are never written, as update-after-bind requires.
+/// @note Requires @ref PhysicalDevice::Feature::DescriptorIndexing. Not thread safe.
+class BindlessDescriptors
+{
+public:
+    struct Settings
+    {
+        /// @brief Number of elements in the texture array; clamped to the device's limits.
+        uint32_t textureCapacity = 1 << 14;
+
+        /// @brief Number of elements in the buffer array; clamped to the device's limits.
+        uint32_t bufferCapacity = 1 << 14;
+
+        /// @brief Size of the push constant range, from offset 0 [bytes].
+        uint32_t pushConstantSize = 4 * sizeof(uint32_t);
+
+        /// @brief Stages the arrays and push constants are visible to.
+        VkShaderStageFlags stages = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+    }; // struct Settings
+
+    struct Statistics
+    {
+        /// @brief Number of descriptors written since construction.
+        std::size_t writeCount = 0;
+    }; // struct Statistics
+
+public:
+    BindlessDescriptors(const std::shared_ptr<LogicalDevice>& rp_device,
+                        std::size_t framesInFlight);
+
+    BindlessDescriptors(const std::shared_ptr<LogicalDevice>& rp_device,
+                        std::size_t framesInFlight,
+                        const Settings& r_settings);
+
+    BindlessDescriptors(const BindlessDescriptors&) = delete;
+
+    ~BindlessDescriptors();
+
+    /// @brief Move on to the next frame slot and recycle the elements removed in it.
+    /// @details Same contract as @ref DescriptorAllocator::beginFrame.
+    void beginFrame();
+
+    /// @name Resources
+    /// @{
+
+    /// @brief Write a texture into a free element of the texture array.
+    /// @return the index of the element, for shaders to read the texture from.
+    uint32_t addTexture(VkImageView imageView,
+                        VkSampler sampler,
+                        VkImageLayout layout);
+
+    /// @brief Write a whole buffer into a free element of the buffer array.
+    /// @return the index of the element, for shaders to read the buffer from.
+    uint32_t addBuffer(VkBuffer buffer);
+
+    /// @brief Write a range of a buffer into a free element of the buffer array.
+    /// @return the index of the element, for shaders to read the buffer from.
+    uint32_t addBuffer(VkBuffer buffer,
+                       VkDeviceSize offset,
+                       VkDeviceSize range);
+
+    /// @brief Release a texture's element; it is reused once no frame in flight can reference it.
+    void removeTexture(uint32_t i_texture);
+
+    /// @brief Release a buffer's element; it is reused once no frame in flight can reference it.
+    void removeBuffer(uint32_t i_buffer);
+
+    /// @}
+    /// @name Recording
+    /// @{
+
+    /// @brief Bind the set to set 0 of @ref getPipelineLayout.
+    void bind(VkCommandBuffer commandBuffer,
+              VkPipelineBindPoint bindPoint) const;
+
+    /// @brief Push indices to the start of the push constant range.
+    void pushIndices(VkCommandBuffer commandBuffer,
+                     std::span<const uint32_t> indices) const;
+
+    /// @}
+    /// @name Member Access
+    /// @{
+
+    VkDescriptorSetLayout getSetLayout() const noexcept;
+
+    VkDescriptorSet getSet() const noexcept;
+
+    /// @brief Layout with the set at index 0 and the push constant range; pipelines reading bindless resources must use it.
+    VkPipelineLayout getPipelineLayout() const noexcept;
+
+    const SlotAllocator& getTextureSlots() const noexcept;
+
+    const SlotAllocator& getBufferSlots() const noexcept;
+
+    const Statistics& getStatistics() const noexcept;
+
+    /// @}
+
+    static constexpr uint32_t textureBinding = 0;
+
+    static constexpr uint32_t bufferBinding = 1;
+
+private:
+    void write(const VkWriteDescriptorSet& r_write);
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    Settings _settings;
+
+    VkDescriptorSetLayout _setLayout;
+
+    VkDescriptorPool _pool;
+
+    VkDescriptorSet _set;
+
+    VkPipelineLayout _pipelineLayout;
+
+    SlotAllocator _textureSlots;
+
+    SlotAllocator _bufferSlots;
+
+    Statistics _statistics;
+}; // class BindlessDescriptors
@@ -0,0 +1,80 @@
+// --- Internal Includes ---
+#include "CacheFile.hpp"
+
+// --- STL Includes ---
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+
+std::optional<std::vector<char>> CacheFile::read(const std::filesystem::path& r_path,
+                                                 const Magic& r_magic,
+                                                 uint32_t version)
+{
+    std::ifstream file(r_path, std::ios::in | std::ios::binary);
+    if (!file) {
+        return {};
+    }
+
+    const std::vector<char> contents((std::istreambuf_iterator<char>(file)),
+                                     std::istreambuf_iterator<char>());
+    if (contents.size() < sizeof(Header)) {
+        return {};
+    }
+
+    Header header;
+    std::memcpy(&header, contents.data(), sizeof(header));
+    const std::span<const char> data(contents.data() + sizeof(header), contents.size() - sizeof(header));
+    if (header.magic != r_magic
+        || header.version != version
+        || header.dataSize != data.size()
+        || header.checksum != CacheFile::computeChecksum(data)) {
+        return {};
+    }
+
+    return std::vector<char>(data.begin(), data.end());
+}
+
+
+void CacheFile::write(const std::filesystem::path& r_path,
+                      const Magic& r_magic,
+                      uint32_t version,
+                      std::span<const char> data)
+{
+    Header header {};
+    header.dataSize = data.size();
+    header.checksum = CacheFile::computeChecksum(data);
+    header.magic = r_magic;
+    header.version = version;
+
+    // Write to a temporary file first, then atomically replace the old cache
+    if (r_path.has_parent_path()) {
+        std::filesystem::create_directories(r_path.parent_path());
+    }
+    std::filesystem::path temporaryPath = r_path;
+    temporaryPath += ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(data.data(), data.size());
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Failed to write " + temporaryPath.string());
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, r_path);
+}
+
+
+uint64_t CacheFile::computeChecksum(std::span<const char> data) noexcept
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char byte : data) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// --- STL Includes ---
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+/// @brief Checksummed file format of the caches persisted on disk (@ref PipelineCache, @ref CapabilityCache).
+/// @details A file is a @ref Header followed by the payload. Files with a different magic
+///          or version, a size that doesn't match the header or a wrong checksum are treated
+///          as missing. Writes go to a temporary file that replaces the original only once
+///          it's complete, so a crash never leaves a truncated cache behind.
+class CacheFile
+{
+public:
+    using Magic = std::array<char,4>;
+
+    /// @brief Written in front of the payload; 64 bit members come first to keep the layout free of padding.
+    struct Header
+    {
+        /// @brief Size of the payload following the header [bytes].
+        uint64_t dataSize;
+
+        /// @brief FNV-1a hash of the payload.
+        uint64_t checksum;
+
+        Magic magic;
+
+        uint32_t version;
+    }; // struct Header
+
+public:
+    /// @brief Read the payload of a cache file.
+    /// @return the payload, or nullopt if the file is missing, corrupt or of a different format or version.
+    static std::optional<std::vector<char>> read(const std::filesystem::path& r_path,
+                                                 const Magic& r_magic,
+                                                 uint32_t version);
+
+    /// @brief Replace a cache file with a new payload, creating its directory if necessary.
+    static void write(const std::filesystem::path& r_path,
+                      const Magic& r_magic,
+                      uint32_t version,
+                      std::span<const char> data);
+
+    /// @brief FNV-1a hash of a byte range.
+    static uint64_t computeChecksum(std::span<const char> data) noexcept;
+}; // class CacheFile
@@ -0,0 +1,312 @@
+// --- Internal Includes ---
+#include "CapabilityCache.hpp"
+#include "CacheFile.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace {
+
+
+constexpr CacheFile::Magic fileMagic {'V', 'K', 'D', 'C'};
+
+
+constexpr uint32_t fileVersion = 4;
+
+
+/// @brief Appends trivially copyable values and arrays of them to a byte buffer.
+/// @details The file never leaves the machine it was written on, so values are stored as they are in memory.
+class Writer
+{
+public:
+    template <class T>
+    void write(const T& r_value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const char* p_begin = reinterpret_cast<const char*>(&r_value);
+        _data.insert(_data.end(), p_begin, p_begin + sizeof(T));
+    }
+
+    template <class T>
+    void write(const std::vector<T>& r_values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->write(static_cast<uint64_t>(r_values.size()));
+        const char* p_begin = reinterpret_cast<const char*>(r_values.data());
+        _data.insert(_data.end(), p_begin, p_begin + r_values.size() * sizeof(T));
+    }
+
+    const std::vector<char>& getData() const noexcept
+    {
+        return _data;
+    }
+
+private:
+    std::vector<char> _data;
+}; // class Writer
+
+
+/// @brief Reads what @ref Writer wrote, failing instead of reading past the end.
+class Reader
+{
+public:
+    Reader(const char* p_begin, std::size_t size) noexcept
+        : _p_current(p_begin),
+          _remaining(size)
+    {
+    }
+
+    template <class T>
+    bool read(T& r_value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (_remaining < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&r_value, _p_current, sizeof(T));
+        _p_current += sizeof(T);
+        _remaining -= sizeof(T);
+        return true;
+    }
+
+    template <class T>
+    bool read(std::vector<T>& r_values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t size = 0;
+        if (!this->read(size) || _remaining / sizeof(T) < size) {
+            return false;
+        }
+        r_values.resize(size);
+        if (size != 0) {
+            std::memcpy(r_values.data(), _p_current, size * sizeof(T));
+        }
+        _p_current += size * sizeof(T);
+        _remaining -= size * sizeof(T);
+        return true;
+    }
+
+    bool isDone() const noexcept
+    {
+        return _remaining == 0;
+    }
+
+private:
+    const char* _p_current;
+
+    std::size_t _remaining;
+}; // class Reader
+
+
+} // unnamed namespace
+
+
+CapabilityCache::DeviceKey CapabilityCache::DeviceKey::make(const VkPhysicalDeviceProperties& r_properties) noexcept
+{
+    DeviceKey key;
+    key.vendorID = r_properties.vendorID;
+    key.deviceID = r_properties.deviceID;
+    key.driverVersion = r_properties.driverVersion;
+    std::copy(r_properties.pipelineCacheUUID,
+              r_properties.pipelineCacheUUID + key.uuid.size(),
+              key.uuid.begin());
+    return key;
+}
+
+
+CapabilityCache::CapabilityCache(std::filesystem::path&& r_path)
+    : _path(std::move(r_path)),
+      _entry(),
+      _isWarm(false),
+      _isModified(false),
+      _skippedTime(0)
+{
+    VKTUTORIAL_TRACE_SCOPE("CapabilityCache::CapabilityCache");
+
+    const auto contents = CacheFile::read(_path, fileMagic, fileVersion);
+    if (!contents.has_value()) {
+        return;
+    }
+
+    // Anything that doesn't parse is treated like a missing file
+    Entry entry;
+    uint32_t requiresPresentation = 0;
+    Reader reader(contents->data(), contents->size());
+    bool isValid = reader.read(entry.loaderVersion)
+                   && reader.read(requiresPresentation)
+                   && reader.read(entry.devices)
+                   && reader.read(entry.i_device)
+                   && reader.read(entry.deviceQueryTime)
+                   && reader.read(entry.features)
+                   && reader.read(entry.descriptorIndexingFeatures)
+                   && reader.read(entry.descriptorIndexingProperties)
+                   && reader.read(entry.memoryProperties)
+                   && reader.read(entry.queueFamilies)
+                   && reader.read(entry.extensions)
+                   && reader.isDone();
+    isValid &= entry.i_device < entry.devices.size();
+
+    if (isValid) {
+        entry.descriptorIndexingFeatures.pNext = nullptr;
+        entry.descriptorIndexingProperties.pNext = nullptr;
+        entry.requiresPresentation = requiresPresentation;
+        _entry.emplace(std::move(entry));
+    }
+}
+
+
+CapabilityCache::~CapabilityCache()
+{
+    try {
+        this->save();
+    } catch (const std::exception& r_exception) {
+        std::cerr << "Failed to save capability cache to " << _path << ": " << r_exception.what() << '\n';
+    }
+}
+
+
+void CapabilityCache::save()
+{
+    if (!_isModified || !_entry.has_value()) {
+        return;
+    }
+
+    const Entry& r_entry = _entry.value();
+    Writer writer;
+    writer.write(r_entry.loaderVersion);
+    writer.write(static_cast<uint32_t>(r_entry.requiresPresentation));
+    writer.write(r_entry.devices);
+    writer.write(r_entry.i_device);
+    writer.write(r_entry.deviceQueryTime);
+    writer.write(r_entry.features);
+    writer.write(r_entry.descriptorIndexingFeatures);
+    writer.write(r_entry.descriptorIndexingProperties);
+    writer.write(r_entry.memoryProperties);
+    writer.write(r_entry.queueFamilies);
+    writer.write(r_entry.extensions);
+
+    CacheFile::write(_path, fileMagic, fileVersion, writer.getData());
+    _isModified = false;
+}
+
+
+std::optional<PhysicalDevice> CapabilityCache::getDefaultDevice(VkInstance instance,
+                                                                std::optional<VkSurfaceKHR> surface)
+{
+    VKTUTORIAL_TRACE_SCOPE("CapabilityCache::getDefaultDevice");
+    const int64_t begin = Trace::now();
+
+    // Properties are needed for the keys either way, and reading them doesn't enumerate anything
+    uint32_t deviceCount = 0;
+    vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
+    devices.resize(deviceCount);
+
+    std::vector<VkPhysicalDeviceProperties> properties(devices.size());
+    std::vector<DeviceKey> keys;
+    keys.reserve(devices.size());
+    for (std::size_t i_device=0; i_device<devices.size(); ++i_device) {
+        vkGetPhysicalDeviceProperties(devices[i_device], &properties[i_device]);
+        keys.push_back(DeviceKey::make(properties[i_device]));
+    }
+
+    const uint32_t loaderVersion = CapabilityCache::getLoaderVersion();
+    if (_entry.has_value()
+        && _entry->loaderVersion == loaderVersion
+        && _entry->requiresPresentation == surface.has_value()
+        && _entry->devices == keys) {
+        const uint32_t i_device = _entry->i_device;
+
+        auto p_capabilities = std::make_shared<PhysicalDevice::Capabilities>();
+        p_capabilities->properties = properties[i_device];
+        p_capabilities->features = _entry->features;
+        p_capabilities->descriptorIndexingFeatures = _entry->descriptorIndexingFeatures;
+        p_capabilities->descriptorIndexingProperties = _entry->descriptorIndexingProperties;
+        p_capabilities->memoryProperties = _entry->memoryProperties;
+        p_capabilities->queueFamilies = _entry->queueFamilies;
+        p_capabilities->extensions = _entry->extensions;
+        p_capabilities->indexExtensions();
+
+        _isWarm = true;
+        this->skip(_entry->deviceQueryTime);
+        return PhysicalDevice(devices[i_device], std::move(p_capabilities));
+    }
+
+    // Some key changed, so everything is queried again
+    _isWarm = false;
+    _entry.reset();
+
+    auto pick = PhysicalDevice::getDefaultDevice(instance, surface);
+    const auto it_pick = pick.has_value() ? std::find(devices.begin(), devices.end(), pick->getDevice()) : devices.end();
+    if (it_pick != devices.end()) {
+        const auto& r_capabilities = pick->getCapabilities();
+
+        Entry entry;
+        entry.loaderVersion = loaderVersion;
+        entry.requiresPresentation = surface.has_value();
+        entry.devices = std::move(keys);
+        entry.i_device = static_cast<uint32_t>(std::distance(devices.begin(), it_pick));
+        entry.features = r_capabilities.features;
+        entry.descriptorIndexingFeatures = r_capabilities.descriptorIndexingFeatures;
+        entry.descriptorIndexingProperties = r_capabilities.descriptorIndexingProperties;
+        entry.memoryProperties = r_capabilities.memoryProperties;
+        entry.queueFamilies = r_capabilities.queueFamilies;
+        entry.extensions = r_capabilities.extensions;
+        entry.deviceQueryTime = Trace::now() - begin;
+
+        _entry.emplace(std::move(entry));
+        _isModified = true;
+    }
+
+    return pick;
+}
+
+
+const std::filesystem::path& CapabilityCache::getPath() const noexcept
+{
+    return _path;
+}
+
+
+bool CapabilityCache::isWarm() const noexcept
+{
+    return _isWarm;
+}
+
+
+double CapabilityCache::getSkippedTime() const noexcept
+{
+    return 1e-9 * static_cast<double>(_skippedTime);
+}
+
+
+uint32_t CapabilityCache::getLoaderVersion()
+{
+    // Loaders older than Vulkan 1.1 don't provide vkEnumerateInstanceVersion
+    const auto p_enumerate = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+        vkGetInstanceProcAddr(VK_NULL_HANDLE, "vkEnumerateInstanceVersion")
+    );
+
+    uint32_t version = VK_API_VERSION_1_0;
+    if (p_enumerate != nullptr && p_enumerate(&version) != VK_SUCCESS) {
+        version = VK_API_VERSION_1_0;
+    }
+    return version;
+}
+
+
+void CapabilityCache::skip(int64_t queryTime)
+{
+    _skippedTime += queryTime;
+    if constexpr (Trace::isEnabled()) {
+        Trace::recordCounter("capability cache skipped [ms]", 1e-6 * static_cast<double>(_skippedTime));
+    }
+}
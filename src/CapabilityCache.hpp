@@ -0,0 +1,132 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "PhysicalDevice.hpp"
+
+// --- STL Includes ---
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+
+/// @brief Device selection persisted on disk between runs.
+/// @details Picking the default device queries the features, queue families and extensions
+///          of every device. This cache stores the outcome, keyed by the loader version and
+///          the vendor, device, driver version and UUID of every enumerated device. Warm
+///          starts only enumerate the devices and read their properties to compute the keys.
+///          If any key changed (a driver or loader update, a device added or removed) the
+///          full queries run again and replace the cache.
+///
+///          Surface formats, present modes and presentation support depend on the window
+///          system and display rather than the device, so swap chain properties are always
+///          queried (see @ref SwapChain::Properties::query). The file is loaded on construction
+///          and written on destruction through @ref CacheFile, like @ref PipelineCache.
+/// @note Bump the file version if the device selection criteria change.
+class CapabilityCache
+{
+public:
+    /// @brief Identifies a physical device and the driver build it runs on.
+    /// @details The instance targets Vulkan 1.2, but the device UUID of Vulkan 1.1 identifies
+    ///          the device rather than the driver build. The pipeline cache UUID, which drivers
+    ///          change whenever their build changes, is used instead.
+    struct DeviceKey
+    {
+        uint32_t vendorID;
+
+        uint32_t deviceID;
+
+        uint32_t driverVersion;
+
+        PhysicalDevice::UUID uuid;
+
+        bool operator==(const DeviceKey&) const = default;
+
+        static DeviceKey make(const VkPhysicalDeviceProperties& r_properties) noexcept;
+    }; // struct DeviceKey
+
+public:
+    CapabilityCache(std::filesystem::path&& r_path);
+
+    CapabilityCache(const CapabilityCache&) = delete;
+
+    /// @brief Write the cache to disk if anything was queried.
+    ~CapabilityCache();
+
+    /// @brief Write the cache to disk if anything was queried since it was loaded.
+    void save();
+
+    /// @brief Pick the most suitable physical device, like @ref PhysicalDevice::getDefaultDevice.
+    /// @details If the keys of all devices match the cache, the pick and its capabilities
+    ///          come from the cache. Otherwise @ref PhysicalDevice::getDefaultDevice runs
+    ///          and its result replaces the cache.
+    std::optional<PhysicalDevice> getDefaultDevice(VkInstance instance,
+                                                   std::optional<VkSurfaceKHR> surface);
+
+    /// @name Member Access
+    /// @{
+
+    const std::filesystem::path& getPath() const noexcept;
+
+    /// @brief Check whether the device was picked from the cache.
+    bool isWarm() const noexcept;
+
+    /// @brief Get the time the queries answered from the cache took when they last ran [s].
+    double getSkippedTime() const noexcept;
+
+    /// @}
+
+    /// @brief Get the instance version supported by the loader.
+    static uint32_t getLoaderVersion();
+
+private:
+    struct Entry
+    {
+        uint32_t loaderVersion = 0;
+
+        /// @brief Whether the device had to support presenting to a surface.
+        bool requiresPresentation = false;
+
+        /// @brief Keys of all devices, in the order they were enumerated in.
+        std::vector<DeviceKey> devices;
+
+        /// @brief Index of the picked device in @ref devices.
+        uint32_t i_device = 0;
+
+        /// @brief Time picking the device took [ns].
+        int64_t deviceQueryTime = 0;
+
+        VkPhysicalDeviceFeatures features {};
+
+        /// @brief Stored with a dangling @a pNext, which is cleared on load.
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures {};
+
+        /// @brief Stored with a dangling @a pNext, which is cleared on load.
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties {};
+
+        VkPhysicalDeviceMemoryProperties memoryProperties {};
+
+        std::vector<VkQueueFamilyProperties> queueFamilies;
+
+        std::vector<VkExtensionProperties> extensions;
+    }; // struct Entry
+
+    /// @brief Account for a query answered from the cache, and report it to the trace.
+    void skip(int64_t queryTime);
+
+private:
+    std::filesystem::path _path;
+
+    std::optional<Entry> _entry;
+
+    bool _isWarm;
+
+    /// @brief Set if the entry changed since it was loaded.
+    bool _isModified;
+
+    /// @brief Sum of the query times of everything answered from the cache [ns].
+    int64_t _skippedTime;
+}; // class CapabilityCache
@@ -0,0 +1,160 @@
+// --- Internal Includes ---
+#include "CommandRecorder.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+
+
+CommandRecorder::CommandRecorder(const std::shared_ptr<LogicalDevice>& rp_device,
+                                 std::size_t framesInFlight,
+                                 std::size_t threadCount)
+    : _p_device(rp_device),
+      _device(rp_device->getDevice()),
+      _pools(),
+      _framesInFlight(framesInFlight),
+      _i_frame(0),
+      _workers(threadCount)
+{
+    if (_framesInFlight == 0) {
+        throw std::runtime_error("Command recorder requires at least one frame in flight");
+    }
+
+    const auto queueFamily = _p_device->getPhysicalDevice().getQueueFamily({});
+
+    // One pool per worker per frame in flight
+    _pools.reserve(_framesInFlight * _workers.size());
+    for (std::size_t i_pool=0; i_pool<_framesInFlight * _workers.size(); ++i_pool) {
+        Pool pool {};
+
+        VkCommandPoolCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        info.queueFamilyIndex = queueFamily.graphics.value();
+        if (vkCreateCommandPool(_device, &info, _p_device->getAllocationCallbacks(), &pool.commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create worker command pool");
+        }
+
+        _pools.push_back(std::move(pool));
+    }
+}
+
+
+CommandRecorder::~CommandRecorder()
+{
+    // Destroying a pool frees its command buffers
+    for (Pool& r_pool : _pools) {
+        vkDestroyCommandPool(_device, r_pool.commandPool, _p_device->getAllocationCallbacks());
+    }
+}
+
+
+void CommandRecorder::beginFrame()
+{
+    _i_frame = (_i_frame + 1) % _framesInFlight;
+
+    const auto it_begin = _pools.begin() + _i_frame * _workers.size();
+    for (auto it_pool=it_begin; it_pool!=it_begin + _workers.size(); ++it_pool) {
+        if (it_pool->usedCount) {
+            vkResetCommandPool(_device, it_pool->commandPool, 0);
+            it_pool->usedCount = 0;
+        }
+    }
+}
+
+
+void CommandRecorder::record(VkCommandBuffer primary,
+                             const Inheritance& r_inheritance,
+                             std::size_t drawCount,
+                             const BatchRecorder& r_recorder)
+{
+    if (drawCount == 0) {
+        return;
+    }
+
+    // Split the draws evenly, but don't bother spawning batches without draws
+    const std::size_t batchCount = std::min(_workers.size(), drawCount);
+    const std::size_t batchSize = drawCount / batchCount;
+    const std::size_t remainder = drawCount % batchCount;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = r_inheritance.renderPass;
+    inheritanceInfo.subpass = r_inheritance.subpass;
+    inheritanceInfo.framebuffer = r_inheritance.framebuffer;
+
+    std::vector<VkCommandBuffer> secondaries(batchCount);
+    std::vector<std::future<void>> batches;
+    batches.reserve(batchCount);
+
+    std::size_t begin = 0;
+    for (std::size_t i_batch=0; i_batch<batchCount; ++i_batch) {
+        const std::size_t end = begin + batchSize + (i_batch < remainder ? 1 : 0);
+        Pool& r_pool = _pools[_i_frame * _workers.size() + i_batch];
+
+        batches.push_back(_workers.submit([this, &r_pool, &inheritanceInfo, &r_recorder, &r_secondary = secondaries[i_batch], begin, end]() {
+            VKTUTORIAL_TRACE_SCOPE("CommandRecorder::batch");
+            r_secondary = this->acquire(r_pool);
+
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+            if (vkBeginCommandBuffer(r_secondary, &beginInfo) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to begin secondary command buffer");
+            }
+
+            r_recorder(r_secondary, begin, end);
+
+            if (vkEndCommandBuffer(r_secondary) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to record secondary command buffer");
+            }
+        }));
+
+        begin = end;
+    }
+
+    // Wait for every batch before rethrowing, since they reference local state
+    for (auto& r_batch : batches) {
+        r_batch.wait();
+    }
+    for (auto& r_batch : batches) {
+        r_batch.get();
+    }
+
+    vkCmdExecuteCommands(primary, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+}
+
+
+std::size_t CommandRecorder::getThreadCount() const noexcept
+{
+    return _workers.size();
+}
+
+
+std::size_t CommandRecorder::getFramesInFlight() const noexcept
+{
+    return _framesInFlight;
+}
+
+
+VkCommandBuffer CommandRecorder::acquire(Pool& r_pool)
+{
+    if (r_pool.usedCount == r_pool.commandBuffers.size()) {
+        VkCommandBufferAllocateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool = r_pool.commandPool;
+        info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        info.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        if (vkAllocateCommandBuffers(_device, &info, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate secondary command buffer");
+        }
+        r_pool.commandBuffers.push_back(commandBuffer);
+    }
+
+    return r_pool.commandBuffers[r_pool.usedCount++];
+}
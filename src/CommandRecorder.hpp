@@ -0,0 +1,106 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "ThreadPool.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+/// @brief Records draws into secondary command buffers on multiple threads.
+/// @details @ref record splits a range of draws into one batch per worker thread. Each batch
+///          is recorded into a secondary command buffer from a command pool that belongs
+///          exclusively to that batch slot and the current frame in flight, so pools are never
+///          accessed from two threads at once. The secondary buffers are then executed from the
+///          caller's primary buffer with @a vkCmdExecuteCommands.
+///
+///          @ref beginFrame resets all pools of the next frame slot at once; secondary buffers
+///          are reused instead of being freed and allocated again.
+/// @note @ref beginFrame and @ref record must be called from a single thread.
+class CommandRecorder
+{
+public:
+    /// @brief Records the draws in [begin, end) into a secondary command buffer.
+    /// @details Called concurrently from worker threads with disjoint ranges. Dynamic state
+    ///          isn't inherited from the primary buffer, so it has to be set in each batch.
+    using BatchRecorder = std::function<void(VkCommandBuffer,std::size_t,std::size_t)>;
+
+    /// @brief Render pass state secondary buffers continue.
+    struct Inheritance
+    {
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+
+        uint32_t subpass = 0;
+
+        /// @brief Optional, but may help the driver if provided.
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    }; // struct Inheritance
+
+public:
+    /// @param threadCount number of worker threads and batches; defaults to the number of hardware threads.
+    CommandRecorder(const std::shared_ptr<LogicalDevice>& rp_device,
+                    std::size_t framesInFlight,
+                    std::size_t threadCount = std::thread::hardware_concurrency());
+
+    CommandRecorder(const CommandRecorder&) = delete;
+
+    ~CommandRecorder();
+
+    /// @brief Move on to the next frame slot and reset its command pools.
+    /// @details The caller must make sure the device is done with the slot's previous frame,
+    ///          for example by calling this from a @ref FrameLoop::Recorder of a loop with the
+    ///          same number of frames in flight.
+    void beginFrame();
+
+    /// @brief Record @a drawCount draws in parallel and execute them from @a primary.
+    /// @details @a primary must be inside a render pass instance begun with
+    ///          @a VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS. Blocks until all batches
+    ///          are recorded, and rethrows the first exception thrown by a batch.
+    void record(VkCommandBuffer primary,
+                const Inheritance& r_inheritance,
+                std::size_t drawCount,
+                const BatchRecorder& r_recorder);
+
+    std::size_t getThreadCount() const noexcept;
+
+    std::size_t getFramesInFlight() const noexcept;
+
+private:
+    /// @brief Command pool of a single batch slot in a single frame slot.
+    struct Pool
+    {
+        VkCommandPool commandPool;
+
+        /// @brief Secondary buffers allocated from the pool so far.
+        std::vector<VkCommandBuffer> commandBuffers;
+
+        /// @brief Number of buffers used in the current frame.
+        std::size_t usedCount;
+    }; // struct Pool
+
+    /// @brief Get an unused secondary buffer from a pool, allocating one if necessary.
+    VkCommandBuffer acquire(Pool& r_pool);
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkDevice _device;
+
+    /// @brief Pools of all batch slots, grouped by frame slot.
+    std::vector<Pool> _pools;
+
+    std::size_t _framesInFlight;
+
+    std::size_t _i_frame;
+
+    ThreadPool _workers;
+}; // class CommandRecorder
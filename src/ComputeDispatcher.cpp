@@ -0,0 +1,211 @@
+// --- Internal Includes ---
+#include "ComputeDispatcher.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+
+ComputeDispatcher::ComputeDispatcher(const std::shared_ptr<LogicalDevice>& rp_device)
+    : _p_device(rp_device),
+      _device(rp_device->getDevice()),
+      _queue(rp_device->getQueue(LogicalDevice::QueueType::Compute)),
+      _commandPool(VK_NULL_HANDLE),
+      _commandBuffer(VK_NULL_HANDLE),
+      _fence(VK_NULL_HANDLE),
+      _descriptors(rp_device, 1),
+      _isRecording(false)
+{
+    VkCommandPoolCreateInfo poolInfo {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = _p_device->getQueueFamilyIndex(LogicalDevice::QueueType::Compute);
+    if (vkCreateCommandPool(_device, &poolInfo, _p_device->getAllocationCallbacks(), &_commandPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create compute command pool");
+    }
+
+    VkCommandBufferAllocateInfo bufferInfo {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    bufferInfo.commandPool = _commandPool;
+    bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    bufferInfo.commandBufferCount = 1;
+
+    VkFenceCreateInfo fenceInfo {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    if (vkAllocateCommandBuffers(_device, &bufferInfo, &_commandBuffer) != VK_SUCCESS
+        || vkCreateFence(_device, &fenceInfo, _p_device->getAllocationCallbacks(), &_fence) != VK_SUCCESS) {
+        vkDestroyCommandPool(_device, _commandPool, _p_device->getAllocationCallbacks());
+        throw std::runtime_error("Failed to create compute command buffer");
+    }
+}
+
+
+ComputeDispatcher::~ComputeDispatcher()
+{
+    // Batches are waited on by submit, so the device is done with everything here
+    vkDestroyFence(_device, _fence, _p_device->getAllocationCallbacks());
+    vkDestroyCommandPool(_device, _commandPool, _p_device->getAllocationCallbacks());
+}
+
+
+void ComputeDispatcher::begin()
+{
+    if (_isRecording) {
+        throw std::runtime_error("Compute batch is already being recorded");
+    }
+
+    // The previous batch finished in submit, so its descriptor sets can go
+    _descriptors.beginFrame();
+    vkResetCommandBuffer(_commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(_commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to begin compute command buffer");
+    }
+
+    _isRecording = true;
+}
+
+
+void ComputeDispatcher::dispatch(const ComputePipeline& r_pipeline,
+                                 std::span<const VkBuffer> buffers,
+                                 std::span<const std::byte> pushConstants,
+                                 uint32_t groupCount)
+{
+    if (!_isRecording) {
+        throw std::runtime_error("Compute dispatches must be recorded between begin and submit");
+    }
+
+    if (buffers.size() != r_pipeline.getStorageBufferCount()) {
+        throw std::runtime_error("Storage buffer count doesn't match the compute pipeline's layout");
+    }
+
+    if (pushConstants.size() != r_pipeline.getPushConstantSize()) {
+        throw std::runtime_error("Push constant size doesn't match the compute pipeline's layout");
+    }
+
+    if (groupCount == 0) {
+        return;
+    }
+
+    if (this->getMaxGroupCount() < groupCount) {
+        throw std::runtime_error("Compute dispatch exceeds the device's work group count limit");
+    }
+
+    vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, r_pipeline.get());
+
+    if (!buffers.empty()) {
+        const VkDescriptorSet set = _descriptors.allocate(r_pipeline.getDescriptorSetLayout());
+
+        std::vector<VkDescriptorBufferInfo> bufferInfos(buffers.size());
+        std::vector<VkWriteDescriptorSet> writes(buffers.size());
+        for (std::size_t i_binding=0; i_binding<buffers.size(); ++i_binding) {
+            bufferInfos[i_binding].buffer = buffers[i_binding];
+            bufferInfos[i_binding].offset = 0;
+            bufferInfos[i_binding].range = VK_WHOLE_SIZE;
+
+            writes[i_binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i_binding].dstSet = set;
+            writes[i_binding].dstBinding = static_cast<uint32_t>(i_binding);
+            writes[i_binding].descriptorCount = 1;
+            writes[i_binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i_binding].pBufferInfo = &bufferInfos[i_binding];
+        }
+        vkUpdateDescriptorSets(_device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+        vkCmdBindDescriptorSets(_commandBuffer,
+                                VK_PIPELINE_BIND_POINT_COMPUTE,
+                                r_pipeline.getLayout(),
+                                0,
+                                1,
+                                &set,
+                                0,
+                                nullptr);
+    }
+
+    if (!pushConstants.empty()) {
+        vkCmdPushConstants(_commandBuffer,
+                           r_pipeline.getLayout(),
+                           VK_SHADER_STAGE_COMPUTE_BIT,
+                           0,
+                           static_cast<uint32_t>(pushConstants.size()),
+                           pushConstants.data());
+    }
+
+    vkCmdDispatch(_commandBuffer, groupCount, 1, 1);
+}
+
+
+void ComputeDispatcher::barrier()
+{
+    if (!_isRecording) {
+        throw std::runtime_error("Compute barriers must be recorded between begin and submit");
+    }
+
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(_commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1, &barrier,
+                         0, nullptr,
+                         0, nullptr);
+}
+
+
+void ComputeDispatcher::submit()
+{
+    VKTUTORIAL_TRACE_SCOPE("ComputeDispatcher::submit");
+
+    if (!_isRecording) {
+        throw std::runtime_error("No compute batch is being recorded");
+    }
+    _isRecording = false;
+
+    // Make shader writes available to the host; the fence wait then makes them visible
+    VkMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(_commandBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_HOST_BIT,
+                         0,
+                         1, &barrier,
+                         0, nullptr,
+                         0, nullptr);
+
+    if (vkEndCommandBuffer(_commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record compute command buffer");
+    }
+
+    VkSubmitInfo submitInfo {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &_commandBuffer;
+    vkResetFences(_device, 1, &_fence);
+    if (vkQueueSubmit(_queue, 1, &submitInfo, _fence) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit compute batch");
+    }
+    vkWaitForFences(_device, 1, &_fence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+}
+
+
+uint32_t ComputeDispatcher::getMaxGroupCount() const noexcept
+{
+    return _p_device->getPhysicalDevice().getProperties().limits.maxComputeWorkGroupCount[0];
+}
+
+
+bool ComputeDispatcher::isRecording() const noexcept
+{
+    return _isRecording;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "ComputePipeline.hpp"
+#include "DescriptorAllocator.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+
+/// @brief Records batches of compute dispatches and runs them on the device's compute queue.
+/// @details A batch is recorded between @ref begin and @ref submit. Each @ref dispatch binds
+///          a @ref ComputePipeline, a descriptor set pointing at the provided storage buffers,
+///          and the push constants. Dispatches within a batch may overlap unless they are
+///          separated by a @ref barrier. @ref submit blocks until the batch finished, after
+///          which shader writes are visible to the host (see @ref StorageBuffer::view).
+///
+///          Descriptor sets are allocated from a @ref DescriptorAllocator with a single frame
+///          slot, which is released when the next batch begins.
+/// @note Not thread safe. The compute queue may be shared with other users of the device
+///       (see @ref LogicalDevice::QueueType), which must not submit to it concurrently.
+class ComputeDispatcher
+{
+public:
+    ComputeDispatcher(const std::shared_ptr<LogicalDevice>& rp_device);
+
+    ComputeDispatcher(const ComputeDispatcher&) = delete;
+
+    ~ComputeDispatcher();
+
+    /// @name Recording
+    /// @{
+
+    /// @brief Start recording a new batch.
+    void begin();
+
+    /// @brief Record a dispatch of @a groupCount work groups along x.
+    /// @param buffers storage buffers to bind, in binding order; as many as the pipeline has bindings.
+    /// @param pushConstants contents of the push constant block; as large as the pipeline's block.
+    void dispatch(const ComputePipeline& r_pipeline,
+                  std::span<const VkBuffer> buffers,
+                  std::span<const std::byte> pushConstants,
+                  uint32_t groupCount);
+
+    /// @brief Record a dispatch, with the push constant block provided as a struct.
+    template <class TPushConstants>
+    void dispatch(const ComputePipeline& r_pipeline,
+                  std::span<const VkBuffer> buffers,
+                  const TPushConstants& r_pushConstants,
+                  uint32_t groupCount)
+    {
+        static_assert(std::is_trivially_copyable_v<TPushConstants>);
+        this->dispatch(r_pipeline,
+                       buffers,
+                       std::as_bytes(std::span<const TPushConstants,1>(&r_pushConstants, 1)),
+                       groupCount);
+    }
+
+    /// @brief Make the writes of all previous dispatches visible to the following ones.
+    void barrier();
+
+    /// @brief Submit the batch and wait until it finished.
+    void submit();
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// @brief Largest number of work groups a single dispatch may have along x.
+    uint32_t getMaxGroupCount() const noexcept;
+
+    bool isRecording() const noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkDevice _device;
+
+    VkQueue _queue;
+
+    VkCommandPool _commandPool;
+
+    VkCommandBuffer _commandBuffer;
+
+    VkFence _fence;
+
+    DescriptorAllocator _descriptors;
+
+    bool _isRecording;
+}; // class ComputeDispatcher
@@ -0,0 +1,195 @@
+// --- Internal Includes ---
+#include "ComputeKernels.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+
+namespace {
+
+
+/// @brief Push constant block of saxpy.comp.
+struct SaxpyParameters
+{
+    uint32_t count;
+
+    float a;
+}; // struct SaxpyParameters
+
+
+/// @brief Push constant block of reduce.comp.
+struct ReduceParameters
+{
+    uint32_t count;
+}; // struct ReduceParameters
+
+
+/// @brief Push constant block of scan.comp and scanAdd.comp.
+struct ScanParameters
+{
+    uint32_t count;
+
+    uint32_t firstBlock;
+}; // struct ScanParameters
+
+
+uint32_t getGroupCount(std::size_t count) noexcept
+{
+    return static_cast<uint32_t>((count + ComputeKernels::groupSize - 1) / ComputeKernels::groupSize);
+}
+
+
+/// @brief Check that a buffer holds @a count floats, and that shaders can index them.
+void checkCount(const StorageBuffer& r_buffer, std::size_t count)
+{
+    if (std::numeric_limits<uint32_t>::max() < count) {
+        throw std::runtime_error("Compute kernels index values with 32 bit integers");
+    }
+    if (r_buffer.getSize() / sizeof(float) < count) {
+        throw std::runtime_error("Storage buffer is too small for the kernel's value count");
+    }
+}
+
+
+} // unnamed namespace
+
+
+ComputeKernels::ComputeKernels(const std::shared_ptr<LogicalDevice>& rp_device,
+                               const ShaderLoader& r_loader)
+    : ComputeKernels(rp_device, r_loader, Settings())
+{
+}
+
+
+ComputeKernels::ComputeKernels(const std::shared_ptr<LogicalDevice>& rp_device,
+                               const ShaderLoader& r_loader,
+                               const Settings& r_settings,
+                               const std::shared_ptr<PipelineCache>& rp_cache)
+    : _p_device(rp_device),
+      _settings(r_settings),
+      _saxpy(rp_device, r_loader("saxpy.comp.spv"), 2, sizeof(SaxpyParameters), rp_cache),
+      _reduce(rp_device, r_loader("reduce.comp.spv"), 2, sizeof(ReduceParameters), rp_cache),
+      _scan(rp_device, r_loader("scan.comp.spv"), 2, sizeof(ScanParameters), rp_cache),
+      _scanAdd(rp_device, r_loader("scanAdd.comp.spv"), 2, sizeof(ScanParameters), rp_cache),
+      _p_partialSums(),
+      _blockSums()
+{
+    if (_settings.reduceGroupCount == 0) {
+        throw std::runtime_error("Reductions require at least one work group");
+    }
+    _p_partialSums = std::make_unique<StorageBuffer>(_p_device, _settings.reduceGroupCount * sizeof(float));
+
+    // Every level holds the totals of the blocks of the one below, down to a single block
+    std::size_t count = std::max<std::size_t>(_settings.maxScanCount, 1);
+    do {
+        count = getGroupCount(count);
+        _blockSums.push_back(std::make_unique<StorageBuffer>(_p_device, count * sizeof(float)));
+    } while (1 < count);
+}
+
+
+void ComputeKernels::saxpy(ComputeDispatcher& r_dispatcher,
+                           float a,
+                           const StorageBuffer& r_x,
+                           StorageBuffer& r_y,
+                           std::size_t count)
+{
+    checkCount(r_x, count);
+    checkCount(r_y, count);
+    if (!count) {
+        return;
+    }
+
+    // The shader loops over the values if there are more than the groups cover
+    const std::array<VkBuffer,2> buffers {r_x.get(), r_y.get()};
+    r_dispatcher.dispatch(_saxpy,
+                          buffers,
+                          SaxpyParameters {static_cast<uint32_t>(count), a},
+                          std::min(getGroupCount(count), r_dispatcher.getMaxGroupCount()));
+    r_dispatcher.barrier();
+}
+
+
+void ComputeKernels::reduce(ComputeDispatcher& r_dispatcher,
+                            const StorageBuffer& r_input,
+                            StorageBuffer& r_output,
+                            std::size_t count)
+{
+    checkCount(r_input, count);
+    checkCount(r_output, 1);
+
+    // First pass: each group sums a strided share of the values
+    const uint32_t groupCount = std::clamp(getGroupCount(count),
+                                           uint32_t(1),
+                                           std::min(_settings.reduceGroupCount, r_dispatcher.getMaxGroupCount()));
+    const std::array<VkBuffer,2> firstPass {r_input.get(), groupCount == 1 ? r_output.get() : _p_partialSums->get()};
+    r_dispatcher.dispatch(_reduce,
+                          firstPass,
+                          ReduceParameters {static_cast<uint32_t>(count)},
+                          groupCount);
+    r_dispatcher.barrier();
+
+    // Second pass: a single group sums the partial sums
+    if (1 < groupCount) {
+        const std::array<VkBuffer,2> secondPass {_p_partialSums->get(), r_output.get()};
+        r_dispatcher.dispatch(_reduce,
+                              secondPass,
+                              ReduceParameters {groupCount},
+                              1);
+        r_dispatcher.barrier();
+    }
+}
+
+
+void ComputeKernels::scan(ComputeDispatcher& r_dispatcher,
+                          StorageBuffer& r_data,
+                          std::size_t count)
+{
+    checkCount(r_data, count);
+    if (_settings.maxScanCount < count) {
+        throw std::runtime_error("Scan exceeds the value count its scratch buffers were sized for");
+    }
+    if (!count) {
+        return;
+    }
+
+    this->scan(r_dispatcher, r_data.get(), count, 0);
+}
+
+
+const ComputeKernels::Settings& ComputeKernels::getSettings() const noexcept
+{
+    return _settings;
+}
+
+
+void ComputeKernels::scan(ComputeDispatcher& r_dispatcher,
+                          VkBuffer data,
+                          std::size_t count,
+                          std::size_t i_level)
+{
+    const uint32_t blockCount = getGroupCount(count);
+    const uint32_t maxGroupCount = r_dispatcher.getMaxGroupCount();
+    const std::array<VkBuffer,2> buffers {data, _blockSums[i_level]->get()};
+
+    // Blocks beyond the group count limit are covered by further dispatches
+    const auto dispatchBlocks = [&](const ComputePipeline& r_pipeline) {
+        for (uint32_t firstBlock=0; firstBlock<blockCount; firstBlock+=maxGroupCount) {
+            r_dispatcher.dispatch(r_pipeline,
+                                  buffers,
+                                  ScanParameters {static_cast<uint32_t>(count), firstBlock},
+                                  std::min(maxGroupCount, blockCount - firstBlock));
+        }
+        r_dispatcher.barrier();
+    };
+
+    dispatchBlocks(_scan);
+
+    if (1 < blockCount) {
+        this->scan(r_dispatcher, _blockSums[i_level]->get(), blockCount, i_level + 1);
+        dispatchBlocks(_scanAdd);
+    }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "ComputePipeline.hpp"
+#include "ComputeDispatcher.hpp"
+#include "StorageBuffer.hpp"
+#include "PipelineCache.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+/// @brief Data parallel kernels on arrays of @a float, recorded into a @ref ComputeDispatcher.
+/// @details Each kernel records its dispatches into the dispatcher's current batch, followed
+///          by a @ref ComputeDispatcher::barrier, so kernels recorded one after the other
+///          see each other's results. Scratch buffers are allocated on construction, so
+///          batches never refer to memory that was freed while they were recorded.
+///
+///          Results match the reference implementations in @ref CpuKernels up to rounding,
+///          since the GPU adds the values in a different order.
+class ComputeKernels
+{
+public:
+    /// @brief Loads a compiled shader by file name (e.g.: "saxpy.comp.spv").
+    using ShaderLoader = std::function<std::shared_ptr<ShaderIO>(std::string_view)>;
+
+    struct Settings
+    {
+        /// @brief Largest number of values @ref scan supports.
+        std::size_t maxScanCount = std::size_t(1) << 24;
+
+        /// @brief Number of work groups the first pass of @ref reduce is spread across.
+        uint32_t reduceGroupCount = 256;
+    }; // struct Settings
+
+    /// @brief Number of invocations per work group, as declared in the shaders.
+    static constexpr uint32_t groupSize = 256;
+
+public:
+    ComputeKernels(const std::shared_ptr<LogicalDevice>& rp_device,
+                   const ShaderLoader& r_loader);
+
+    /// @param rp_cache cache to look up and store the compiled pipelines in, if any.
+    ComputeKernels(const std::shared_ptr<LogicalDevice>& rp_device,
+                   const ShaderLoader& r_loader,
+                   const Settings& r_settings,
+                   const std::shared_ptr<PipelineCache>& rp_cache = {});
+
+    ComputeKernels(const ComputeKernels&) = delete;
+
+    /// @brief y = a * x + y for the first @a count values.
+    void saxpy(ComputeDispatcher& r_dispatcher,
+               float a,
+               const StorageBuffer& r_x,
+               StorageBuffer& r_y,
+               std::size_t count);
+
+    /// @brief Write the sum of the first @a count values of @a r_input to the first value of @a r_output.
+    void reduce(ComputeDispatcher& r_dispatcher,
+                const StorageBuffer& r_input,
+                StorageBuffer& r_output,
+                std::size_t count);
+
+    /// @brief Replace the first @a count values with their inclusive prefix sums.
+    /// @details Scans blocks of @ref groupSize values, then scans the block totals the same
+    ///          way and adds them back, recursively.
+    void scan(ComputeDispatcher& r_dispatcher,
+              StorageBuffer& r_data,
+              std::size_t count);
+
+    const Settings& getSettings() const noexcept;
+
+private:
+    /// @brief Scan @a count values of @a data, using the block sums of @a i_level and above.
+    void scan(ComputeDispatcher& r_dispatcher,
+              VkBuffer data,
+              std::size_t count,
+              std::size_t i_level);
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    Settings _settings;
+
+    ComputePipeline _saxpy;
+
+    ComputePipeline _reduce;
+
+    ComputePipeline _scan;
+
+    ComputePipeline _scanAdd;
+
+    /// @brief Results of the first pass of @ref reduce, one per work group.
+    std::unique_ptr<StorageBuffer> _p_partialSums;
+
+    /// @brief Block totals of each level of @ref scan.
+    std::vector<std::unique_ptr<StorageBuffer>> _blockSums;
+}; // class ComputeKernels
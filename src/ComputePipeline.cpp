@@ -0,0 +1,128 @@
+// --- Internal Includes ---
+#include "ComputePipeline.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+#include <vector>
+
+
+ComputePipeline::ComputePipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+                                 const std::shared_ptr<ShaderIO>& rp_shaderIO,
+                                 uint32_t storageBufferCount,
+                                 uint32_t pushConstantSize,
+                                 const std::shared_ptr<PipelineCache>& rp_cache)
+    : _p_device(rp_device),
+      _p_shader(),
+      _storageBufferCount(storageBufferCount),
+      _pushConstantSize(pushConstantSize),
+      _descriptorSetLayout(VK_NULL_HANDLE),
+      _layout(VK_NULL_HANDLE),
+      _pipeline(VK_NULL_HANDLE)
+{
+    const VkDevice device = _p_device->getDevice();
+
+    if (!rp_shaderIO) {
+        throw std::runtime_error("Compute pipelines require a compute shader");
+    }
+
+    if (_p_device->getPhysicalDevice().getProperties().limits.maxPushConstantsSize < _pushConstantSize) {
+        throw std::runtime_error("Push constant block exceeds the device's limit");
+    }
+
+    _p_shader = std::make_unique<Shader>(*rp_shaderIO, *_p_device);
+
+    // Descriptor set layout: one storage buffer per binding
+    std::vector<VkDescriptorSetLayoutBinding> bindings(_storageBufferCount);
+    for (uint32_t i_binding=0; i_binding<_storageBufferCount; ++i_binding) {
+        bindings[i_binding].binding = i_binding;
+        bindings[i_binding].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i_binding].descriptorCount = 1;
+        bindings[i_binding].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo {};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = _storageBufferCount;
+    setLayoutInfo.pBindings = bindings.data();
+    if (vkCreateDescriptorSetLayout(device, &setLayoutInfo, _p_device->getAllocationCallbacks(), &_descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor set layout");
+    }
+
+    // Pipeline layout
+    VkPushConstantRange pushConstantRange {};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = _pushConstantSize;
+
+    VkPipelineLayoutCreateInfo layoutInfo {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &_descriptorSetLayout;
+    layoutInfo.pushConstantRangeCount = _pushConstantSize ? 1 : 0;
+    layoutInfo.pPushConstantRanges = &pushConstantRange;
+    if (vkCreatePipelineLayout(device, &layoutInfo, _p_device->getAllocationCallbacks(), &_layout) != VK_SUCCESS) {
+        vkDestroyDescriptorSetLayout(device, _descriptorSetLayout, _p_device->getAllocationCallbacks());
+        throw std::runtime_error("Failed to create pipeline layout");
+    }
+
+    // Assemble the pipeline
+    VkComputePipelineCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    info.stage.module = _p_shader->get();
+    info.stage.pName = "main";
+    info.layout = _layout;
+    info.basePipelineHandle = VK_NULL_HANDLE;
+    info.basePipelineIndex = -1;
+
+    if (vkCreateComputePipelines(device,
+                                 rp_cache ? rp_cache->get() : VK_NULL_HANDLE,
+                                 1,
+                                 &info,
+                                 _p_device->getAllocationCallbacks(),
+                                 &_pipeline) != VK_SUCCESS) {
+        vkDestroyPipelineLayout(device, _layout, _p_device->getAllocationCallbacks());
+        vkDestroyDescriptorSetLayout(device, _descriptorSetLayout, _p_device->getAllocationCallbacks());
+        throw std::runtime_error("Failed to create compute pipeline");
+    }
+}
+
+
+ComputePipeline::~ComputePipeline()
+{
+    const VkDevice device = _p_device->getDevice();
+    vkDestroyPipeline(device, _pipeline, _p_device->getAllocationCallbacks());
+    vkDestroyPipelineLayout(device, _layout, _p_device->getAllocationCallbacks());
+    vkDestroyDescriptorSetLayout(device, _descriptorSetLayout, _p_device->getAllocationCallbacks());
+}
+
+
+VkPipeline ComputePipeline::get() const noexcept
+{
+    return _pipeline;
+}
+
+
+VkPipelineLayout ComputePipeline::getLayout() const noexcept
+{
+    return _layout;
+}
+
+
+VkDescriptorSetLayout ComputePipeline::getDescriptorSetLayout() const noexcept
+{
+    return _descriptorSetLayout;
+}
+
+
+uint32_t ComputePipeline::getStorageBufferCount() const noexcept
+{
+    return _storageBufferCount;
+}
+
+
+uint32_t ComputePipeline::getPushConstantSize() const noexcept
+{
+    return _pushConstantSize;
+}
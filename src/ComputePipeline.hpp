@@ -0,0 +1,65 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "Shader.hpp"
+#include "LogicalDevice.hpp"
+#include "PipelineCache.hpp"
+
+// --- STL Includes ---
+#include <cstdint>
+#include <memory>
+
+
+/// @brief Compute pipeline whose shader reads and writes storage buffers.
+/// @details The layout has a single descriptor set with one storage buffer per binding,
+///          in [0, storage buffer count), and a single push constant range starting at 0.
+///          Both are visible to the compute stage only. Dispatches are recorded by
+///          @ref ComputeDispatcher.
+class ComputePipeline
+{
+public:
+    /// @param pushConstantSize size of the shader's push constant block [bytes], may be 0.
+    /// @param rp_cache cache to look up and store the compiled pipeline in, if any.
+    ComputePipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+                    const std::shared_ptr<ShaderIO>& rp_shaderIO,
+                    uint32_t storageBufferCount,
+                    uint32_t pushConstantSize,
+                    const std::shared_ptr<PipelineCache>& rp_cache = {});
+
+    ComputePipeline(const ComputePipeline&) = delete;
+
+    ~ComputePipeline();
+
+    /// @name Member Access
+    /// @{
+
+    VkPipeline get() const noexcept;
+
+    VkPipelineLayout getLayout() const noexcept;
+
+    VkDescriptorSetLayout getDescriptorSetLayout() const noexcept;
+
+    uint32_t getStorageBufferCount() const noexcept;
+
+    uint32_t getPushConstantSize() const noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    std::unique_ptr<Shader> _p_shader;
+
+    uint32_t _storageBufferCount;
+
+    uint32_t _pushConstantSize;
+
+    VkDescriptorSetLayout _descriptorSetLayout;
+
+    VkPipelineLayout _layout;
+
+    VkPipeline _pipeline;
+}; // class ComputePipeline
@@ -0,0 +1,331 @@
+// --- External Includes ---
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define VKTUTORIAL_CPU_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define VKTUTORIAL_CPU_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// --- Internal Includes ---
+#include "CpuKernels.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <stdexcept>
+
+
+namespace {
+
+
+void saxpyScalar(float a, const float* p_x, float* p_y, std::size_t count) noexcept
+{
+    for (std::size_t i=0; i<count; ++i) {
+        p_y[i] = a * p_x[i] + p_y[i];
+    }
+}
+
+
+float reduceScalar(const float* p_values, std::size_t count) noexcept
+{
+    float sum = 0.0f;
+    for (std::size_t i=0; i<count; ++i) {
+        sum += p_values[i];
+    }
+    return sum;
+}
+
+
+void scanScalar(float* p_values, std::size_t count) noexcept
+{
+    float sum = 0.0f;
+    for (std::size_t i=0; i<count; ++i) {
+        sum += p_values[i];
+        p_values[i] = sum;
+    }
+}
+
+
+#ifdef VKTUTORIAL_CPU_KERNELS_AVX2
+__attribute__((target("avx2,fma")))
+void saxpyAVX2(float a, const float* p_x, float* p_y, std::size_t count) noexcept
+{
+    const __m256 factor = _mm256_set1_ps(a);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(p_x + i);
+        const __m256 y = _mm256_loadu_ps(p_y + i);
+        _mm256_storeu_ps(p_y + i, _mm256_fmadd_ps(factor, x, y));
+    }
+    saxpyScalar(a, p_x + i, p_y + i, count - i);
+}
+
+
+__attribute__((target("avx2,fma")))
+float reduceAVX2(const float* p_values, std::size_t count) noexcept
+{
+    // Independent accumulators hide the latency of the additions
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(p_values + i));
+        sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(p_values + i + 8));
+        sum2 = _mm256_add_ps(sum2, _mm256_loadu_ps(p_values + i + 16));
+        sum3 = _mm256_add_ps(sum3, _mm256_loadu_ps(p_values + i + 24));
+    }
+    for (; i + 8 <= count; i += 8) {
+        sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(p_values + i));
+    }
+    const __m256 sum = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+
+    // Horizontal sum of the 8 lanes
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_movehdup_ps(half));
+    return _mm_cvtss_f32(half) + reduceScalar(p_values + i, count - i);
+}
+
+
+__attribute__((target("avx2,fma")))
+void scanAVX2(float* p_values, std::size_t count) noexcept
+{
+    __m256 carry = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(p_values + i);
+
+        // Scan within each 128 bit lane by adding copies shifted by 1 and 2 elements
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+        x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+
+        // Add the low lane's total to the high lane
+        const __m256 lowTotal = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+        x = _mm256_add_ps(x, _mm256_permute2f128_ps(lowTotal, lowTotal, 0x08));
+
+        // Add the total of all previous vectors
+        x = _mm256_add_ps(x, carry);
+        _mm256_storeu_ps(p_values + i, x);
+        carry = _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7));
+    }
+
+    if (i < count) {
+        p_values[i] += i ? p_values[i - 1] : 0.0f;
+        scanScalar(p_values + i, count - i);
+    }
+}
+
+
+bool hasAVX2() noexcept
+{
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return hasAVX2;
+}
+#endif
+
+
+#ifdef VKTUTORIAL_CPU_KERNELS_NEON
+void saxpyNEON(float a, const float* p_x, float* p_y, std::size_t count) noexcept
+{
+    const float32x4_t factor = vdupq_n_f32(a);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(p_y + i, vfmaq_f32(vld1q_f32(p_y + i), factor, vld1q_f32(p_x + i)));
+    }
+    saxpyScalar(a, p_x + i, p_y + i, count - i);
+}
+
+
+float reduceNEON(const float* p_values, std::size_t count) noexcept
+{
+    // Independent accumulators hide the latency of the additions
+    float32x4_t sum0 = vdupq_n_f32(0.0f);
+    float32x4_t sum1 = vdupq_n_f32(0.0f);
+    float32x4_t sum2 = vdupq_n_f32(0.0f);
+    float32x4_t sum3 = vdupq_n_f32(0.0f);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        sum0 = vaddq_f32(sum0, vld1q_f32(p_values + i));
+        sum1 = vaddq_f32(sum1, vld1q_f32(p_values + i + 4));
+        sum2 = vaddq_f32(sum2, vld1q_f32(p_values + i + 8));
+        sum3 = vaddq_f32(sum3, vld1q_f32(p_values + i + 12));
+    }
+    for (; i + 4 <= count; i += 4) {
+        sum0 = vaddq_f32(sum0, vld1q_f32(p_values + i));
+    }
+    const float32x4_t sum = vaddq_f32(vaddq_f32(sum0, sum1), vaddq_f32(sum2, sum3));
+    return vaddvq_f32(sum) + reduceScalar(p_values + i, count - i);
+}
+
+
+void scanNEON(float* p_values, std::size_t count) noexcept
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t carry = zero;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(p_values + i);
+
+        // Add copies shifted by 1 and 2 elements
+        x = vaddq_f32(x, vextq_f32(zero, x, 3));
+        x = vaddq_f32(x, vextq_f32(zero, x, 2));
+
+        // Add the total of all previous vectors
+        x = vaddq_f32(x, carry);
+        vst1q_f32(p_values + i, x);
+        carry = vdupq_laneq_f32(x, 3);
+    }
+
+    if (i < count) {
+        p_values[i] += i ? p_values[i - 1] : 0.0f;
+        scanScalar(p_values + i, count - i);
+    }
+}
+#endif
+
+
+void checkSupport(CpuKernels::InstructionSet instructionSet)
+{
+    if (!CpuKernels::isSupported(instructionSet)) {
+        throw std::runtime_error("Instruction set is not supported by this CPU or build");
+    }
+}
+
+
+} // unnamed namespace
+
+
+CpuKernels::InstructionSet CpuKernels::getInstructionSet() noexcept
+{
+    if (CpuKernels::isSupported(InstructionSet::AVX2)) {
+        return InstructionSet::AVX2;
+    } else if (CpuKernels::isSupported(InstructionSet::NEON)) {
+        return InstructionSet::NEON;
+    }
+    return InstructionSet::Scalar;
+}
+
+
+bool CpuKernels::isSupported(InstructionSet instructionSet) noexcept
+{
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return true;
+        case InstructionSet::AVX2:
+            #ifdef VKTUTORIAL_CPU_KERNELS_AVX2
+            return hasAVX2();
+            #else
+            return false;
+            #endif
+        case InstructionSet::NEON:
+            #ifdef VKTUTORIAL_CPU_KERNELS_NEON
+            return true;
+            #else
+            return false;
+            #endif
+    }
+    return false;
+}
+
+
+std::string_view CpuKernels::getName(InstructionSet instructionSet) noexcept
+{
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return "scalar";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::NEON:
+            return "NEON";
+    }
+    return "unknown";
+}
+
+
+void CpuKernels::saxpy(float a,
+                       std::span<const float> x,
+                       std::span<float> y)
+{
+    CpuKernels::saxpy(a, x, y, CpuKernels::getInstructionSet());
+}
+
+
+void CpuKernels::saxpy(float a,
+                       std::span<const float> x,
+                       std::span<float> y,
+                       InstructionSet instructionSet)
+{
+    checkSupport(instructionSet);
+    if (x.size() < y.size()) {
+        throw std::runtime_error("saxpy requires at least as many x values as y values");
+    }
+
+    switch (instructionSet) {
+        #ifdef VKTUTORIAL_CPU_KERNELS_AVX2
+        case InstructionSet::AVX2:
+            return saxpyAVX2(a, x.data(), y.data(), y.size());
+        #endif
+        #ifdef VKTUTORIAL_CPU_KERNELS_NEON
+        case InstructionSet::NEON:
+            return saxpyNEON(a, x.data(), y.data(), y.size());
+        #endif
+        default:
+            return saxpyScalar(a, x.data(), y.data(), y.size());
+    }
+}
+
+
+float CpuKernels::reduce(std::span<const float> values)
+{
+    return CpuKernels::reduce(values, CpuKernels::getInstructionSet());
+}
+
+
+float CpuKernels::reduce(std::span<const float> values,
+                         InstructionSet instructionSet)
+{
+    checkSupport(instructionSet);
+
+    switch (instructionSet) {
+        #ifdef VKTUTORIAL_CPU_KERNELS_AVX2
+        case InstructionSet::AVX2:
+            return reduceAVX2(values.data(), values.size());
+        #endif
+        #ifdef VKTUTORIAL_CPU_KERNELS_NEON
+        case InstructionSet::NEON:
+            return reduceNEON(values.data(), values.size());
+        #endif
+        default:
+            return reduceScalar(values.data(), values.size());
+    }
+}
+
+
+void CpuKernels::scan(std::span<float> values)
+{
+    CpuKernels::scan(values, CpuKernels::getInstructionSet());
+}
+
+
+void CpuKernels::scan(std::span<float> values,
+                      InstructionSet instructionSet)
+{
+    checkSupport(instructionSet);
+
+    switch (instructionSet) {
+        #ifdef VKTUTORIAL_CPU_KERNELS_AVX2
+        case InstructionSet::AVX2:
+            return scanAVX2(values.data(), values.size());
+        #endif
+        #ifdef VKTUTORIAL_CPU_KERNELS_NEON
+        case InstructionSet::NEON:
+            return scanNEON(values.data(), values.size());
+        #endif
+        default:
+            return scanScalar(values.data(), values.size());
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// --- STL Includes ---
+#include <span>
+#include <string_view>
+
+
+/// @brief Reference implementations of the kernels in @ref ComputeKernels, vectorized on the CPU.
+/// @details Every kernel has a scalar version, an AVX2 version on x86-64 and a NEON version
+///          on AArch64. The AVX2 versions are compiled for that instruction set regardless
+///          of the build's target, and only picked if the CPU supports them at runtime,
+///          so binaries still run on older x86-64 CPUs.
+///
+///          The vectorized versions add the values in a different order than the scalar
+///          ones, so results only agree up to rounding.
+class CpuKernels
+{
+public:
+    enum class InstructionSet
+    {
+        Scalar,
+        AVX2,
+        NEON
+    }; // enum class InstructionSet
+
+public:
+    /// @brief Get the fastest instruction set the CPU supports.
+    static InstructionSet getInstructionSet() noexcept;
+
+    static bool isSupported(InstructionSet instructionSet) noexcept;
+
+    static std::string_view getName(InstructionSet instructionSet) noexcept;
+
+    /// @name Kernels
+    /// @details Overloads without an @ref InstructionSet use @ref getInstructionSet.
+    ///          Requesting an unsupported instruction set throws.
+    /// @{
+
+    /// @brief y = a * x + y, for as many values as @a r_y has.
+    static void saxpy(float a,
+                      std::span<const float> x,
+                      std::span<float> y);
+
+    static void saxpy(float a,
+                      std::span<const float> x,
+                      std::span<float> y,
+                      InstructionSet instructionSet);
+
+    /// @brief Get the sum of all values.
+    static float reduce(std::span<const float> values);
+
+    static float reduce(std::span<const float> values,
+                        InstructionSet instructionSet);
+
+    /// @brief Replace the values with their inclusive prefix sums.
+    static void scan(std::span<float> values);
+
+    static void scan(std::span<float> values,
+                     InstructionSet instructionSet);
+
+    /// @}
+}; // class CpuKernels
@@ -6,8 +6,14 @@ DebugMessenger::DebugMessenger(const std::shared_ptr<VulkanInstance>& rp_vulkanI
                                const VkDebugUtilsMessengerCreateInfoEXT& r_constructProperties,
                                const std::optional<VkAllocationCallbacks>& r_allocator)
     : _p_vulkanInstance(rp_vulkanInstance),
+      _p_performanceWarnings(),
       _allocator(r_allocator)
 {
+    // Default to the allocator of the instance
+    if (!_allocator.has_value() && _p_vulkanInstance->getAllocationCallbacks()) {
+        _allocator.emplace(*_p_vulkanInstance->getAllocationCallbacks());
+    }
+
     auto function = (PFN_vkCreateDebugUtilsMessengerEXT) vkGetInstanceProcAddr(_p_vulkanInstance->get(), "vkCreateDebugUtilsMessengerEXT");
     if (function != nullptr) {
         const VkAllocationCallbacks* p_allocator = _allocator.has_value() ? &_allocator.value() : nullptr;
@@ -18,6 +24,22 @@ DebugMessenger::DebugMessenger(const std::shared_ptr<VulkanInstance>& rp_vulkanI
 }
 
 
+DebugMessenger::DebugMessenger(const std::shared_ptr<VulkanInstance>& rp_vulkanInstance,
+                               const VkDebugUtilsMessengerCreateInfoEXT& r_constructProperties,
+                               const std::shared_ptr<PerformanceWarnings>& rp_performanceWarnings,
+                               const std::optional<VkAllocationCallbacks>& r_allocator)
+    : DebugMessenger(rp_vulkanInstance,
+                     [&r_constructProperties, &rp_performanceWarnings]() {
+                         VkDebugUtilsMessengerCreateInfoEXT properties = r_constructProperties;
+                         properties.pUserData = rp_performanceWarnings.get();
+                         return properties;
+                     }(),
+                     r_allocator)
+{
+    _p_performanceWarnings = rp_performanceWarnings;
+}
+
+
 DebugMessenger::~DebugMessenger()
 {
     auto func = (PFN_vkDestroyDebugUtilsMessengerEXT) vkGetInstanceProcAddr(_p_vulkanInstance->get(), "vkDestroyDebugUtilsMessengerEXT");
@@ -26,3 +48,21 @@ DebugMessenger::~DebugMessenger()
         func(_p_vulkanInstance->get(), _messenger, p_allocator);
     }
 }
+
+
+VkDebugUtilsMessengerEXT& DebugMessenger::get()
+{
+    return _messenger;
+}
+
+
+const VkDebugUtilsMessengerEXT& DebugMessenger::get() const
+{
+    return _messenger;
+}
+
+
+const std::shared_ptr<PerformanceWarnings>& DebugMessenger::getPerformanceWarnings() const noexcept
+{
+    return _p_performanceWarnings;
+}
@@ -5,6 +5,7 @@
 
 // --- Internal Includes ---
 #include "VulkanInstance.hpp"
+#include "PerformanceWarnings.hpp"
 
 // --- STL Includes ---
 #include <memory>
@@ -14,10 +15,19 @@
 class DebugMessenger
 {
 public:
+    /// @param r_allocator host allocator of the messenger; defaults to the instance's.
     DebugMessenger(const std::shared_ptr<VulkanInstance>& rp_vulkanInstance,
                    const VkDebugUtilsMessengerCreateInfoEXT& p_constructProperties,
                    const std::optional<VkAllocationCallbacks>& r_allocator = {});
 
+    /// @brief Create a messenger that collects performance warnings.
+    /// @details @a rp_performanceWarnings is passed to the callback as @a pUserData, replacing
+    ///          whatever the create info specified, and is kept alive as long as the messenger.
+    DebugMessenger(const std::shared_ptr<VulkanInstance>& rp_vulkanInstance,
+                   const VkDebugUtilsMessengerCreateInfoEXT& r_constructProperties,
+                   const std::shared_ptr<PerformanceWarnings>& rp_performanceWarnings,
+                   const std::optional<VkAllocationCallbacks>& r_allocator = {});
+
     DebugMessenger(const DebugMessenger&) = delete;
 
     ~DebugMessenger();
@@ -26,9 +36,14 @@ public:
 
     const VkDebugUtilsMessengerEXT& get() const;
 
+    /// @brief Get the collected performance warnings, or nullptr if they aren't collected.
+    const std::shared_ptr<PerformanceWarnings>& getPerformanceWarnings() const noexcept;
+
 private:
     std::shared_ptr<VulkanInstance> _p_vulkanInstance;
 
+    std::shared_ptr<PerformanceWarnings> _p_performanceWarnings;
+
     std::optional<VkAllocationCallbacks> _allocator;
 
     VkDebugUtilsMessengerEXT _messenger;
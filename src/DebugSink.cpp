@@ -0,0 +1,358 @@
+// --- Internal Includes ---
+#include "DebugSink.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Number of distinct message IDs that can be counted; others are never deduplicated.
+constexpr std::size_t counterCount = 4096;
+
+
+static_assert(counterCount == (std::size_t(1) << 12), "DebugSink::count hashes keys to 12 bits");
+
+
+constexpr std::size_t maxIdNameLength = 128;
+
+
+/// @brief Identify a message by its ID number, or by a hash of its text if it has none.
+/// @return a nonzero key; the two kinds of keys never collide.
+uint64_t makeKey(const VkDebugUtilsMessengerCallbackDataEXT* p_data) noexcept
+{
+    if (p_data->messageIdNumber != 0) {
+        return (uint64_t(1) << 63) | static_cast<uint32_t>(p_data->messageIdNumber);
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char* p_char=p_data->pMessage; p_char && *p_char; ++p_char) {
+        hash = (hash ^ static_cast<unsigned char>(*p_char)) * 16777619u;
+    }
+    return (uint64_t(1) << 62) | hash;
+}
+
+
+/// @brief Copy a null terminated string, truncating it to fit.
+void copyString(char* p_target, std::size_t capacity, const char* p_source) noexcept
+{
+    std::size_t length = 0;
+    if (p_source) {
+        for (; length + 1 < capacity && p_source[length]; ++length) {
+            p_target[length] = p_source[length];
+        }
+    }
+    p_target[length] = '\0';
+}
+
+
+void writeTags(std::ostream& r_stream,
+               VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+               VkDebugUtilsMessageTypeFlagsEXT type)
+{
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT)
+        r_stream << " [VERBOSE]";
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
+        r_stream << " [INFO]";
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+        r_stream << " [WARNING]";
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+        r_stream << " [ERROR]";
+
+    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT)
+        r_stream << " (GENERAL)";
+    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT)
+        r_stream << " (VALIDATION)";
+    if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
+        r_stream << " (PERFORMANCE)";
+}
+
+
+} // unnamed namespace
+
+
+struct DebugSink::Slot
+{
+    /// @brief Ring position the slot is free for, or that position + 1 once a message was published in it.
+    std::atomic<std::size_t> sequence;
+
+    const char* p_source;
+
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity;
+
+    VkDebugUtilsMessageTypeFlagsEXT type;
+
+    uint64_t key;
+
+    char idName[maxIdNameLength];
+
+    char message[maxMessageLength];
+}; // struct DebugSink::Slot
+
+
+struct DebugSink::Counter
+{
+    /// @brief Message ID counted here, 0 if the counter is unused.
+    std::atomic<uint64_t> key;
+
+    std::atomic<std::size_t> count;
+}; // struct DebugSink::Counter
+
+
+DebugSink::DebugSink()
+    : DebugSink(std::cerr, Settings())
+{
+}
+
+
+DebugSink::DebugSink(std::ostream& r_stream,
+                     const Settings& r_settings)
+    : _p_stream(&r_stream),
+      _settings(r_settings),
+      _severities(r_settings.severities),
+      _types(r_settings.types),
+      _slots(),
+      _mask(std::bit_ceil(std::max<std::size_t>(r_settings.capacity, 2)) - 1),
+      _head(0),
+      _tail(0),
+      _counters(std::make_unique<Counter[]>(counterCount)),
+      _receivedCount(0),
+      _filteredCount(0),
+      _duplicateCount(0),
+      _overflowCount(0),
+      _writtenCount(0),
+      _names(),
+      _mutex(),
+      _condition(),
+      _stop(false),
+      _isFlushRequested(false),
+      _drainedPosition(0),
+      _worker()
+{
+    _slots = std::make_unique<Slot[]>(_mask + 1);
+    for (std::size_t i_slot=0; i_slot<=_mask; ++i_slot) {
+        _slots[i_slot].sequence.store(i_slot, std::memory_order_relaxed);
+    }
+
+    _worker = std::thread(&DebugSink::work, this);
+}
+
+
+DebugSink::~DebugSink()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_all();
+    _worker.join();
+
+    // Summarize the repeats that weren't written
+    std::vector<std::pair<uint64_t,std::size_t>> repeats;
+    for (std::size_t i_counter=0; i_counter<counterCount; ++i_counter) {
+        const uint64_t key = _counters[i_counter].key.load(std::memory_order_relaxed);
+        const std::size_t count = _counters[i_counter].count.load(std::memory_order_relaxed);
+        if (key && _settings.maxRepeats < count) {
+            repeats.emplace_back(key, count);
+        }
+    }
+    std::sort(repeats.begin(),
+              repeats.end(),
+              [](const auto& r_left, const auto& r_right) {return r_right.second < r_left.second;});
+
+    for (const auto& [key, count] : repeats) {
+        *_p_stream << "DebugSink: ";
+        const auto it_name = _names.find(key);
+        if (it_name != _names.end() && !it_name->second.empty()) {
+            *_p_stream << it_name->second;
+        } else {
+            *_p_stream << "message 0x" << std::hex << static_cast<uint32_t>(key) << std::dec;
+        }
+        *_p_stream << " occurred " << count << " times, "
+                   << count - _settings.maxRepeats << " repeats dropped\n";
+    }
+    _p_stream->flush();
+}
+
+
+void DebugSink::submit(const char* p_source,
+                       VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                       VkDebugUtilsMessageTypeFlagsEXT type,
+                       const VkDebugUtilsMessengerCallbackDataEXT* p_data) noexcept
+{
+    _receivedCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (!(severity & _severities.load(std::memory_order_relaxed))
+        || !(type & _types.load(std::memory_order_relaxed))) {
+        _filteredCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint64_t key = makeKey(p_data);
+    if (_settings.maxRepeats && _settings.maxRepeats < this->count(key)) {
+        _duplicateCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Claim a slot (bounded queue after D. Vyukov); never wait for the consumer
+    std::size_t position = _head.load(std::memory_order_relaxed);
+    Slot* p_slot = nullptr;
+    while (true) {
+        p_slot = &_slots[position & _mask];
+        const std::size_t sequence = p_slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            _overflowCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = _head.load(std::memory_order_relaxed);
+        }
+    }
+
+    p_slot->p_source = p_source;
+    p_slot->severity = severity;
+    p_slot->type = type;
+    p_slot->key = key;
+    copyString(p_slot->idName, maxIdNameLength, p_data->pMessageIdName);
+    copyString(p_slot->message, maxMessageLength, p_data->pMessage);
+    p_slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+
+void DebugSink::flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    const std::size_t target = _head.load(std::memory_order_acquire);
+    _isFlushRequested = true;
+    _condition.notify_all();
+    _condition.wait(lock, [this, target]() {return _stop || target <= _drainedPosition;});
+}
+
+
+void DebugSink::setSeverities(VkDebugUtilsMessageSeverityFlagsEXT severities) noexcept
+{
+    _severities.store(severities, std::memory_order_relaxed);
+}
+
+
+VkDebugUtilsMessageSeverityFlagsEXT DebugSink::getSeverities() const noexcept
+{
+    return _severities.load(std::memory_order_relaxed);
+}
+
+
+void DebugSink::setTypes(VkDebugUtilsMessageTypeFlagsEXT types) noexcept
+{
+    _types.store(types, std::memory_order_relaxed);
+}
+
+
+VkDebugUtilsMessageTypeFlagsEXT DebugSink::getTypes() const noexcept
+{
+    return _types.load(std::memory_order_relaxed);
+}
+
+
+DebugSink::Statistics DebugSink::getStatistics() const noexcept
+{
+    Statistics statistics;
+    statistics.receivedCount = _receivedCount.load(std::memory_order_relaxed);
+    statistics.filteredCount = _filteredCount.load(std::memory_order_relaxed);
+    statistics.duplicateCount = _duplicateCount.load(std::memory_order_relaxed);
+    statistics.overflowCount = _overflowCount.load(std::memory_order_relaxed);
+    statistics.writtenCount = _writtenCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
+DebugSink& DebugSink::getDefault()
+{
+    static DebugSink sink;
+    return sink;
+}
+
+
+std::size_t DebugSink::count(uint64_t key) noexcept
+{
+    // Linear probing; counters are never removed, so a key's counter never moves
+    std::size_t i_counter = (key * 0x9e3779b97f4a7c15ull) >> 52;
+    for (std::size_t i_probe=0; i_probe<counterCount; ++i_probe) {
+        Counter& r_counter = _counters[i_counter];
+        uint64_t current = r_counter.key.load(std::memory_order_acquire);
+        if (current == 0 && r_counter.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+            current = key;
+        }
+        if (current == key) {
+            return r_counter.count.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+        i_counter = (i_counter + 1) % counterCount;
+    }
+
+    // Out of counters: let the message through
+    return 1;
+}
+
+
+void DebugSink::drain()
+{
+    std::size_t writtenCount = 0;
+    while (true) {
+        Slot& r_slot = _slots[_tail & _mask];
+        if (r_slot.sequence.load(std::memory_order_acquire) != _tail + 1) {
+            break;
+        }
+
+        *_p_stream << r_slot.p_source;
+        writeTags(*_p_stream, r_slot.severity, r_slot.type);
+        *_p_stream << ": " << r_slot.message << '\n';
+
+        if (_names.find(r_slot.key) == _names.end()) {
+            _names.emplace(r_slot.key, r_slot.idName);
+        }
+
+        // Hand the slot back to the producers for the next lap
+        r_slot.sequence.store(_tail + _mask + 1, std::memory_order_release);
+        ++_tail;
+        ++writtenCount;
+    }
+
+    if (writtenCount) {
+        _p_stream->flush();
+        _writtenCount.fetch_add(writtenCount, std::memory_order_relaxed);
+    }
+}
+
+
+void DebugSink::work()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _condition.wait_for(lock,
+                            _settings.drainInterval,
+                            [this]() {return _stop || _isFlushRequested;});
+        const bool stop = _stop;
+        _isFlushRequested = false;
+
+        lock.unlock();
+        this->drain();
+        lock.lock();
+
+        _drainedPosition = _tail;
+        _condition.notify_all();
+
+        if (stop) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- STL Includes ---
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+
+/// @brief Collects debug messenger messages without blocking the threads that report them.
+/// @details Validation layers and drivers call the messenger callback from whichever thread
+///          made the offending Vulkan call. @ref submit only does the following on that thread:
+///          - checks the message against the severity and type filters (relaxed atomic loads)
+///          - counts occurrences of its ID in a lock-free hash table, and drops repeats
+///          - copies it into a bounded lock-free multi producer, single consumer ring
+///
+///          A background thread drains the ring into the output stream, flushing once per
+///          batch instead of once per message. If the ring is full, messages are dropped and
+///          counted rather than waited for.
+///
+///          Messages are identified by their @a messageIdNumber, or by a hash of their text if
+///          they have none (e.g. loader messages). Once an ID got through @ref Settings::maxRepeats
+///          times, further occurrences are only counted, and summarized on destruction.
+class DebugSink
+{
+public:
+    struct Settings
+    {
+        /// @brief Severities that get through; can be changed at runtime with @ref setSeverities.
+        VkDebugUtilsMessageSeverityFlagsEXT severities = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
+                                                         | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+
+        /// @brief Types that get through; can be changed at runtime with @ref setTypes.
+        VkDebugUtilsMessageTypeFlagsEXT types = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT
+                                                | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
+                                                | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+
+        /// @brief Number of messages the ring holds, rounded up to a power of 2.
+        std::size_t capacity = 1024;
+
+        /// @brief Number of occurrences of each message ID that get through; 0 disables deduplication.
+        std::size_t maxRepeats = 1;
+
+        /// @brief Time between two drains of the ring.
+        std::chrono::milliseconds drainInterval {10};
+    }; // struct Settings
+
+    struct Statistics
+    {
+        /// @brief Number of messages passed to @ref submit.
+        std::size_t receivedCount = 0;
+
+        /// @brief Number of messages dropped by the severity and type filters.
+        std::size_t filteredCount = 0;
+
+        /// @brief Number of messages dropped as repeats of an ID.
+        std::size_t duplicateCount = 0;
+
+        /// @brief Number of messages dropped because the ring was full.
+        std::size_t overflowCount = 0;
+
+        /// @brief Number of messages written to the stream.
+        std::size_t writtenCount = 0;
+    }; // struct Statistics
+
+    /// @brief Messages are truncated to this many bytes, including the terminating null.
+    static constexpr std::size_t maxMessageLength = 2048;
+
+public:
+    /// @brief Write to @a std::cerr with default settings.
+    DebugSink();
+
+    DebugSink(std::ostream& r_stream,
+              const Settings& r_settings);
+
+    DebugSink(const DebugSink&) = delete;
+
+    /// @brief Drain the remaining messages and summarize the dropped repeats.
+    ~DebugSink();
+
+    /// @brief Queue a message for output, unless it's filtered or a repeat.
+    /// @details Lock-free and never blocks; meant to be called from messenger callbacks.
+    /// @param p_source label printed before the message; must outlive the sink (e.g. a literal).
+    void submit(const char* p_source,
+                VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                VkDebugUtilsMessageTypeFlagsEXT type,
+                const VkDebugUtilsMessengerCallbackDataEXT* p_data) noexcept;
+
+    /// @brief Block until every message queued before the call was written.
+    void flush();
+
+    /// @name Filters
+    /// @{
+
+    void setSeverities(VkDebugUtilsMessageSeverityFlagsEXT severities) noexcept;
+
+    VkDebugUtilsMessageSeverityFlagsEXT getSeverities() const noexcept;
+
+    void setTypes(VkDebugUtilsMessageTypeFlagsEXT types) noexcept;
+
+    VkDebugUtilsMessageTypeFlagsEXT getTypes() const noexcept;
+
+    /// @}
+
+    Statistics getStatistics() const noexcept;
+
+    /// @brief Sink shared by the messenger callbacks of the whole process.
+    /// @details Constructed on first use. Statics are destroyed in reverse order of construction,
+    ///          so the sink is destroyed before every static constructed before it; statics that
+    ///          submit messages in their destructors must call this before they are constructed.
+    static DebugSink& getDefault();
+
+private:
+    struct Slot;
+
+    struct Counter;
+
+    /// @brief Count an occurrence of a message ID.
+    /// @return the number of occurrences so far, including this one.
+    std::size_t count(uint64_t key) noexcept;
+
+    /// @brief Write all published messages to the stream; consumer thread only.
+    void drain();
+
+    void work();
+
+private:
+    std::ostream* _p_stream;
+
+    Settings _settings;
+
+    std::atomic<VkDebugUtilsMessageSeverityFlagsEXT> _severities;
+
+    std::atomic<VkDebugUtilsMessageTypeFlagsEXT> _types;
+
+    std::unique_ptr<Slot[]> _slots;
+
+    std::size_t _mask;
+
+    /// @brief Next ring position producers claim.
+    std::atomic<std::size_t> _head;
+
+    /// @brief Next ring position the consumer reads.
+    std::size_t _tail;
+
+    /// @brief Open addressing table of occurrence counts by message ID.
+    std::unique_ptr<Counter[]> _counters;
+
+    /// @name Statistics
+    /// @{
+
+    std::atomic<std::size_t> _receivedCount;
+
+    std::atomic<std::size_t> _filteredCount;
+
+    std::atomic<std::size_t> _duplicateCount;
+
+    std::atomic<std::size_t> _overflowCount;
+
+    std::atomic<std::size_t> _writtenCount;
+
+    /// @}
+
+    /// @brief Names of the message IDs written so far, for the summary; consumer thread only.
+    std::unordered_map<uint64_t,std::string> _names;
+
+    /// @brief Guards the members below, which synchronize @ref flush with the consumer.
+    std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    bool _stop;
+
+    bool _isFlushRequested;
+
+    /// @brief Ring position up to which all messages were written.
+    std::size_t _drainedPosition;
+
+    std::thread _worker;
+}; // class DebugSink
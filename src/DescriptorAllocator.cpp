@@ -0,0 +1,143 @@
+// --- Internal Includes ---
+#include "DescriptorAllocator.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+
+DescriptorAllocator::DescriptorAllocator(const std::shared_ptr<LogicalDevice>& rp_device,
+                                         std::size_t framesInFlight)
+    : DescriptorAllocator(rp_device, framesInFlight, Settings())
+{
+}
+
+
+DescriptorAllocator::DescriptorAllocator(const std::shared_ptr<LogicalDevice>& rp_device,
+                                         std::size_t framesInFlight,
+                                         const Settings& r_settings)
+    : _p_device(rp_device),
+      _device(rp_device->getDevice()),
+      _settings(r_settings),
+      _poolSizes(),
+      _frames(framesInFlight),
+      _i_frame(0),
+      _statistics()
+{
+    if (framesInFlight == 0) {
+        throw std::runtime_error("Descriptor allocator requires at least one frame in flight");
+    }
+
+    if (_settings.setsPerPool == 0) {
+        throw std::runtime_error("Descriptor pools must hold at least one set");
+    }
+
+    for (const auto& [type, ratio] : _settings.descriptorsPerSet) {
+        const uint32_t count = static_cast<uint32_t>(std::ceil(ratio * _settings.setsPerPool));
+        if (count) {
+            _poolSizes.push_back({type, count});
+        }
+    }
+}
+
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    for (Frame& r_frame : _frames) {
+        for (VkDescriptorPool pool : r_frame.pools) {
+            vkDestroyDescriptorPool(_device, pool, _p_device->getAllocationCallbacks());
+        }
+    }
+}
+
+
+void DescriptorAllocator::beginFrame()
+{
+    _i_frame = (_i_frame + 1) % _frames.size();
+    Frame& r_frame = _frames[_i_frame];
+
+    // Only pools that sets were allocated from need resetting
+    const std::size_t usedPoolCount = std::min(r_frame.i_pool + 1, r_frame.pools.size());
+    for (std::size_t i_pool=0; i_pool<usedPoolCount; ++i_pool) {
+        vkResetDescriptorPool(_device, r_frame.pools[i_pool], 0);
+        ++_statistics.resetCount;
+    }
+    r_frame.i_pool = 0;
+}
+
+
+VkDescriptorSet DescriptorAllocator::allocate(VkDescriptorSetLayout layout)
+{
+    VkDescriptorSet set;
+    this->allocate({&layout, 1}, {&set, 1});
+    return set;
+}
+
+
+void DescriptorAllocator::allocate(std::span<const VkDescriptorSetLayout> layouts,
+                                   std::span<VkDescriptorSet> sets)
+{
+    if (sets.size() < layouts.size()) {
+        throw std::runtime_error("Not enough room for the requested descriptor sets");
+    }
+
+    Frame& r_frame = _frames[_i_frame];
+
+    VkDescriptorSetAllocateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    info.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    info.pSetLayouts = layouts.data();
+
+    // Move on to the next pool if the current one is exhausted, but only once,
+    // since a fresh pool failing as well means the request can't be satisfied.
+    for (bool isFreshPool=false; true; isFreshPool=true) {
+        if (r_frame.pools.size() <= r_frame.i_pool) {
+            r_frame.pools.push_back(this->makePool());
+        }
+
+        info.descriptorPool = r_frame.pools[r_frame.i_pool];
+        const VkResult result = vkAllocateDescriptorSets(_device, &info, sets.data());
+        if (result == VK_SUCCESS) {
+            _statistics.setCount += layouts.size();
+            return;
+        }
+
+        if (isFreshPool || (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)) {
+            throw std::runtime_error("Failed to allocate descriptor sets");
+        }
+        ++r_frame.i_pool;
+    }
+}
+
+
+std::size_t DescriptorAllocator::getFramesInFlight() const noexcept
+{
+    return _frames.size();
+}
+
+
+const DescriptorAllocator::Statistics& DescriptorAllocator::getStatistics() const noexcept
+{
+    return _statistics;
+}
+
+
+VkDescriptorPool DescriptorAllocator::makePool()
+{
+    // Sets are never freed individually, so the pool doesn't need
+    // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT.
+    VkDescriptorPoolCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    info.maxSets = _settings.setsPerPool;
+    info.poolSizeCount = static_cast<uint32_t>(_poolSizes.size());
+    info.pPoolSizes = _poolSizes.data();
+
+    VkDescriptorPool pool;
+    if (vkCreateDescriptorPool(_device, &info, _p_device->getAllocationCallbacks(), &pool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor pool");
+    }
+
+    ++_statistics.poolCount;
+    return pool;
+}
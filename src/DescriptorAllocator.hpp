@@ -0,0 +1,109 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+/// @brief Allocates descriptor sets that live for a single frame.
+/// @details Every frame in flight gets a growable list of @a VkDescriptorPools. Sets are
+///          allocated linearly from the frame's current pool, and a new pool is added when
+///          it runs out. Instead of freeing sets one by one, @ref beginFrame releases all
+///          sets of the next frame slot at once with @a vkResetDescriptorPool.
+/// @note Not thread safe.
+class DescriptorAllocator
+{
+public:
+    struct Settings
+    {
+        /// @brief Maximum number of sets per pool.
+        uint32_t setsPerPool = 1024;
+
+        /// @brief Number of descriptors of each type per set, on average.
+        std::vector<std::pair<VkDescriptorType,float>> descriptorsPerSet {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2.0f},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.0f},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1.0f},
+            {VK_DESCRIPTOR_TYPE_SAMPLER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f}
+        };
+    }; // struct Settings
+
+    struct Statistics
+    {
+        /// @brief Number of sets allocated since construction.
+        std::size_t setCount = 0;
+
+        /// @brief Number of pools across all frame slots.
+        std::size_t poolCount = 0;
+
+        /// @brief Number of @a vkResetDescriptorPool calls.
+        std::size_t resetCount = 0;
+    }; // struct Statistics
+
+public:
+    DescriptorAllocator(const std::shared_ptr<LogicalDevice>& rp_device,
+                        std::size_t framesInFlight);
+
+    DescriptorAllocator(const std::shared_ptr<LogicalDevice>& rp_device,
+                        std::size_t framesInFlight,
+                        const Settings& r_settings);
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+
+    ~DescriptorAllocator();
+
+    /// @brief Move on to the next frame slot and release all sets allocated in it.
+    /// @details The caller must make sure the device is done with the slot's previous frame,
+    ///          for example by calling this from a @ref FrameLoop::Recorder of a loop with the
+    ///          same number of frames in flight.
+    void beginFrame();
+
+    /// @brief Allocate a set that stays valid until its frame slot comes around again.
+    VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+    /// @brief Allocate a set for each layout.
+    void allocate(std::span<const VkDescriptorSetLayout> layouts,
+                  std::span<VkDescriptorSet> sets);
+
+    std::size_t getFramesInFlight() const noexcept;
+
+    const Statistics& getStatistics() const noexcept;
+
+private:
+    struct Frame
+    {
+        std::vector<VkDescriptorPool> pools;
+
+        /// @brief Index of the pool sets are currently allocated from.
+        std::size_t i_pool;
+    }; // struct Frame
+
+    VkDescriptorPool makePool();
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkDevice _device;
+
+    Settings _settings;
+
+    std::vector<VkDescriptorPoolSize> _poolSizes;
+
+    std::vector<Frame> _frames;
+
+    std::size_t _i_frame;
+
+    Statistics _statistics;
+}; // class DescriptorAllocator
@@ -0,0 +1,669 @@
+// --- Internal Includes ---
+#include "DeviceAllocator.hpp"
+
+// --- STL Includes ---
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+
+namespace {
+
+
+constexpr uint32_t null = std::numeric_limits<uint32_t>::max();
+
+
+/// @brief Every allocation's size and offset is a multiple of this [bytes].
+constexpr VkDeviceSize granule = 16;
+
+
+constexpr VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) noexcept
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+
+} // unnamed namespace
+
+
+/// @brief TLSF free list over all blocks of a single memory type and resource kind.
+/// @details Free ranges are binned by the position of their most significant bit (first
+///          level) and a linear subdivision below it (second level). Bitmaps of non-empty
+///          bins make finding a suitable range two bit scans. Ranges are nodes in a doubly
+///          linked list of physical neighbours within their block, so freed ranges can be
+///          merged with their neighbours in constant time.
+class DeviceAllocator::Pool
+{
+public:
+    Pool(DeviceAllocator& r_allocator,
+         uint32_t memoryType,
+         VkDeviceSize blockSize)
+        : _r_allocator(r_allocator),
+          _memoryType(memoryType),
+          _blockSize(blockSize),
+          _isHostVisible(r_allocator._memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
+          _firstLevelBitmap(0),
+          _secondLevelBitmaps(),
+          _heads(),
+          _nodes(),
+          _spareNodes(),
+          _blocks(),
+          _blockCount(0),
+          _allocationCount(0),
+          _usedBytes(0)
+    {
+        _secondLevelBitmaps.fill(0);
+        for (auto& r_heads : _heads) {
+            r_heads.fill(null);
+        }
+    }
+
+    ~Pool()
+    {
+        for (const Block& r_block : _blocks) {
+            if (r_block.memory != VK_NULL_HANDLE) {
+                _r_allocator.freeMemory(r_block.memory);
+            }
+        }
+    }
+
+    /// @return null if no free range is large enough and a new block couldn't be added.
+    uint32_t allocate(VkDeviceSize size, VkDeviceSize alignment)
+    {
+        size = alignUp(std::max(size, granule), granule);
+        alignment = std::max(alignment, granule);
+
+        // Make sure any range found can fit the size after aligning its offset
+        const VkDeviceSize searchSize = size + alignment - granule;
+
+        uint32_t i_node = this->findFree(searchSize);
+        if (i_node == null) {
+            this->addBlock(std::max(_blockSize, alignUp(searchSize, granule)));
+            i_node = this->findFree(searchSize);
+            if (i_node == null) {
+                return null;
+            }
+        }
+        this->removeFree(i_node);
+
+        // Split off the front of the range if its offset isn't aligned
+        const VkDeviceSize padding = alignUp(_nodes[i_node].offset, alignment) - _nodes[i_node].offset;
+        if (padding) {
+            const uint32_t i_front = this->makeNode();
+            Node& r_front = _nodes[i_front];
+            Node& r_node = _nodes[i_node];
+            r_front.offset = r_node.offset;
+            r_front.size = padding;
+            r_front.block = r_node.block;
+            this->linkBefore(i_front, i_node);
+            r_node.offset += padding;
+            r_node.size -= padding;
+            this->insertFree(i_front);
+        }
+
+        // Give back what's left after the allocation
+        if (granule <= _nodes[i_node].size - size) {
+            const uint32_t i_back = this->makeNode();
+            Node& r_back = _nodes[i_back];
+            Node& r_node = _nodes[i_node];
+            r_back.offset = r_node.offset + size;
+            r_back.size = r_node.size - size;
+            r_back.block = r_node.block;
+            this->linkAfter(i_back, i_node);
+            r_node.size = size;
+            this->insertFree(i_back);
+        }
+
+        _nodes[i_node].isFree = false;
+        ++_allocationCount;
+        _usedBytes += _nodes[i_node].size;
+        return i_node;
+    }
+
+    void free(uint32_t i_node)
+    {
+        --_allocationCount;
+        _usedBytes -= _nodes[i_node].size;
+        _nodes[i_node].isFree = true;
+
+        // Merge with free neighbours
+        const uint32_t i_next = _nodes[i_node].nextPhysical;
+        if (i_next != null && _nodes[i_next].isFree) {
+            this->removeFree(i_next);
+            _nodes[i_node].size += _nodes[i_next].size;
+            this->unlink(i_next);
+        }
+
+        const uint32_t i_previous = _nodes[i_node].previousPhysical;
+        if (i_previous != null && _nodes[i_previous].isFree) {
+            this->removeFree(i_previous);
+            _nodes[i_previous].size += _nodes[i_node].size;
+            this->unlink(i_node);
+            i_node = i_previous;
+        }
+
+        // Release blocks that became empty, but keep the last one around
+        // to avoid thrashing when a single allocation comes and goes.
+        const Node& r_node = _nodes[i_node];
+        if (r_node.previousPhysical == null && r_node.nextPhysical == null && 1 < _blockCount) {
+            Block& r_block = _blocks[r_node.block];
+            _r_allocator.freeMemory(r_block.memory);
+            r_block = Block {};
+            --_blockCount;
+            _spareNodes.push_back(i_node);
+        } else {
+            this->insertFree(i_node);
+        }
+    }
+
+    VkDeviceSize getBlockSize() const noexcept
+    {
+        return _blockSize;
+    }
+
+    VkDeviceMemory getMemory(uint32_t i_node) const noexcept
+    {
+        return _blocks[_nodes[i_node].block].memory;
+    }
+
+    VkDeviceSize getOffset(uint32_t i_node) const noexcept
+    {
+        return _nodes[i_node].offset;
+    }
+
+    VkDeviceSize getSize(uint32_t i_node) const noexcept
+    {
+        return _nodes[i_node].size;
+    }
+
+    void* getMapped(uint32_t i_node) const noexcept
+    {
+        const Node& r_node = _nodes[i_node];
+        std::byte* p_base = _blocks[r_node.block].p_mapped;
+        return p_base ? p_base + r_node.offset : nullptr;
+    }
+
+    void collectStatistics(Statistics& r_statistics) const noexcept
+    {
+        r_statistics.blockCount += _blockCount;
+        r_statistics.allocationCount += _allocationCount;
+        r_statistics.usedBytes += _usedBytes;
+        for (const Block& r_block : _blocks) {
+            r_statistics.reservedBytes += r_block.size;
+        }
+
+        // The largest free range is in the highest non-empty bin
+        if (_firstLevelBitmap) {
+            const unsigned firstLevel = std::bit_width(_firstLevelBitmap) - 1;
+            const unsigned secondLevel = std::bit_width(_secondLevelBitmaps[firstLevel]) - 1;
+            for (uint32_t i_node=_heads[firstLevel][secondLevel]; i_node!=null; i_node=_nodes[i_node].nextFree) {
+                r_statistics.largestFreeRange = std::max(r_statistics.largestFreeRange, _nodes[i_node].size);
+            }
+        }
+    }
+
+private:
+    /// @brief Number of bits for second level bins.
+    static constexpr unsigned secondLevelBits = 5;
+
+    static constexpr unsigned secondLevelCount = 1u << secondLevelBits;
+
+    /// @brief Ranges smaller than 2^smallBits are binned linearly on the first level 0.
+    static constexpr unsigned smallBits = 8;
+
+    static constexpr unsigned firstLevelCount = 64 - smallBits + 1;
+
+    struct Node
+    {
+        VkDeviceSize offset = 0;
+
+        VkDeviceSize size = 0;
+
+        uint32_t block = null;
+
+        uint32_t previousPhysical = null;
+
+        uint32_t nextPhysical = null;
+
+        uint32_t previousFree = null;
+
+        uint32_t nextFree = null;
+
+        bool isFree = false;
+    }; // struct Node
+
+    struct Block
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+
+        VkDeviceSize size = 0;
+
+        std::byte* p_mapped = nullptr;
+    }; // struct Block
+
+    struct Bin
+    {
+        unsigned firstLevel;
+
+        unsigned secondLevel;
+    }; // struct Bin
+
+private:
+    static Bin getBin(VkDeviceSize size) noexcept
+    {
+        if (size < (VkDeviceSize(1) << smallBits)) {
+            return {0, static_cast<unsigned>(size >> (smallBits - secondLevelBits))};
+        }
+
+        const unsigned msb = std::bit_width(size) - 1;
+        return {msb - smallBits + 1,
+                static_cast<unsigned>(size >> (msb - secondLevelBits)) & (secondLevelCount - 1)};
+    }
+
+    /// @brief Find a free range of at least @a size bytes.
+    uint32_t findFree(VkDeviceSize size) const noexcept
+    {
+        // Round up to the next bin so that every range in it is large enough
+        if ((VkDeviceSize(1) << smallBits) <= size) {
+            size += (VkDeviceSize(1) << (std::bit_width(size) - 1 - secondLevelBits)) - 1;
+        }
+
+        auto [firstLevel, secondLevel] = DeviceAllocator::Pool::getBin(size);
+        if (firstLevelCount <= firstLevel) {
+            return null;
+        }
+
+        uint32_t secondLevelBitmap = _secondLevelBitmaps[firstLevel] & (~uint32_t(0) << secondLevel);
+        if (!secondLevelBitmap) {
+            const uint64_t firstLevelBitmap = _firstLevelBitmap & (~uint64_t(0) << (firstLevel + 1));
+            if (!firstLevelBitmap) {
+                return null;
+            }
+            firstLevel = std::countr_zero(firstLevelBitmap);
+            secondLevelBitmap = _secondLevelBitmaps[firstLevel];
+        }
+
+        return _heads[firstLevel][std::countr_zero(secondLevelBitmap)];
+    }
+
+    void insertFree(uint32_t i_node) noexcept
+    {
+        Node& r_node = _nodes[i_node];
+        const auto [firstLevel, secondLevel] = DeviceAllocator::Pool::getBin(r_node.size);
+        uint32_t& r_head = _heads[firstLevel][secondLevel];
+
+        r_node.isFree = true;
+        r_node.previousFree = null;
+        r_node.nextFree = r_head;
+        if (r_head != null) {
+            _nodes[r_head].previousFree = i_node;
+        }
+        r_head = i_node;
+
+        _firstLevelBitmap |= uint64_t(1) << firstLevel;
+        _secondLevelBitmaps[firstLevel] |= uint32_t(1) << secondLevel;
+    }
+
+    void removeFree(uint32_t i_node) noexcept
+    {
+        Node& r_node = _nodes[i_node];
+        const auto [firstLevel, secondLevel] = DeviceAllocator::Pool::getBin(r_node.size);
+
+        if (r_node.previousFree != null) {
+            _nodes[r_node.previousFree].nextFree = r_node.nextFree;
+        } else {
+            _heads[firstLevel][secondLevel] = r_node.nextFree;
+        }
+        if (r_node.nextFree != null) {
+            _nodes[r_node.nextFree].previousFree = r_node.previousFree;
+        }
+
+        if (_heads[firstLevel][secondLevel] == null) {
+            _secondLevelBitmaps[firstLevel] &= ~(uint32_t(1) << secondLevel);
+            if (!_secondLevelBitmaps[firstLevel]) {
+                _firstLevelBitmap &= ~(uint64_t(1) << firstLevel);
+            }
+        }
+
+        r_node.previousFree = null;
+        r_node.nextFree = null;
+    }
+
+    uint32_t makeNode()
+    {
+        if (!_spareNodes.empty()) {
+            const uint32_t i_node = _spareNodes.back();
+            _spareNodes.pop_back();
+            _nodes[i_node] = Node {};
+            return i_node;
+        }
+
+        _nodes.emplace_back();
+        return static_cast<uint32_t>(_nodes.size() - 1);
+    }
+
+    /// @brief Insert @a i_node into the physical list right before @a i_next.
+    void linkBefore(uint32_t i_node, uint32_t i_next) noexcept
+    {
+        const uint32_t i_previous = _nodes[i_next].previousPhysical;
+        _nodes[i_node].previousPhysical = i_previous;
+        _nodes[i_node].nextPhysical = i_next;
+        _nodes[i_next].previousPhysical = i_node;
+        if (i_previous != null) {
+            _nodes[i_previous].nextPhysical = i_node;
+        }
+    }
+
+    /// @brief Insert @a i_node into the physical list right after @a i_previous.
+    void linkAfter(uint32_t i_node, uint32_t i_previous) noexcept
+    {
+        const uint32_t i_next = _nodes[i_previous].nextPhysical;
+        _nodes[i_node].previousPhysical = i_previous;
+        _nodes[i_node].nextPhysical = i_next;
+        _nodes[i_previous].nextPhysical = i_node;
+        if (i_next != null) {
+            _nodes[i_next].previousPhysical = i_node;
+        }
+    }
+
+    /// @brief Remove a node from the physical list and recycle it.
+    void unlink(uint32_t i_node)
+    {
+        const Node& r_node = _nodes[i_node];
+        if (r_node.previousPhysical != null) {
+            _nodes[r_node.previousPhysical].nextPhysical = r_node.nextPhysical;
+        }
+        if (r_node.nextPhysical != null) {
+            _nodes[r_node.nextPhysical].previousPhysical = r_node.previousPhysical;
+        }
+        _spareNodes.push_back(i_node);
+    }
+
+    void addBlock(VkDeviceSize size)
+    {
+        Block block;
+        block.memory = _r_allocator.allocateMemory(size, _memoryType);
+        block.size = size;
+
+        if (_isHostVisible) {
+            void* p_mapped = nullptr;
+            if (vkMapMemory(_r_allocator._device, block.memory, 0, VK_WHOLE_SIZE, 0, &p_mapped) != VK_SUCCESS) {
+                _r_allocator.freeMemory(block.memory);
+                throw std::runtime_error("Failed to map device memory block");
+            }
+            block.p_mapped = static_cast<std::byte*>(p_mapped);
+        }
+
+        // Reuse the slot of a released block if there is one
+        auto it_block = std::find_if(_blocks.begin(),
+                                     _blocks.end(),
+                                     [](const Block& r_block) {return r_block.memory == VK_NULL_HANDLE;});
+        if (it_block == _blocks.end()) {
+            it_block = _blocks.insert(_blocks.end(), block);
+        } else {
+            *it_block = block;
+        }
+        ++_blockCount;
+
+        const uint32_t i_node = this->makeNode();
+        _nodes[i_node].offset = 0;
+        _nodes[i_node].size = size;
+        _nodes[i_node].block = static_cast<uint32_t>(std::distance(_blocks.begin(), it_block));
+        this->insertFree(i_node);
+    }
+
+private:
+    DeviceAllocator& _r_allocator;
+
+    uint32_t _memoryType;
+
+    VkDeviceSize _blockSize;
+
+    bool _isHostVisible;
+
+    uint64_t _firstLevelBitmap;
+
+    std::array<uint32_t,firstLevelCount> _secondLevelBitmaps;
+
+    std::array<std::array<uint32_t,secondLevelCount>,firstLevelCount> _heads;
+
+    std::vector<Node> _nodes;
+
+    std::vector<uint32_t> _spareNodes;
+
+    std::vector<Block> _blocks;
+
+    std::size_t _blockCount;
+
+    std::size_t _allocationCount;
+
+    VkDeviceSize _usedBytes;
+}; // class DeviceAllocator::Pool
+
+
+double DeviceAllocator::Statistics::getFragmentation() const noexcept
+{
+    // Dedicated allocations are neither free nor fragmented
+    const VkDeviceSize freeBytes = reservedBytes - usedBytes;
+    return freeBytes ? 1.0 - static_cast<double>(largestFreeRange) / static_cast<double>(freeBytes) : 0.0;
+}
+
+
+DeviceAllocator::DeviceAllocator(VkDevice device,
+                                 const PhysicalDevice& r_physicalDevice)
+    : DeviceAllocator(device, r_physicalDevice, Settings(), nullptr)
+{
+}
+
+
+DeviceAllocator::DeviceAllocator(VkDevice device,
+                                 const PhysicalDevice& r_physicalDevice,
+                                 const Settings& r_settings,
+                                 const VkAllocationCallbacks* p_allocationCallbacks)
+    : _device(device),
+      _p_allocationCallbacks(p_allocationCallbacks),
+      _memoryProperties(),
+      _bufferImageGranularity(1),
+      _maxAllocationCount(0),
+      _allocationCount(0),
+      _settings(r_settings),
+      _pools(),
+      _dedicatedCount(0),
+      _dedicatedBytes(0),
+      _mutex()
+{
+    _memoryProperties = r_physicalDevice.getMemoryProperties();
+
+    const auto& r_limits = r_physicalDevice.getProperties().limits;
+    _bufferImageGranularity = r_limits.bufferImageGranularity;
+    _maxAllocationCount = r_limits.maxMemoryAllocationCount;
+
+    // Keep blocks small enough for small heaps (e.g.: host visible device memory)
+    _pools.reserve(2 * _memoryProperties.memoryTypeCount);
+    for (uint32_t i_type=0; i_type<_memoryProperties.memoryTypeCount; ++i_type) {
+        const VkMemoryHeap& r_heap = _memoryProperties.memoryHeaps[_memoryProperties.memoryTypes[i_type].heapIndex];
+        const VkDeviceSize blockSize = alignUp(std::min(_settings.blockSize, r_heap.size / 8), granule);
+        _pools.push_back(std::make_unique<Pool>(*this, i_type, blockSize));
+        _pools.push_back(std::make_unique<Pool>(*this, i_type, blockSize));
+    }
+}
+
+
+DeviceAllocator::~DeviceAllocator()
+{
+    _pools.clear();
+}
+
+
+DeviceAllocator::Allocation DeviceAllocator::allocate(const VkMemoryRequirements& r_requirements,
+                                                      Resource resource,
+                                                      VkMemoryPropertyFlags required,
+                                                      VkMemoryPropertyFlags preferred)
+{
+    Allocation allocation;
+    allocation.memoryType = this->findMemoryType(r_requirements.memoryTypeBits, required, preferred);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    // Large requests don't share their memory
+    if (_pools[2 * allocation.memoryType]->getBlockSize() / 2 < r_requirements.size) {
+        allocation.memory = this->allocateMemory(r_requirements.size, allocation.memoryType);
+        allocation.size = r_requirements.size;
+        if (_memoryProperties.memoryTypes[allocation.memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+            if (vkMapMemory(_device, allocation.memory, 0, VK_WHOLE_SIZE, 0, &allocation.p_mapped) != VK_SUCCESS) {
+                this->freeMemory(allocation.memory);
+                throw std::runtime_error("Failed to map dedicated device memory");
+            }
+        }
+        ++_dedicatedCount;
+        _dedicatedBytes += allocation.size;
+        return allocation;
+    }
+
+    // Only keep linear and optimal resources apart if they could alias
+    const bool isSegregated = resource == Resource::Optimal && 1 < _bufferImageGranularity;
+    allocation.pool = 2 * allocation.memoryType + (isSegregated ? 1 : 0);
+    Pool& r_pool = *_pools[allocation.pool];
+
+    allocation.node = r_pool.allocate(r_requirements.size, r_requirements.alignment);
+    if (allocation.node == null) {
+        throw std::runtime_error("Failed to sub-allocate " + std::to_string(r_requirements.size) + " bytes of device memory");
+    }
+
+    allocation.memory = r_pool.getMemory(allocation.node);
+    allocation.offset = r_pool.getOffset(allocation.node);
+    allocation.size = r_pool.getSize(allocation.node);
+    allocation.p_mapped = r_pool.getMapped(allocation.node);
+    return allocation;
+}
+
+
+DeviceAllocator::Allocation DeviceAllocator::allocate(VkBuffer buffer,
+                                                      VkMemoryPropertyFlags required,
+                                                      VkMemoryPropertyFlags preferred)
+{
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(_device, buffer, &requirements);
+
+    const Allocation allocation = this->allocate(requirements, Resource::Linear, required, preferred);
+    if (vkBindBufferMemory(_device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        this->free(allocation);
+        throw std::runtime_error("Failed to bind buffer memory");
+    }
+    return allocation;
+}
+
+
+DeviceAllocator::Allocation DeviceAllocator::allocate(VkImage image,
+                                                      VkImageTiling tiling,
+                                                      VkMemoryPropertyFlags required,
+                                                      VkMemoryPropertyFlags preferred)
+{
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(_device, image, &requirements);
+
+    const Allocation allocation = this->allocate(requirements,
+                                                 tiling == VK_IMAGE_TILING_LINEAR ? Resource::Linear : Resource::Optimal,
+                                                 required,
+                                                 preferred);
+    if (vkBindImageMemory(_device, image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        this->free(allocation);
+        throw std::runtime_error("Failed to bind image memory");
+    }
+    return allocation;
+}
+
+
+void DeviceAllocator::free(const Allocation& r_allocation)
+{
+    if (r_allocation.memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    if (r_allocation.pool == null) {
+        --_dedicatedCount;
+        _dedicatedBytes -= r_allocation.size;
+        this->freeMemory(r_allocation.memory);
+    } else {
+        _pools[r_allocation.pool]->free(r_allocation.node);
+    }
+}
+
+
+uint32_t DeviceAllocator::findMemoryType(uint32_t typeBits,
+                                         VkMemoryPropertyFlags required,
+                                         VkMemoryPropertyFlags preferred) const
+{
+    const auto find = [this, typeBits](VkMemoryPropertyFlags properties) -> uint32_t {
+        for (uint32_t i_type=0; i_type<_memoryProperties.memoryTypeCount; ++i_type) {
+            if ((typeBits & (1u << i_type)) && (_memoryProperties.memoryTypes[i_type].propertyFlags & properties) == properties) {
+                return i_type;
+            }
+        }
+        return null;
+    };
+
+    uint32_t memoryType = find(required | preferred);
+    if (memoryType == null) {
+        memoryType = find(required);
+    }
+    if (memoryType == null) {
+        throw std::runtime_error("No suitable memory type");
+    }
+    return memoryType;
+}
+
+
+DeviceAllocator::Statistics DeviceAllocator::getStatistics() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    Statistics statistics;
+    for (const auto& rp_pool : _pools) {
+        rp_pool->collectStatistics(statistics);
+    }
+
+    statistics.dedicatedCount = _dedicatedCount;
+    statistics.allocationCount += _dedicatedCount;
+    statistics.reservedBytes += _dedicatedBytes;
+    statistics.usedBytes += _dedicatedBytes;
+    return statistics;
+}
+
+
+const VkPhysicalDeviceMemoryProperties& DeviceAllocator::getMemoryProperties() const noexcept
+{
+    return _memoryProperties;
+}
+
+
+VkDeviceMemory DeviceAllocator::allocateMemory(VkDeviceSize size, uint32_t memoryType)
+{
+    if (_maxAllocationCount <= _allocationCount) {
+        throw std::runtime_error("Reached maxMemoryAllocationCount (" + std::to_string(_maxAllocationCount) + ")");
+    }
+
+    VkMemoryAllocateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    info.allocationSize = size;
+    info.memoryTypeIndex = memoryType;
+
+    VkDeviceMemory memory;
+    if (vkAllocateMemory(_device, &info, _p_allocationCallbacks, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate " + std::to_string(size) + " bytes of device memory");
+    }
+
+    ++_allocationCount;
+    return memory;
+}
+
+
+void DeviceAllocator::freeMemory(VkDeviceMemory memory)
+{
+    // Freeing implicitly unmaps
+    vkFreeMemory(_device, memory, _p_allocationCallbacks);
+    --_allocationCount;
+}
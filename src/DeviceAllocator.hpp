@@ -0,0 +1,169 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "PhysicalDevice.hpp"
+
+// --- STL Includes ---
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/// @brief Sub-allocates buffer and image memory from large device memory blocks.
+/// @details Every memory type gets its own pools of blocks, and free ranges within
+///          them are tracked by a two level segregated fit (TLSF) free list, so both
+///          allocating and freeing take constant time. Requests larger than half a
+///          block get a dedicated @a VkDeviceMemory instead.
+///
+///          Linear (buffers, linearly tiled images) and optimal (tiled images) resources
+///          are placed in separate blocks if the device's @a bufferImageGranularity is
+///          larger than 1, so they can never share a granularity page.
+///
+///          Blocks of host visible memory types are persistently mapped for as long as
+///          they exist. Thread safe.
+class DeviceAllocator
+{
+public:
+    enum class Resource
+    {
+        Linear,
+        Optimal
+    }; // enum class Resource
+
+    struct Settings
+    {
+        /// @brief Size of the blocks sub-allocations are carved from [bytes].
+        /// @details Reduced to an eighth of the heap for small heaps.
+        VkDeviceSize blockSize = VkDeviceSize(64) << 20;
+    }; // struct Settings
+
+    struct Allocation
+    {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+
+        VkDeviceSize offset = 0;
+
+        VkDeviceSize size = 0;
+
+        /// @brief Host address of the allocation if its memory is host visible, null otherwise.
+        void* p_mapped = nullptr;
+
+        uint32_t memoryType = 0;
+
+        /// @name Bookkeeping
+        /// @brief Identify the allocation within the allocator; dedicated allocations have no pool.
+        /// @{
+
+        uint32_t pool = std::numeric_limits<uint32_t>::max();
+
+        uint32_t node = std::numeric_limits<uint32_t>::max();
+
+        /// @}
+    }; // struct Allocation
+
+    struct Statistics
+    {
+        /// @brief Number of @a VkDeviceMemory blocks that are sub-allocated from.
+        std::size_t blockCount = 0;
+
+        /// @brief Number of allocations that got their own @a VkDeviceMemory.
+        std::size_t dedicatedCount = 0;
+
+        /// @brief Number of live allocations, including dedicated ones.
+        std::size_t allocationCount = 0;
+
+        /// @brief Total size of all @a VkDeviceMemory objects [bytes].
+        VkDeviceSize reservedBytes = 0;
+
+        /// @brief Total size of all live allocations, including alignment padding [bytes].
+        VkDeviceSize usedBytes = 0;
+
+        /// @brief Largest contiguous free range in any block [bytes].
+        VkDeviceSize largestFreeRange = 0;
+
+        /// @brief Free bytes in blocks that can't be handed out as a single allocation, in [0, 1].
+        double getFragmentation() const noexcept;
+    }; // struct Statistics
+
+public:
+    DeviceAllocator(VkDevice device,
+                    const PhysicalDevice& r_physicalDevice);
+
+    /// @param p_allocationCallbacks host allocator device memory is allocated and freed with; may be nullptr.
+    DeviceAllocator(VkDevice device,
+                    const PhysicalDevice& r_physicalDevice,
+                    const Settings& r_settings,
+                    const VkAllocationCallbacks* p_allocationCallbacks);
+
+    DeviceAllocator(const DeviceAllocator&) = delete;
+
+    /// @brief Release all blocks; outstanding allocations become invalid.
+    ~DeviceAllocator();
+
+    /// @brief Allocate memory satisfying the provided requirements.
+    /// @param required memory properties the allocation must have.
+    /// @param preferred memory properties that are picked if a memory type has them too.
+    Allocation allocate(const VkMemoryRequirements& r_requirements,
+                        Resource resource,
+                        VkMemoryPropertyFlags required,
+                        VkMemoryPropertyFlags preferred = 0);
+
+    /// @brief Allocate memory for a buffer and bind it.
+    Allocation allocate(VkBuffer buffer,
+                        VkMemoryPropertyFlags required,
+                        VkMemoryPropertyFlags preferred = 0);
+
+    /// @brief Allocate memory for an image and bind it.
+    Allocation allocate(VkImage image,
+                        VkImageTiling tiling,
+                        VkMemoryPropertyFlags required,
+                        VkMemoryPropertyFlags preferred = 0);
+
+    void free(const Allocation& r_allocation);
+
+    /// @brief Find a memory type allowed by @a typeBits that has all @a required and, if possible, all @a preferred properties.
+    uint32_t findMemoryType(uint32_t typeBits,
+                            VkMemoryPropertyFlags required,
+                            VkMemoryPropertyFlags preferred = 0) const;
+
+    Statistics getStatistics() const;
+
+    const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const noexcept;
+
+private:
+    VkDeviceMemory allocateMemory(VkDeviceSize size, uint32_t memoryType);
+
+    void freeMemory(VkDeviceMemory memory);
+
+private:
+    class Pool;
+
+    VkDevice _device;
+
+    const VkAllocationCallbacks* _p_allocationCallbacks;
+
+    VkPhysicalDeviceMemoryProperties _memoryProperties;
+
+    VkDeviceSize _bufferImageGranularity;
+
+    uint32_t _maxAllocationCount;
+
+    /// @brief Number of live @a VkDeviceMemory objects.
+    uint32_t _allocationCount;
+
+    Settings _settings;
+
+    /// @brief Two pools (linear and optimal) per memory type.
+    std::vector<std::unique_ptr<Pool>> _pools;
+
+    std::size_t _dedicatedCount;
+
+    VkDeviceSize _dedicatedBytes;
+
+    mutable std::mutex _mutex;
+}; // class DeviceAllocator
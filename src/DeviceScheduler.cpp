@@ -0,0 +1,222 @@
+// --- Internal Includes ---
+#include "DeviceScheduler.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+
+
+DeviceScheduler::DeviceScheduler(std::vector<std::shared_ptr<LogicalDevice>>&& r_devices)
+    : DeviceScheduler(std::move(r_devices), Settings())
+{
+}
+
+
+DeviceScheduler::DeviceScheduler(std::vector<std::shared_ptr<LogicalDevice>>&& r_devices,
+                                 const Settings& r_settings)
+    : _devices(std::move(r_devices)),
+      _settings(r_settings),
+      _throughputs(_devices.size(), 0.0),
+      _statistics(),
+      _workers(std::max<std::size_t>(_devices.size(), 1))
+{
+    if (_devices.empty()) {
+        throw std::runtime_error("Device scheduler requires at least one device");
+    }
+
+    if (!(0.0 < _settings.smoothing && _settings.smoothing <= 1.0)) {
+        throw std::runtime_error("Device scheduler smoothing must be in (0, 1]");
+    }
+
+    _statistics.jobCounts.resize(_devices.size(), 0);
+    _statistics.busyTimes.resize(_devices.size(), 0.0);
+}
+
+
+std::vector<DeviceScheduler::Chunk> DeviceScheduler::split(std::size_t jobCount) const
+{
+    const std::size_t deviceCount = _devices.size();
+
+    // Every device gets its minimum first, the rest is shared by throughput
+    const std::size_t reservedCount = std::min(_settings.minJobsPerDevice, jobCount / deviceCount);
+    const std::size_t sharedCount = jobCount - reservedCount * deviceCount;
+
+    // Devices that weren't measured yet are assumed to be as fast as the average measured one
+    std::size_t measuredCount = 0;
+    double measuredSum = 0.0;
+    for (double throughput : _throughputs) {
+        if (0.0 < throughput) {
+            ++measuredCount;
+            measuredSum += throughput;
+        }
+    }
+    const double fallback = measuredCount ? measuredSum / measuredCount : 1.0;
+
+    std::vector<double> weights(deviceCount);
+    std::transform(_throughputs.begin(),
+                   _throughputs.end(),
+                   weights.begin(),
+                   [fallback](double throughput) {return 0.0 < throughput ? throughput : fallback;});
+    const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+
+    // Largest remainder method: round the quotas down, then hand the jobs
+    // lost to rounding to the devices with the largest fractional parts
+    std::vector<std::size_t> counts(deviceCount);
+    std::vector<double> remainders(deviceCount);
+    std::size_t assignedCount = 0;
+    for (std::size_t i_device=0; i_device<deviceCount; ++i_device) {
+        const double quota = sharedCount * weights[i_device] / weightSum;
+        counts[i_device] = std::min(static_cast<std::size_t>(std::floor(quota)), sharedCount - assignedCount);
+        remainders[i_device] = quota - counts[i_device];
+        assignedCount += counts[i_device];
+    }
+
+    std::vector<std::size_t> order(deviceCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&remainders](std::size_t i_left, std::size_t i_right) {
+                         return remainders[i_right] < remainders[i_left];
+                     });
+    for (std::size_t i_order=0; assignedCount<sharedCount; i_order=(i_order + 1) % deviceCount) {
+        ++counts[order[i_order]];
+        ++assignedCount;
+    }
+
+    std::vector<Chunk> chunks(deviceCount);
+    std::size_t begin = 0;
+    for (std::size_t i_device=0; i_device<deviceCount; ++i_device) {
+        chunks[i_device].begin = begin;
+        chunks[i_device].end = begin + reservedCount + counts[i_device];
+        begin = chunks[i_device].end;
+    }
+
+    return chunks;
+}
+
+
+void DeviceScheduler::run(std::size_t jobCount,
+                          const Executor& r_executor,
+                          const Merger& r_merger)
+{
+    VKTUTORIAL_TRACE_SCOPE("DeviceScheduler::run");
+
+    if (jobCount == 0) {
+        return;
+    }
+
+    const auto chunks = this->split(jobCount);
+
+    std::vector<double> times(_devices.size(), 0.0);
+    std::vector<std::future<void>> executions(_devices.size());
+    for (std::size_t i_device=0; i_device<_devices.size(); ++i_device) {
+        const Chunk chunk = chunks[i_device];
+        if (!chunk.size()) {
+            continue;
+        }
+
+        executions[i_device] = _workers.submit([&r_executor, &r_time = times[i_device], i_device, chunk]() {
+            VKTUTORIAL_TRACE_SCOPE("DeviceScheduler::chunk");
+            const auto begin = std::chrono::steady_clock::now();
+            r_executor(i_device, chunk.begin, chunk.end);
+            r_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        });
+    }
+
+    // Merge in job order while later chunks are still executing. Every execution
+    // is waited on before rethrowing, since they reference local state.
+    std::exception_ptr p_exception;
+    for (std::size_t i_device=0; i_device<_devices.size(); ++i_device) {
+        if (!executions[i_device].valid()) {
+            continue;
+        }
+
+        try {
+            executions[i_device].get();
+            if (!p_exception) {
+                r_merger(i_device, chunks[i_device].begin, chunks[i_device].end);
+            }
+        } catch (...) {
+            if (!p_exception) {
+                p_exception = std::current_exception();
+            }
+        }
+    }
+
+    if (p_exception) {
+        std::rethrow_exception(p_exception);
+    }
+
+    // Update the estimates
+    for (std::size_t i_device=0; i_device<_devices.size(); ++i_device) {
+        const std::size_t size = chunks[i_device].size();
+        const double time = times[i_device];
+        if (!size || time <= 0.0) {
+            continue;
+        }
+
+        const double measured = size / time;
+        double& r_throughput = _throughputs[i_device];
+        r_throughput = 0.0 < r_throughput
+                       ? _settings.smoothing * measured + (1.0 - _settings.smoothing) * r_throughput
+                       : measured;
+
+        _statistics.jobCounts[i_device] += size;
+        _statistics.busyTimes[i_device] += time;
+    }
+    ++_statistics.runCount;
+}
+
+
+std::size_t DeviceScheduler::getDeviceCount() const noexcept
+{
+    return _devices.size();
+}
+
+
+const std::shared_ptr<LogicalDevice>& DeviceScheduler::getDevice(std::size_t i_device) const
+{
+    if (_devices.size() <= i_device) {
+        throw std::runtime_error("Device index out of range");
+    }
+    return _devices[i_device];
+}
+
+
+const std::vector<double>& DeviceScheduler::getThroughputs() const noexcept
+{
+    return _throughputs;
+}
+
+
+const DeviceScheduler::Statistics& DeviceScheduler::getStatistics() const noexcept
+{
+    return _statistics;
+}
+
+
+std::vector<std::shared_ptr<LogicalDevice>> DeviceScheduler::createDevices(VkInstance instance,
+                                                                           std::size_t replicaCount)
+{
+    std::vector<std::shared_ptr<LogicalDevice>> devices;
+
+    for (const auto& r_physicalDevice : PhysicalDevice::getSuitableDevices(instance, std::nullopt)) {
+        // Replicas share the physical device and its capabilities
+        const auto p_physicalDevice = std::make_shared<PhysicalDevice>(r_physicalDevice);
+        for (std::size_t i_replica=0; i_replica<replicaCount; ++i_replica) {
+            devices.push_back(std::make_shared<LogicalDevice>(p_physicalDevice));
+        }
+    }
+
+    if (devices.empty()) {
+        throw std::runtime_error("No suitable physical device found");
+    }
+
+    return devices;
+}
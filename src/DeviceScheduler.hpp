@@ -0,0 +1,134 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "ThreadPool.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+/// @brief Splits independent jobs (offscreen tiles, compute batches) across several devices.
+/// @details @ref run hands each device a contiguous chunk of the jobs, sized in proportion
+///          to the device's throughput [jobs/s]. Chunks execute on a shared @ref ThreadPool
+///          with as many workers as there are devices, which take them from a single FIFO
+///          queue. Each run submits one chunk per device and waits for all of them, so a
+///          device's queues are only used by one thread at a time, though not necessarily
+///          the same one from run to run.
+///
+///          The throughputs are measured while running: each chunk's wall clock time updates
+///          an exponential moving average, so the split follows devices that speed up or slow
+///          down (clocks, other load) without jumping on a single noisy run. Until a device
+///          was measured, all devices are assumed to be equally fast.
+///
+///          Finished chunks are merged on the calling thread in job order, while later
+///          chunks may still be executing.
+/// @note @ref run must not be called from several threads at once.
+class DeviceScheduler
+{
+public:
+    struct Settings
+    {
+        /// @brief Weight of the latest measurement in the throughput estimates, in (0, 1].
+        double smoothing = 0.5;
+
+        /// @brief Number of jobs every device gets, if there are enough jobs.
+        /// @details Keeps slow devices measured, so they get their share back when they catch up.
+        std::size_t minJobsPerDevice = 1;
+    }; // struct Settings
+
+    /// @brief Executes the jobs in [begin, end) on a device.
+    /// @details Called concurrently from worker threads with disjoint ranges, one per device.
+    ///          Must block until the device finished the jobs, so that they are measured.
+    using Executor = std::function<void(std::size_t,std::size_t,std::size_t)>;
+
+    /// @brief Merges the results of the jobs in [begin, end) that ran on a device.
+    /// @details Called on the thread that called @ref run, once per chunk, in job order.
+    using Merger = std::function<void(std::size_t,std::size_t,std::size_t)>;
+
+    /// @brief Jobs in [begin, end).
+    struct Chunk
+    {
+        std::size_t begin = 0;
+
+        std::size_t end = 0;
+
+        std::size_t size() const noexcept
+        {
+            return end - begin;
+        }
+    }; // struct Chunk
+
+    struct Statistics
+    {
+        /// @brief Number of calls to @ref run.
+        std::size_t runCount = 0;
+
+        /// @brief Jobs each device executed in total.
+        std::vector<std::size_t> jobCounts;
+
+        /// @brief Time each device spent executing jobs in total [s].
+        std::vector<double> busyTimes;
+    }; // struct Statistics
+
+public:
+    DeviceScheduler(std::vector<std::shared_ptr<LogicalDevice>>&& r_devices);
+
+    DeviceScheduler(std::vector<std::shared_ptr<LogicalDevice>>&& r_devices,
+                    const Settings& r_settings);
+
+    DeviceScheduler(const DeviceScheduler&) = delete;
+
+    /// @brief Split @a jobCount jobs across the devices, based on their current throughput estimates.
+    /// @return one chunk per device; chunks are contiguous, in device order, and may be empty.
+    std::vector<Chunk> split(std::size_t jobCount) const;
+
+    /// @brief Execute @a jobCount jobs on all devices and merge their results.
+    /// @details Blocks until all chunks are executed and merged. If an executor or the merger
+    ///          throws, the remaining chunks still finish before the first exception is rethrown,
+    ///          and the throughput estimates are left unchanged.
+    void run(std::size_t jobCount,
+             const Executor& r_executor,
+             const Merger& r_merger);
+
+    /// @name Member Access
+    /// @{
+
+    std::size_t getDeviceCount() const noexcept;
+
+    const std::shared_ptr<LogicalDevice>& getDevice(std::size_t i_device) const;
+
+    /// @brief Current throughput estimate of each device [jobs/s], 0 if it wasn't measured yet.
+    const std::vector<double>& getThroughputs() const noexcept;
+
+    const Statistics& getStatistics() const noexcept;
+
+    /// @}
+
+    /// @brief Create a logical device on every physical device suitable for rendering.
+    /// @param replicaCount number of logical devices to create per physical device.
+    ///                     Several logical devices on a single software driver behave like
+    ///                     independent devices, which is enough to exercise the scheduling
+    ///                     on machines with a single device.
+    /// @return the devices, most suitable first (see @ref PhysicalDevice::getSuitableDevices).
+    static std::vector<std::shared_ptr<LogicalDevice>> createDevices(VkInstance instance,
+                                                                     std::size_t replicaCount = 1);
+
+private:
+    std::vector<std::shared_ptr<LogicalDevice>> _devices;
+
+    Settings _settings;
+
+    std::vector<double> _throughputs;
+
+    Statistics _statistics;
+
+    /// @brief As many workers as devices, shared by the jobs of all devices.
+    ThreadPool _workers;
+}; // class DeviceScheduler
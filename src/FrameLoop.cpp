@@ -0,0 +1,244 @@
+// --- Internal Includes ---
+#include "FrameLoop.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+
+FrameLoop::FrameLoop(const std::shared_ptr<RenderTarget>& rp_target,
+                     std::size_t framesInFlight)
+    : _p_target(rp_target),
+      _device(rp_target->getLogicalDevice().getDevice()),
+      _p_allocationCallbacks(rp_target->getLogicalDevice().getAllocationCallbacks()),
+      _queue(rp_target->getLogicalDevice().getQueue()),
+      _presentQueue(rp_target->getLogicalDevice().getQueue(LogicalDevice::QueueType::Presentation)),
+      _frames(),
+      _imagesInFlight(rp_target->getImages().size(), VK_NULL_HANDLE),
+      _i_frame(0),
+      _statistics(),
+      _retired()
+{
+    if (framesInFlight == 0) {
+        throw std::runtime_error("Frame loop requires at least one frame in flight");
+    }
+
+    const auto queueFamily = _p_target->getLogicalDevice().getPhysicalDevice().getQueueFamily({});
+
+    _frames.reserve(framesInFlight);
+    for (std::size_t i_frame=0; i_frame<framesInFlight; ++i_frame) {
+        Frame frame {};
+
+        // Start signaled so that the first wait on each slot returns immediately
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        if (vkCreateFence(_device, &fenceInfo, _p_allocationCallbacks, &frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create frame fence");
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        if (vkCreateSemaphore(_device, &semaphoreInfo, _p_allocationCallbacks, &frame.imageAvailable) != VK_SUCCESS
+            || vkCreateSemaphore(_device, &semaphoreInfo, _p_allocationCallbacks, &frame.renderFinished) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create frame semaphores");
+        }
+
+        // The pool is reset as a whole at the start of each frame
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = queueFamily.graphics.value();
+        if (vkCreateCommandPool(_device, &poolInfo, _p_allocationCallbacks, &frame.commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create frame command pool");
+        }
+
+        VkCommandBufferAllocateInfo bufferInfo {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        bufferInfo.commandPool = frame.commandPool;
+        bufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        bufferInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(_device, &bufferInfo, &frame.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate frame command buffer");
+        }
+
+        _frames.push_back(frame);
+    }
+}
+
+
+FrameLoop::~FrameLoop()
+{
+    this->waitIdle();
+    for (Frame& r_frame : _frames) {
+        vkDestroyCommandPool(_device, r_frame.commandPool, _p_allocationCallbacks);
+        vkDestroySemaphore(_device, r_frame.renderFinished, _p_allocationCallbacks);
+        vkDestroySemaphore(_device, r_frame.imageAvailable, _p_allocationCallbacks);
+        vkDestroyFence(_device, r_frame.inFlight, _p_allocationCallbacks);
+    }
+}
+
+
+bool FrameLoop::render(const Recorder& r_recorder)
+{
+    VKTUTORIAL_TRACE_SCOPE("FrameLoop::render");
+    using Clock = std::chrono::steady_clock;
+    Frame& r_frame = _frames[_i_frame];
+
+    // Wait until the slot's previous submission is done with its command buffer
+    const auto waitBegin = Clock::now();
+    {
+        VKTUTORIAL_TRACE_SCOPE("FrameLoop::wait");
+        vkWaitForFences(_device, 1, &r_frame.inFlight, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    }
+
+    const Statistics::Duration fenceWait = Clock::now() - waitBegin;
+    _statistics.lastFenceWait = fenceWait;
+    _statistics.maxFenceWait = std::max(_statistics.maxFenceWait, fenceWait);
+    _statistics.totalFenceWait += fenceWait;
+
+    // Non-presentable targets synchronize through the frame fences alone
+    const bool isPresentable = _p_target->isPresentable();
+    const VkSemaphore imageAvailable = isPresentable ? r_frame.imageAvailable : VK_NULL_HANDLE;
+    const VkSemaphore renderFinished = isPresentable ? r_frame.renderFinished : VK_NULL_HANDLE;
+
+    // The slot's previous submission is done, which may have been the last one to use a retired resource
+    this->release();
+
+    const auto acquireBegin = Clock::now();
+    const std::optional<uint32_t> acquired = _p_target->acquire(imageAvailable);
+    if (!acquired) {
+        return false;
+    }
+    const uint32_t i_image = acquired.value();
+
+    // The image may still be in use by a different slot if the target
+    // has fewer images than there are frames in flight, or returns them
+    // out of order.
+    VkFence& r_imageFence = _imagesInFlight[i_image];
+    if (r_imageFence != VK_NULL_HANDLE && r_imageFence != r_frame.inFlight) {
+        vkWaitForFences(_device, 1, &r_imageFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    }
+    r_imageFence = r_frame.inFlight;
+
+    const Statistics::Duration acquire = Clock::now() - acquireBegin;
+    _statistics.lastAcquire = acquire;
+    _statistics.maxAcquire = std::max(_statistics.maxAcquire, acquire);
+    _statistics.totalAcquire += acquire;
+
+    // Record
+    vkResetCommandPool(_device, r_frame.commandPool, 0);
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(r_frame.commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to begin frame command buffer");
+    }
+
+    {
+        VKTUTORIAL_TRACE_SCOPE("FrameLoop::record");
+        r_recorder(r_frame.commandBuffer, i_image);
+    }
+
+    if (vkEndCommandBuffer(r_frame.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record frame command buffer");
+    }
+
+    // Submit
+    const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+    VkSubmitInfo submitInfo {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.waitSemaphoreCount = imageAvailable == VK_NULL_HANDLE ? 0 : 1;
+    submitInfo.pWaitSemaphores = &imageAvailable;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &r_frame.commandBuffer;
+    submitInfo.signalSemaphoreCount = renderFinished == VK_NULL_HANDLE ? 0 : 1;
+    submitInfo.pSignalSemaphores = &renderFinished;
+
+    vkResetFences(_device, 1, &r_frame.inFlight);
+    if (vkQueueSubmit(_queue, 1, &submitInfo, r_frame.inFlight) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit frame");
+    }
+
+    {
+        VKTUTORIAL_TRACE_SCOPE("FrameLoop::present");
+        _p_target->present(i_image, renderFinished);
+    }
+
+    ++_statistics.frameCount;
+    _i_frame = (_i_frame + 1) % _frames.size();
+    return true;
+}
+
+
+void FrameLoop::setTarget(const std::shared_ptr<RenderTarget>& rp_target)
+{
+    if (rp_target->getLogicalDevice().getDevice() != _device) {
+        throw std::runtime_error("Frame loop targets must share the same logical device");
+    }
+
+    this->retire(_p_target);
+    _p_target = rp_target;
+    _imagesInFlight.assign(_p_target->getImages().size(), VK_NULL_HANDLE);
+}
+
+
+void FrameLoop::retire(std::shared_ptr<const void> p_resource)
+{
+    // Frames are submitted to the slots round-robin, so once render has waited on
+    // every slot again, all submissions up to now finished executing.
+    _retired.push_back(Retired {std::move(p_resource),
+                                _statistics.frameCount + _frames.size() - 1});
+}
+
+
+void FrameLoop::waitIdle()
+{
+    std::vector<VkFence> fences;
+    fences.reserve(_frames.size());
+    for (const Frame& r_frame : _frames) {
+        fences.push_back(r_frame.inFlight);
+    }
+
+    if (!fences.empty()) {
+        vkWaitForFences(_device,
+                        static_cast<uint32_t>(fences.size()),
+                        fences.data(),
+                        VK_TRUE,
+                        std::numeric_limits<uint64_t>::max());
+    }
+
+    // The fences only cover the submissions; present operations still waiting on
+    // a frame's render semaphore are finished once the presentation queue is idle.
+    vkQueueWaitIdle(_presentQueue);
+
+    _retired.clear();
+}
+
+
+std::size_t FrameLoop::getFramesInFlight() const noexcept
+{
+    return _frames.size();
+}
+
+
+const FrameLoop::Statistics& FrameLoop::getStatistics() const noexcept
+{
+    return _statistics;
+}
+
+
+void FrameLoop::release()
+{
+    // Called after waiting on the current slot, before its next submission
+    std::erase_if(_retired, [this](const Retired& r_retired) -> bool {
+        return r_retired.releaseAt <= _statistics.frameCount;
+    });
+}
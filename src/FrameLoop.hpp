@@ -0,0 +1,153 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "RenderTarget.hpp"
+
+// --- STL Includes ---
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+/// @brief Drives rendering into a @ref RenderTarget with a fixed number of frames in flight.
+/// @details Each frame slot owns its own fence, image-acquire and render-finished semaphores,
+///          and command pool, so the CPU can record frame N+1 while the GPU still executes
+///          frame N. The CPU only blocks when it comes back around to a slot whose previous
+///          submission hasn't finished yet; the time spent waiting is tracked in @ref Statistics.
+class FrameLoop
+{
+public:
+    /// @brief Synchronization primitives and command buffer of a single frame slot.
+    struct Frame
+    {
+        /// @brief Signaled when the slot's last submission finished executing.
+        VkFence inFlight;
+
+        /// @brief Signaled when the acquired image can be written.
+        VkSemaphore imageAvailable;
+
+        /// @brief Signaled when the slot's commands finished and the image can be presented.
+        VkSemaphore renderFinished;
+
+        VkCommandPool commandPool;
+
+        VkCommandBuffer commandBuffer;
+    }; // struct Frame
+
+    struct Statistics
+    {
+        using Duration = std::chrono::duration<double>;
+
+        std::size_t frameCount = 0;
+
+        /// @brief Time the CPU spent waiting on the frame slot's fence before recording the last frame.
+        Duration lastFenceWait {0};
+
+        Duration maxFenceWait {0};
+
+        Duration totalFenceWait {0};
+
+        /// @brief Time the CPU spent acquiring the last frame's image.
+        /// @details Includes waiting on the fence of a different slot still rendering into the image.
+        Duration lastAcquire {0};
+
+        Duration maxAcquire {0};
+
+        Duration totalAcquire {0};
+
+        /// @brief Average fence wait per frame [s].
+        double getAverageFenceWait() const noexcept
+        {
+            return frameCount ? totalFenceWait.count() / frameCount : 0.0;
+        }
+
+        /// @brief Average image acquisition time per frame [s].
+        double getAverageAcquire() const noexcept
+        {
+            return frameCount ? totalAcquire.count() / frameCount : 0.0;
+        }
+    }; // struct Statistics
+
+    /// @brief Records the commands of a frame.
+    /// @details Invoked with the slot's command buffer (already in recording state)
+    ///          and the index of the acquired image in @ref RenderTarget::getImages.
+    using Recorder = std::function<void(VkCommandBuffer,uint32_t)>;
+
+public:
+    FrameLoop(const std::shared_ptr<RenderTarget>& rp_target,
+              std::size_t framesInFlight);
+
+    FrameLoop(const FrameLoop&) = delete;
+
+    /// @brief Waits for all frames in flight before releasing their resources.
+    ~FrameLoop();
+
+    /// @brief Acquire an image, record commands into it, submit and present it.
+    /// @return false if the target is out of date and no frame was rendered. The target
+    ///         has to be replaced through @ref setTarget before rendering can continue.
+    bool render(const Recorder& r_recorder);
+
+    /// @brief Render into a different target from the next frame on, for example a recreated @ref SwapChain.
+    /// @details The previous target is passed to @ref retire instead of being released right
+    ///          away, since frames in flight may still reference its images.
+    void setTarget(const std::shared_ptr<RenderTarget>& rp_target);
+
+    /// @brief Keep a resource alive until every frame submitted so far finished executing.
+    /// @details The resource is released by a later @ref render, once each frame slot was
+    ///          waited on after the current submissions, so retiring never stalls the device.
+    ///          Meant for image views, framebuffers and other objects of a replaced target.
+    void retire(std::shared_ptr<const void> p_resource);
+
+    /// @brief Block until every submitted frame finished executing and was handed to the presentation engine.
+    void waitIdle();
+
+    /// @name Member Access
+    /// @{
+
+    std::size_t getFramesInFlight() const noexcept;
+
+    const Statistics& getStatistics() const noexcept;
+
+    /// @}
+
+private:
+    /// @brief Resource waiting for the frames submitted before its retirement.
+    struct Retired
+    {
+        std::shared_ptr<const void> p_resource;
+
+        /// @brief Value of @ref Statistics::frameCount from which on the resource is unused.
+        std::size_t releaseAt;
+    }; // struct Retired
+
+    /// @brief Release retired resources no frame in flight can reference anymore.
+    void release();
+
+private:
+    std::shared_ptr<RenderTarget> _p_target;
+
+    VkDevice _device;
+
+    const VkAllocationCallbacks* _p_allocationCallbacks;
+
+    VkQueue _queue;
+
+    /// @brief Queue the targets present on, which may still wait on a frame's render semaphore.
+    VkQueue _presentQueue;
+
+    std::vector<Frame> _frames;
+
+    /// @brief Fence of the frame that last rendered into each image of the target.
+    std::vector<VkFence> _imagesInFlight;
+
+    std::size_t _i_frame;
+
+    Statistics _statistics;
+
+    std::vector<Retired> _retired;
+}; // class FrameLoop
@@ -0,0 +1,56 @@
+// --- Internal Includes ---
+#include "Framebuffers.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+
+
+Framebuffers::Framebuffers(const std::shared_ptr<RenderTarget::ImageViews>& rp_views,
+                           VkRenderPass renderPass)
+    : _p_views(rp_views),
+      _device(rp_views->getRenderTarget().getLogicalDevice().getDevice()),
+      _p_allocationCallbacks(rp_views->getRenderTarget().getLogicalDevice().getAllocationCallbacks()),
+      _framebuffers()
+{
+    const VkExtent2D extent = _p_views->getRenderTarget().getImageExtent();
+
+    _framebuffers.reserve(_p_views->size());
+    for (std::size_t i_image=0; i_image<_p_views->size(); ++i_image) {
+        const VkImageView view = (*_p_views)[i_image].get();
+
+        VkFramebufferCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        info.renderPass = renderPass;
+        info.attachmentCount = 1;
+        info.pAttachments = &view;
+        info.width = extent.width;
+        info.height = extent.height;
+        info.layers = 1;
+
+        VkFramebuffer framebuffer;
+        if (vkCreateFramebuffer(_device, &info, _p_allocationCallbacks, &framebuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create framebuffer");
+        }
+        _framebuffers.push_back(framebuffer);
+    }
+}
+
+
+Framebuffers::~Framebuffers()
+{
+    for (VkFramebuffer framebuffer : _framebuffers) {
+        vkDestroyFramebuffer(_device, framebuffer, _p_allocationCallbacks);
+    }
+}
+
+
+VkFramebuffer Framebuffers::get(std::size_t i_image) const
+{
+    return _framebuffers.at(i_image);
+}
+
+
+std::size_t Framebuffers::size() const noexcept
+{
+    return _framebuffers.size();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "RenderTarget.hpp"
+
+// --- STL Includes ---
+#include <memory>
+#include <vector>
+
+
+/// @brief One framebuffer per image of a @ref RenderTarget, for a specific render pass.
+class Framebuffers
+{
+public:
+    Framebuffers(const std::shared_ptr<RenderTarget::ImageViews>& rp_views,
+                 VkRenderPass renderPass);
+
+    Framebuffers(const Framebuffers&) = delete;
+
+    ~Framebuffers();
+
+    /// @name Member Access
+    /// @{
+
+    VkFramebuffer get(std::size_t i_image) const;
+
+    std::size_t size() const noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<RenderTarget::ImageViews> _p_views;
+
+    VkDevice _device;
+
+    const VkAllocationCallbacks* _p_allocationCallbacks;
+
+    std::vector<VkFramebuffer> _framebuffers;
+}; // class Framebuffers
@@ -0,0 +1,295 @@
+// --- Internal Includes ---
+#include "GpuProfiler.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+
+
+namespace {
+
+
+/// @brief Quote a CSV field if it contains characters that would break the row.
+std::string escapeCSV(const std::string& r_field)
+{
+    if (r_field.find_first_of(",\"\n") == std::string::npos) {
+        return r_field;
+    }
+
+    std::string output = "\"";
+    for (char c : r_field) {
+        if (c == '"') {
+            output += '"';
+        }
+        output += c;
+    }
+    output += '"';
+    return output;
+}
+
+
+} // unnamed namespace
+
+
+GpuProfiler::Scope::Scope(GpuProfiler& r_profiler,
+                          VkCommandBuffer commandBuffer,
+                          std::string_view name)
+    : _r_profiler(r_profiler),
+      _commandBuffer(commandBuffer)
+{
+    _r_profiler.begin(_commandBuffer, name);
+}
+
+
+GpuProfiler::Scope::~Scope()
+{
+    _r_profiler.end(_commandBuffer);
+}
+
+
+GpuProfiler::GpuProfiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                         std::size_t framesInFlight)
+    : GpuProfiler(rp_device, framesInFlight, Settings())
+{
+}
+
+
+GpuProfiler::GpuProfiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                         std::size_t framesInFlight,
+                         const Settings& r_settings)
+    : _p_device(rp_device),
+      _device(rp_device->getDevice()),
+      _settings(r_settings),
+      _queryPool(VK_NULL_HANDLE),
+      _frames(framesInFlight),
+      _i_frame(0),
+      _isRecording(false),
+      _openScopes(),
+      _histories(),
+      _historyIndices(),
+      _timestampPeriod(0.0),
+      _timestampMask(0)
+{
+    if (framesInFlight == 0) {
+        throw std::runtime_error("GPU profiler requires at least one frame in flight");
+    }
+
+    if (_settings.scopesPerFrame == 0 || _settings.historySize == 0) {
+        throw std::runtime_error("GPU profiler requires room for at least one scope and sample");
+    }
+
+    // Timestamps are only supported if the queue family has valid bits
+    const auto& r_physicalDevice = _p_device->getPhysicalDevice();
+    const uint32_t i_family = r_physicalDevice.getQueueFamily({}).graphics.value();
+
+    const uint32_t validBits = r_physicalDevice.getCapabilities().queueFamilies.at(i_family).timestampValidBits;
+    if (validBits == 0) {
+        return;
+    }
+    _timestampMask = validBits < 64 ? (uint64_t(1) << validBits) - 1 : std::numeric_limits<uint64_t>::max();
+    _timestampPeriod = r_physicalDevice.getProperties().limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    info.queryCount = static_cast<uint32_t>(2 * _settings.scopesPerFrame * _frames.size());
+    if (vkCreateQueryPool(_device, &info, _p_device->getAllocationCallbacks(), &_queryPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create timestamp query pool");
+    }
+}
+
+
+GpuProfiler::~GpuProfiler()
+{
+    if (_queryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(_device, _queryPool, _p_device->getAllocationCallbacks());
+    }
+}
+
+
+void GpuProfiler::beginFrame(VkCommandBuffer commandBuffer)
+{
+    if (!this->isSupported()) {
+        return;
+    }
+
+    if (!_openScopes.empty()) {
+        throw std::runtime_error("GPU profiler scopes must end in the frame they began in");
+    }
+
+    _i_frame = (_i_frame + 1) % _frames.size();
+    this->collect(_i_frame);
+
+    const uint32_t queriesPerFrame = 2 * _settings.scopesPerFrame;
+    vkCmdResetQueryPool(commandBuffer,
+                        _queryPool,
+                        static_cast<uint32_t>(_i_frame) * queriesPerFrame,
+                        queriesPerFrame);
+    _isRecording = true;
+}
+
+
+void GpuProfiler::begin(VkCommandBuffer commandBuffer, std::string_view name)
+{
+    if (!this->isSupported()) {
+        return;
+    }
+
+    if (!_isRecording) {
+        throw std::runtime_error("GPU profiler scopes require a call to beginFrame first");
+    }
+
+    Frame& r_frame = _frames[_i_frame];
+    Record record {this->getHistoryIndex(name), std::numeric_limits<uint32_t>::max()};
+
+    // Scopes beyond the frame's capacity are tracked, but not measured
+    if (r_frame.queryCount + 2 <= 2 * _settings.scopesPerFrame) {
+        record.i_query = static_cast<uint32_t>(_i_frame) * 2 * _settings.scopesPerFrame + r_frame.queryCount;
+        r_frame.queryCount += 2;
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPool, record.i_query);
+    }
+
+    _openScopes.push_back(record);
+}
+
+
+void GpuProfiler::end(VkCommandBuffer commandBuffer)
+{
+    if (!this->isSupported()) {
+        return;
+    }
+
+    if (_openScopes.empty()) {
+        throw std::runtime_error("No open GPU profiler scope to end");
+    }
+
+    const Record record = _openScopes.back();
+    _openScopes.pop_back();
+
+    if (record.i_query != std::numeric_limits<uint32_t>::max()) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPool, record.i_query + 1);
+        _frames[_i_frame].records.push_back(record);
+    }
+}
+
+
+std::vector<GpuProfiler::Result> GpuProfiler::getResults() const
+{
+    std::vector<Result> results;
+    results.reserve(_histories.size());
+
+    std::vector<double> sorted;
+    for (const History& r_history : _histories) {
+        Result result;
+        result.name = r_history.name;
+        result.sampleCount = r_history.samples.size();
+
+        if (!r_history.samples.empty()) {
+            sorted = r_history.samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            // Nearest-rank percentile
+            const std::size_t i_p99 = static_cast<std::size_t>(std::ceil(0.99 * sorted.size())) - 1;
+
+            result.last = r_history.last;
+            result.min = sorted.front();
+            result.average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+            result.max = sorted.back();
+            result.p99 = sorted[i_p99];
+        }
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+
+void GpuProfiler::writeCSV(std::ostream& r_stream) const
+{
+    r_stream << "scope,samples,last_ms,min_ms,avg_ms,max_ms,p99_ms\n";
+    for (const Result& r_result : this->getResults()) {
+        r_stream << escapeCSV(r_result.name) << ','
+                 << r_result.sampleCount << ','
+                 << r_result.last << ','
+                 << r_result.min << ','
+                 << r_result.average << ','
+                 << r_result.max << ','
+                 << r_result.p99 << '\n';
+    }
+}
+
+
+bool GpuProfiler::isSupported() const noexcept
+{
+    return _queryPool != VK_NULL_HANDLE;
+}
+
+
+std::size_t GpuProfiler::getFramesInFlight() const noexcept
+{
+    return _frames.size();
+}
+
+
+void GpuProfiler::collect(std::size_t i_frame)
+{
+    Frame& r_frame = _frames[i_frame];
+    if (r_frame.records.empty()) {
+        r_frame.queryCount = 0;
+        return;
+    }
+
+    // The device is done with the slot, so the results are available without waiting
+    const uint32_t i_first = static_cast<uint32_t>(i_frame) * 2 * _settings.scopesPerFrame;
+    std::vector<uint64_t> timestamps(r_frame.queryCount);
+    const VkResult result = vkGetQueryPoolResults(_device,
+                                                  _queryPool,
+                                                  i_first,
+                                                  r_frame.queryCount,
+                                                  timestamps.size() * sizeof(uint64_t),
+                                                  timestamps.data(),
+                                                  sizeof(uint64_t),
+                                                  VK_QUERY_RESULT_64_BIT);
+
+    if (result == VK_SUCCESS) {
+        for (const Record& r_record : r_frame.records) {
+            const uint64_t begin = timestamps[r_record.i_query - i_first];
+            const uint64_t end = timestamps[r_record.i_query - i_first + 1];
+            const double duration = 1e-6 * _timestampPeriod * static_cast<double>((end - begin) & _timestampMask);
+
+            History& r_history = _histories[r_record.i_history];
+            if (r_history.samples.size() < _settings.historySize) {
+                r_history.samples.push_back(duration);
+            } else {
+                r_history.samples[r_history.i_next] = duration;
+                r_history.i_next = (r_history.i_next + 1) % r_history.samples.size();
+            }
+            r_history.last = duration;
+        }
+    } else if (result != VK_NOT_READY) {
+        throw std::runtime_error("Failed to read timestamp queries");
+    }
+
+    r_frame.records.clear();
+    r_frame.queryCount = 0;
+}
+
+
+std::size_t GpuProfiler::getHistoryIndex(std::string_view name)
+{
+    const std::string key(name);
+    const auto it_index = _historyIndices.find(key);
+    if (it_index != _historyIndices.end()) {
+        return it_index->second;
+    }
+
+    _histories.push_back(History {key, {}, 0, 0.0});
+    _histories.back().samples.reserve(_settings.historySize);
+    _historyIndices.emplace(key, _histories.size() - 1);
+    return _histories.size() - 1;
+}
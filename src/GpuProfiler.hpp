@@ -0,0 +1,180 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+/// @brief Measures the GPU time spent in named regions of command buffers.
+/// @details Every frame in flight owns a range of queries in a single timestamp query pool.
+///          Scopes write a timestamp into the frame's range when they begin and end. The
+///          results are read back by @ref beginFrame when the frame slot comes around again,
+///          by which point the device is done with it, so reading them never stalls.
+///
+///          Durations are converted to milliseconds with @a VkPhysicalDeviceLimits::timestampPeriod
+///          and kept per scope name in a rolling window, from which @ref getResults computes
+///          the minimum, average, maximum and 99th percentile.
+/// @note Not thread safe. Scopes may be nested, but each has to end in the command buffer it began in.
+class GpuProfiler
+{
+public:
+    struct Settings
+    {
+        /// @brief Maximum number of scopes per frame; further scopes are not measured.
+        uint32_t scopesPerFrame = 64;
+
+        /// @brief Number of most recent samples per scope that statistics are computed from.
+        std::size_t historySize = 256;
+    }; // struct Settings
+
+    /// @brief Rolling statistics of a scope, in milliseconds.
+    struct Result
+    {
+        std::string name;
+
+        /// @brief Number of samples the statistics are computed from.
+        std::size_t sampleCount = 0;
+
+        double last = 0.0;
+
+        double min = 0.0;
+
+        double average = 0.0;
+
+        double max = 0.0;
+
+        double p99 = 0.0;
+    }; // struct Result
+
+    /// @brief Begins a scope on construction and ends it on destruction.
+    class Scope
+    {
+    public:
+        Scope(GpuProfiler& r_profiler,
+              VkCommandBuffer commandBuffer,
+              std::string_view name);
+
+        Scope(const Scope&) = delete;
+
+        ~Scope();
+
+    private:
+        GpuProfiler& _r_profiler;
+
+        VkCommandBuffer _commandBuffer;
+    }; // class Scope
+
+public:
+    GpuProfiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                std::size_t framesInFlight);
+
+    GpuProfiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                std::size_t framesInFlight,
+                const Settings& r_settings);
+
+    GpuProfiler(const GpuProfiler&) = delete;
+
+    ~GpuProfiler();
+
+    /// @brief Move on to the next frame slot, collect its previous results and reset its queries.
+    /// @details Has to be recorded into the frame's command buffer before any scope, outside of
+    ///          a render pass. The caller must make sure the device is done with the slot's
+    ///          previous frame, for example by calling this from a @ref FrameLoop::Recorder of
+    ///          a loop with the same number of frames in flight.
+    void beginFrame(VkCommandBuffer commandBuffer);
+
+    /// @brief Write a timestamp marking the beginning of a scope.
+    void begin(VkCommandBuffer commandBuffer, std::string_view name);
+
+    /// @brief Write a timestamp marking the end of the innermost open scope.
+    void end(VkCommandBuffer commandBuffer);
+
+    /// @brief Get the rolling statistics of every scope measured so far.
+    std::vector<Result> getResults() const;
+
+    /// @brief Write @ref getResults as comma separated values, with a header line.
+    void writeCSV(std::ostream& r_stream) const;
+
+    /// @brief Check whether the graphics queue supports timestamps.
+    /// @details Scopes are silently ignored if it doesn't.
+    bool isSupported() const noexcept;
+
+    std::size_t getFramesInFlight() const noexcept;
+
+private:
+    /// @brief Scope recorded in a frame, waiting for its timestamps.
+    struct Record
+    {
+        std::size_t i_history;
+
+        /// @brief Index of the begin query; the end query follows it.
+        uint32_t i_query;
+    }; // struct Record
+
+    struct Frame
+    {
+        std::vector<Record> records;
+
+        /// @brief Number of queries written in the frame.
+        uint32_t queryCount;
+    }; // struct Frame
+
+    /// @brief Rolling window of durations of a single scope [ms].
+    struct History
+    {
+        std::string name;
+
+        std::vector<double> samples;
+
+        /// @brief Index of the oldest sample once the window is full.
+        std::size_t i_next;
+
+        double last;
+    }; // struct History
+
+    /// @brief Read back the timestamps of a frame slot and append them to the histories.
+    void collect(std::size_t i_frame);
+
+    std::size_t getHistoryIndex(std::string_view name);
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkDevice _device;
+
+    Settings _settings;
+
+    VkQueryPool _queryPool;
+
+    std::vector<Frame> _frames;
+
+    std::size_t _i_frame;
+
+    /// @brief Set once @ref beginFrame was called, since queries must be reset before use.
+    bool _isRecording;
+
+    /// @brief Records of open scopes, innermost last; scopes that didn't fit have no query.
+    std::vector<Record> _openScopes;
+
+    std::vector<History> _histories;
+
+    std::unordered_map<std::string,std::size_t> _historyIndices;
+
+    /// @brief Nanoseconds per timestamp tick.
+    double _timestampPeriod;
+
+    /// @brief Mask of the valid bits of timestamps, zero if timestamps aren't supported.
+    uint64_t _timestampMask;
+}; // class GpuProfiler
@@ -0,0 +1,465 @@
+// --- Internal Includes ---
+#include "HostAllocator.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+
+namespace {
+
+
+constexpr std::size_t sizeClassCount = std::countr_zero(HostAllocator::maxBlockSize)
+                                       - std::countr_zero(HostAllocator::minBlockSize)
+                                       + 1;
+
+
+/// @brief Size class of allocations served by @a malloc.
+constexpr uint8_t largeClass = 0xff;
+
+
+static_assert(std::has_single_bit(HostAllocator::minBlockSize) && std::has_single_bit(HostAllocator::maxBlockSize),
+              "Size classes are powers of 2");
+
+
+void updateMax(std::atomic<std::size_t>& r_maximum, std::size_t value) noexcept
+{
+    std::size_t current = r_maximum.load(std::memory_order_relaxed);
+    while (current < value && !r_maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+
+} // unnamed namespace
+
+
+/// @brief Precedes every allocation.
+struct HostAllocator::Header
+{
+    /// @brief Distance from the start of the block to the allocation.
+    uint32_t offset;
+
+    uint8_t scope;
+
+    /// @brief Index of the pool the block belongs to, or @ref largeClass.
+    uint8_t sizeClass;
+
+    /// @brief Alignment the allocation was made with, as a power of 2.
+    uint16_t alignmentLog2;
+
+    /// @brief Size requested by the implementation.
+    uint64_t size;
+}; // struct HostAllocator::Header
+
+
+struct HostAllocator::Pool
+{
+    std::mutex mutex;
+
+    /// @brief Singly linked list of free blocks, threaded through their first bytes.
+    void* p_free = nullptr;
+
+    std::vector<void*> chunks;
+}; // struct HostAllocator::Pool
+
+
+struct HostAllocator::Arena
+{
+    std::array<Pool,sizeClassCount> pools;
+
+    std::atomic<std::size_t> allocationCount {0};
+
+    std::atomic<std::size_t> bytes {0};
+
+    std::atomic<std::size_t> peakBytes {0};
+
+    std::atomic<std::size_t> allocateCalls {0};
+
+    std::atomic<std::size_t> reallocateCalls {0};
+
+    std::atomic<std::size_t> freeCalls {0};
+
+    std::atomic<std::size_t> internalBytes {0};
+}; // struct HostAllocator::Arena
+
+
+std::size_t HostAllocator::Statistics::getBytes() const noexcept
+{
+    std::size_t bytes = 0;
+    for (const auto& r_scope : scopes) {
+        bytes += r_scope.bytes;
+    }
+    return bytes;
+}
+
+
+std::size_t HostAllocator::Statistics::getAllocationCount() const noexcept
+{
+    std::size_t count = 0;
+    for (const auto& r_scope : scopes) {
+        count += r_scope.allocationCount;
+    }
+    return count;
+}
+
+
+HostAllocator::HostAllocator()
+    : HostAllocator(Settings())
+{
+}
+
+
+HostAllocator::HostAllocator(const Settings& r_settings)
+    : _settings(r_settings),
+      _callbacks(),
+      _arenas(std::make_unique<Arena[]>(scopeCount)),
+      _reservedBytes(0),
+      _peakReservedBytes(0),
+      _chunkCount(0),
+      _largeCount(0),
+      _inPlaceCount(0),
+      _failedCount(0)
+{
+    static_assert(sizeof(Header) == 16, "Headers keep allocations 16 byte aligned");
+
+    _callbacks.pUserData = this;
+    _callbacks.pfnAllocation = HostAllocator::allocateCallback;
+    _callbacks.pfnReallocation = HostAllocator::reallocateCallback;
+    _callbacks.pfnFree = HostAllocator::freeCallback;
+    _callbacks.pfnInternalAllocation = HostAllocator::internalAllocationCallback;
+    _callbacks.pfnInternalFree = HostAllocator::internalFreeCallback;
+}
+
+
+HostAllocator::~HostAllocator()
+{
+    for (std::size_t i_arena=0; i_arena<scopeCount; ++i_arena) {
+        for (Pool& r_pool : _arenas[i_arena].pools) {
+            for (void* p_chunk : r_pool.chunks) {
+                std::free(p_chunk);
+            }
+        }
+    }
+}
+
+
+const VkAllocationCallbacks* HostAllocator::getCallbacks() const noexcept
+{
+    return &_callbacks;
+}
+
+
+void* HostAllocator::allocate(std::size_t size,
+                              std::size_t alignment,
+                              VkSystemAllocationScope scope) noexcept
+{
+    Arena& r_arena = this->getArena(scope);
+    r_arena.allocateCalls.fetch_add(1, std::memory_order_relaxed);
+    return this->allocateFrom(r_arena, size, alignment);
+}
+
+
+void* HostAllocator::reallocate(void* p_original,
+                                std::size_t size,
+                                std::size_t alignment,
+                                VkSystemAllocationScope scope) noexcept
+{
+    Arena& r_arena = this->getArena(scope);
+    r_arena.reallocateCalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (!p_original) {
+        return this->allocateFrom(r_arena, size, alignment);
+    } else if (size == 0) {
+        this->deallocate(p_original);
+        return nullptr;
+    }
+
+    // Keep the block if it's in the same arena, large enough and aligned well enough
+    Header& r_header = *reinterpret_cast<Header*>(static_cast<std::byte*>(p_original) - sizeof(Header));
+    if (r_header.sizeClass != largeClass
+        && &this->getArena(static_cast<VkSystemAllocationScope>(r_header.scope)) == &r_arena
+        && reinterpret_cast<std::uintptr_t>(p_original) % std::max(alignment, std::size_t(1)) == 0
+        && r_header.offset + size <= (minBlockSize << r_header.sizeClass)) {
+        if (r_header.size < size) {
+            const std::size_t growth = size - r_header.size;
+            updateMax(r_arena.peakBytes, r_arena.bytes.fetch_add(growth, std::memory_order_relaxed) + growth);
+        } else {
+            r_arena.bytes.fetch_sub(r_header.size - size, std::memory_order_relaxed);
+        }
+        r_header.size = size;
+        _inPlaceCount.fetch_add(1, std::memory_order_relaxed);
+        return p_original;
+    }
+
+    void* p_reallocated = this->allocateFrom(r_arena, size, alignment);
+    if (p_reallocated) {
+        std::memcpy(p_reallocated, p_original, std::min<std::size_t>(size, r_header.size));
+        this->deallocate(p_original);
+    }
+    return p_reallocated;
+}
+
+
+void HostAllocator::free(void* p_memory) noexcept
+{
+    if (p_memory) {
+        const Header& r_header = *reinterpret_cast<const Header*>(static_cast<std::byte*>(p_memory) - sizeof(Header));
+        this->getArena(static_cast<VkSystemAllocationScope>(r_header.scope)).freeCalls.fetch_add(1, std::memory_order_relaxed);
+        this->deallocate(p_memory);
+    }
+}
+
+
+HostAllocator::Statistics HostAllocator::getStatistics() const noexcept
+{
+    Statistics statistics;
+    for (std::size_t i_arena=0; i_arena<scopeCount; ++i_arena) {
+        const Arena& r_arena = _arenas[i_arena];
+        ScopeStatistics& r_scope = statistics.scopes[i_arena];
+        r_scope.allocationCount = r_arena.allocationCount.load(std::memory_order_relaxed);
+        r_scope.bytes = r_arena.bytes.load(std::memory_order_relaxed);
+        r_scope.peakBytes = r_arena.peakBytes.load(std::memory_order_relaxed);
+        r_scope.allocateCalls = r_arena.allocateCalls.load(std::memory_order_relaxed);
+        r_scope.reallocateCalls = r_arena.reallocateCalls.load(std::memory_order_relaxed);
+        r_scope.freeCalls = r_arena.freeCalls.load(std::memory_order_relaxed);
+        r_scope.internalBytes = r_arena.internalBytes.load(std::memory_order_relaxed);
+    }
+    statistics.reservedBytes = _reservedBytes.load(std::memory_order_relaxed);
+    statistics.peakReservedBytes = _peakReservedBytes.load(std::memory_order_relaxed);
+    statistics.chunkCount = _chunkCount.load(std::memory_order_relaxed);
+    statistics.largeCount = _largeCount.load(std::memory_order_relaxed);
+    statistics.inPlaceCount = _inPlaceCount.load(std::memory_order_relaxed);
+    statistics.failedCount = _failedCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
+const HostAllocator::Settings& HostAllocator::getSettings() const noexcept
+{
+    return _settings;
+}
+
+
+std::string_view HostAllocator::getScopeName(VkSystemAllocationScope scope) noexcept
+{
+    switch (scope) {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "command";
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "object";
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "cache";
+        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "device";
+        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "instance";
+        default: return "unknown";
+    }
+}
+
+
+void* HostAllocator::allocateFrom(Arena& r_arena,
+                                  std::size_t size,
+                                  std::size_t alignment) noexcept
+{
+    if (size == 0) {
+        return nullptr;
+    }
+
+    // The header fits in front of the allocation within the first alignment bytes of the
+    // block, since blocks start 16 byte aligned.
+    alignment = std::max(alignment, sizeof(Header));
+    if (!std::has_single_bit(alignment) || std::numeric_limits<uint32_t>::max() < alignment) {
+        _failedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    const std::size_t requiredSize = alignment + size;
+
+    std::size_t i_sizeClass = largeClass;
+    std::size_t blockSize = requiredSize;
+    if (size <= maxBlockSize && requiredSize <= maxBlockSize) {
+        blockSize = std::bit_ceil(std::max(requiredSize, minBlockSize));
+        i_sizeClass = std::countr_zero(blockSize) - std::countr_zero(minBlockSize);
+    }
+
+    auto* p_block = static_cast<std::byte*>(this->allocateBlock(r_arena, i_sizeClass, blockSize));
+    if (!p_block) {
+        _failedCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    const auto blockAddress = reinterpret_cast<std::uintptr_t>(p_block);
+    const std::uintptr_t address = (blockAddress + sizeof(Header) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+    std::byte* p_memory = p_block + (address - blockAddress);
+
+    Header& r_header = *reinterpret_cast<Header*>(p_memory - sizeof(Header));
+    r_header.offset = static_cast<uint32_t>(address - blockAddress);
+    r_header.scope = static_cast<uint8_t>(&r_arena - _arenas.get());
+    r_header.sizeClass = static_cast<uint8_t>(i_sizeClass);
+    r_header.alignmentLog2 = static_cast<uint16_t>(std::countr_zero(alignment));
+    r_header.size = size;
+
+    r_arena.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    updateMax(r_arena.peakBytes, r_arena.bytes.fetch_add(size, std::memory_order_relaxed) + size);
+    return p_memory;
+}
+
+
+void HostAllocator::deallocate(void* p_memory) noexcept
+{
+    const Header header = *reinterpret_cast<const Header*>(static_cast<std::byte*>(p_memory) - sizeof(Header));
+    Arena& r_arena = _arenas[header.scope];
+    r_arena.allocationCount.fetch_sub(1, std::memory_order_relaxed);
+    r_arena.bytes.fetch_sub(header.size, std::memory_order_relaxed);
+
+    const std::size_t blockSize = header.sizeClass == largeClass
+                                  ? (std::size_t(1) << header.alignmentLog2) + header.size
+                                  : minBlockSize << header.sizeClass;
+    this->freeBlock(r_arena,
+                    header.sizeClass,
+                    static_cast<std::byte*>(p_memory) - header.offset,
+                    blockSize);
+}
+
+
+bool HostAllocator::reserve(std::size_t byteCount) noexcept
+{
+    std::size_t reserved = _reservedBytes.load(std::memory_order_relaxed);
+    do {
+        if (_settings.maxBytes && _settings.maxBytes - std::min(reserved, _settings.maxBytes) < byteCount) {
+            return false;
+        }
+    } while (!_reservedBytes.compare_exchange_weak(reserved, reserved + byteCount, std::memory_order_relaxed));
+
+    updateMax(_peakReservedBytes, reserved + byteCount);
+    return true;
+}
+
+
+void HostAllocator::release(std::size_t byteCount) noexcept
+{
+    _reservedBytes.fetch_sub(byteCount, std::memory_order_relaxed);
+}
+
+
+void* HostAllocator::allocateBlock(Arena& r_arena,
+                                   std::size_t i_sizeClass,
+                                   std::size_t blockSize) noexcept
+{
+    if (i_sizeClass == largeClass) {
+        if (!this->reserve(blockSize)) {
+            return nullptr;
+        }
+        void* p_block = std::malloc(blockSize);
+        if (!p_block) {
+            this->release(blockSize);
+            return nullptr;
+        }
+        _largeCount.fetch_add(1, std::memory_order_relaxed);
+        return p_block;
+    }
+
+    Pool& r_pool = r_arena.pools[i_sizeClass];
+    std::scoped_lock<std::mutex> lock(r_pool.mutex);
+
+    if (!r_pool.p_free) {
+        // Carve a new chunk into blocks
+        const std::size_t blockCount = std::max<std::size_t>(_settings.chunkSize / blockSize, 1);
+        const std::size_t chunkSize = blockCount * blockSize;
+        if (!this->reserve(chunkSize)) {
+            return nullptr;
+        }
+        auto* p_chunk = static_cast<std::byte*>(std::malloc(chunkSize));
+        if (!p_chunk) {
+            this->release(chunkSize);
+            return nullptr;
+        }
+        try {
+            r_pool.chunks.push_back(p_chunk);
+        } catch (...) {
+            std::free(p_chunk);
+            this->release(chunkSize);
+            return nullptr;
+        }
+        _chunkCount.fetch_add(1, std::memory_order_relaxed);
+
+        for (std::size_t i_block=blockCount; 0<i_block; --i_block) {
+            void* p_block = p_chunk + (i_block - 1) * blockSize;
+            *static_cast<void**>(p_block) = r_pool.p_free;
+            r_pool.p_free = p_block;
+        }
+    }
+
+    void* p_block = r_pool.p_free;
+    r_pool.p_free = *static_cast<void**>(p_block);
+    return p_block;
+}
+
+
+void HostAllocator::freeBlock(Arena& r_arena,
+                              std::size_t i_sizeClass,
+                              void* p_block,
+                              std::size_t blockSize) noexcept
+{
+    if (i_sizeClass == largeClass) {
+        std::free(p_block);
+        this->release(blockSize);
+        _largeCount.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Pool& r_pool = r_arena.pools[i_sizeClass];
+    std::scoped_lock<std::mutex> lock(r_pool.mutex);
+    *static_cast<void**>(p_block) = r_pool.p_free;
+    r_pool.p_free = p_block;
+}
+
+
+HostAllocator::Arena& HostAllocator::getArena(VkSystemAllocationScope scope) noexcept
+{
+    // Unknown scopes end up in the longest lived arena
+    return _arenas[std::min<std::size_t>(static_cast<std::size_t>(scope), scopeCount - 1)];
+}
+
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::allocateCallback(void* p_userData,
+                                                            std::size_t size,
+                                                            std::size_t alignment,
+                                                            VkSystemAllocationScope scope)
+{
+    return static_cast<HostAllocator*>(p_userData)->allocate(size, alignment, scope);
+}
+
+
+VKAPI_ATTR void* VKAPI_CALL HostAllocator::reallocateCallback(void* p_userData,
+                                                              void* p_original,
+                                                              std::size_t size,
+                                                              std::size_t alignment,
+                                                              VkSystemAllocationScope scope)
+{
+    return static_cast<HostAllocator*>(p_userData)->reallocate(p_original, size, alignment, scope);
+}
+
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::freeCallback(void* p_userData,
+                                                       void* p_memory)
+{
+    static_cast<HostAllocator*>(p_userData)->free(p_memory);
+}
+
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::internalAllocationCallback(void* p_userData,
+                                                                     std::size_t size,
+                                                                     VkInternalAllocationType,
+                                                                     VkSystemAllocationScope scope)
+{
+    static_cast<HostAllocator*>(p_userData)->getArena(scope).internalBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+
+VKAPI_ATTR void VKAPI_CALL HostAllocator::internalFreeCallback(void* p_userData,
+                                                               std::size_t size,
+                                                               VkInternalAllocationType,
+                                                               VkSystemAllocationScope scope)
+{
+    static_cast<HostAllocator*>(p_userData)->getArena(scope).internalBytes.fetch_sub(size, std::memory_order_relaxed);
+}
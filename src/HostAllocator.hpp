@@ -0,0 +1,229 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- STL Includes ---
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+
+/// @brief Host memory allocator for Vulkan implementations, plugged in through @a VkAllocationCallbacks.
+/// @details Every @a VkSystemAllocationScope gets an arena of its own, so that short lived
+///          command scope allocations never interleave with long lived object or device scope
+///          ones. Each arena serves small allocations from pools of fixed size blocks, one pool
+///          per power of two size class from @ref minBlockSize to @ref maxBlockSize. Pools carve
+///          their blocks out of chunks of @ref Settings::chunkSize bytes and keep freed blocks
+///          on a free list, so steady state allocation never reaches @a malloc. Larger
+///          allocations go to @a malloc directly.
+///
+///          Every allocation is preceded by a header that records its arena, size class and
+///          size, so that it can be freed or reallocated without a lookup. Alignments above 16
+///          bytes are honored by offsetting the allocation within its block. Reallocations stay
+///          in place if the block is large enough and already satisfies the new alignment.
+///
+///          Chunks are only returned to the system on destruction. @ref Settings::maxBytes bounds
+///          the memory taken from the system; allocations beyond it fail, which Vulkan reports as
+///          @a VK_ERROR_OUT_OF_HOST_MEMORY.
+/// @note Thread safe; every pool has a mutex of its own. The allocator must outlive every
+///       object created with its callbacks.
+class HostAllocator
+{
+public:
+    struct Settings
+    {
+        /// @brief Bytes a pool requests from the system at once.
+        std::size_t chunkSize = std::size_t(64) << 10;
+
+        /// @brief Upper bound on the bytes taken from the system; 0 for no bound.
+        std::size_t maxBytes = 0;
+    }; // struct Settings
+
+    /// @brief Number of @a VkSystemAllocationScope values, one arena each.
+    static constexpr std::size_t scopeCount = 5;
+
+    static constexpr std::size_t minBlockSize = 32;
+
+    static constexpr std::size_t maxBlockSize = 8192;
+
+    /// @brief Counters of an arena; bytes are the sizes requested by the implementation.
+    struct ScopeStatistics
+    {
+        /// @brief Number of live allocations.
+        std::size_t allocationCount = 0;
+
+        /// @brief Bytes in live allocations.
+        std::size_t bytes = 0;
+
+        /// @brief Maximum of @ref bytes so far.
+        std::size_t peakBytes = 0;
+
+        /// @brief Number of calls to the allocation callback.
+        std::size_t allocateCalls = 0;
+
+        /// @brief Number of calls to the reallocation callback.
+        std::size_t reallocateCalls = 0;
+
+        /// @brief Number of calls to the free callback.
+        std::size_t freeCalls = 0;
+
+        /// @brief Bytes the implementation reported allocating on its own (e.g. executable memory).
+        std::size_t internalBytes = 0;
+    }; // struct ScopeStatistics
+
+    struct Statistics
+    {
+        /// @brief Counters of each arena, indexed by @a VkSystemAllocationScope.
+        std::array<ScopeStatistics,scopeCount> scopes {};
+
+        /// @brief Bytes taken from the system, in chunks and large allocations.
+        std::size_t reservedBytes = 0;
+
+        /// @brief Maximum of @ref reservedBytes so far.
+        std::size_t peakReservedBytes = 0;
+
+        /// @brief Number of chunks taken from the system.
+        std::size_t chunkCount = 0;
+
+        /// @brief Number of live allocations too large for the pools.
+        std::size_t largeCount = 0;
+
+        /// @brief Number of reallocations that kept their block.
+        std::size_t inPlaceCount = 0;
+
+        /// @brief Number of allocations that failed, because of @ref Settings::maxBytes or the system.
+        std::size_t failedCount = 0;
+
+        /// @brief Get the bytes in live allocations over all arenas.
+        std::size_t getBytes() const noexcept;
+
+        /// @brief Get the number of live allocations over all arenas.
+        std::size_t getAllocationCount() const noexcept;
+    }; // struct Statistics
+
+public:
+    HostAllocator();
+
+    HostAllocator(const Settings& r_settings);
+
+    HostAllocator(const HostAllocator&) = delete;
+
+    /// @brief Return all chunks to the system.
+    ~HostAllocator();
+
+    /// @brief Get callbacks to pass to Vulkan create and destroy functions.
+    /// @details The pointer stays valid for the lifetime of the allocator.
+    const VkAllocationCallbacks* getCallbacks() const noexcept;
+
+    /// @name Allocation
+    /// @details Follow the semantics of @a PFN_vkAllocationFunction and friends;
+    ///          failures return nullptr instead of throwing.
+    /// @{
+
+    void* allocate(std::size_t size,
+                   std::size_t alignment,
+                   VkSystemAllocationScope scope) noexcept;
+
+    /// @brief Resize an allocation, preserving its contents up to the smaller size.
+    /// @details Reallocating nullptr allocates, reallocating to 0 bytes frees. If the
+    ///          reallocation fails, the original allocation is left untouched.
+    void* reallocate(void* p_original,
+                     std::size_t size,
+                     std::size_t alignment,
+                     VkSystemAllocationScope scope) noexcept;
+
+    void free(void* p_memory) noexcept;
+
+    /// @}
+
+    Statistics getStatistics() const noexcept;
+
+    const Settings& getSettings() const noexcept;
+
+    static std::string_view getScopeName(VkSystemAllocationScope scope) noexcept;
+
+private:
+    struct Header;
+
+    struct Pool;
+
+    struct Arena;
+
+    void* allocateFrom(Arena& r_arena,
+                       std::size_t size,
+                       std::size_t alignment) noexcept;
+
+    /// @brief Free an allocation without counting a call.
+    void deallocate(void* p_memory) noexcept;
+
+    /// @brief Take bytes from the system budget.
+    /// @return false if that would exceed @ref Settings::maxBytes.
+    bool reserve(std::size_t byteCount) noexcept;
+
+    void release(std::size_t byteCount) noexcept;
+
+    /// @brief Get a block of a size class from an arena, or from the system if it is too large.
+    /// @return the start of the block, or nullptr on failure.
+    void* allocateBlock(Arena& r_arena,
+                        std::size_t i_sizeClass,
+                        std::size_t blockSize) noexcept;
+
+    void freeBlock(Arena& r_arena,
+                   std::size_t i_sizeClass,
+                   void* p_block,
+                   std::size_t blockSize) noexcept;
+
+    Arena& getArena(VkSystemAllocationScope scope) noexcept;
+
+    /// @name Callbacks
+    /// @{
+
+    static VKAPI_ATTR void* VKAPI_CALL allocateCallback(void* p_userData,
+                                                        std::size_t size,
+                                                        std::size_t alignment,
+                                                        VkSystemAllocationScope scope);
+
+    static VKAPI_ATTR void* VKAPI_CALL reallocateCallback(void* p_userData,
+                                                          void* p_original,
+                                                          std::size_t size,
+                                                          std::size_t alignment,
+                                                          VkSystemAllocationScope scope);
+
+    static VKAPI_ATTR void VKAPI_CALL freeCallback(void* p_userData,
+                                                   void* p_memory);
+
+    static VKAPI_ATTR void VKAPI_CALL internalAllocationCallback(void* p_userData,
+                                                                 std::size_t size,
+                                                                 VkInternalAllocationType type,
+                                                                 VkSystemAllocationScope scope);
+
+    static VKAPI_ATTR void VKAPI_CALL internalFreeCallback(void* p_userData,
+                                                           std::size_t size,
+                                                           VkInternalAllocationType type,
+                                                           VkSystemAllocationScope scope);
+
+    /// @}
+
+private:
+    Settings _settings;
+
+    VkAllocationCallbacks _callbacks;
+
+    std::unique_ptr<Arena[]> _arenas;
+
+    std::atomic<std::size_t> _reservedBytes;
+
+    std::atomic<std::size_t> _peakReservedBytes;
+
+    std::atomic<std::size_t> _chunkCount;
+
+    std::atomic<std::size_t> _largeCount;
+
+    std::atomic<std::size_t> _inPlaceCount;
+
+    std::atomic<std::size_t> _failedCount;
+}; // class HostAllocator
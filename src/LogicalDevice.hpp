@@ -10,22 +10,87 @@
 // --- Internal Includes ---
 #include "utilities.hpp"
 #include "PhysicalDevice.hpp"
+#include "ShaderModuleCache.hpp"
+#include "DeviceAllocator.hpp"
+#include "HostAllocator.hpp"
 
 // --- STL Includes ---
 #include <unordered_set>
 #include <span>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <array>
+#include <optional>
+#include <vector>
 
 
 class LogicalDevice
 {
+public:
+    /// @brief Kind of work a queue is used for.
+    /// @details Compute and transfer queues come from dedicated families if the device has
+    ///          them, so that their work overlaps with graphics. Otherwise they are the
+    ///          graphics queues.
+    ///
+    ///          Presentation queues come from the family that presents to the surface the
+    ///          device was created for. They are the queues of another type if that type uses
+    ///          the same family, and the graphics queues if the device has no surface.
+    enum class QueueType
+    {
+        Graphics,
+        Compute,
+        Transfer,
+        Presentation
+    }; // enum class QueueType
+
+    /// @brief Priorities of the queues to create for each @ref QueueType.
+    /// @details One queue is created per priority, up to the number of queues in the family.
+    ///          Priorities are in [0, 1]. Types without a dedicated family share the
+    ///          graphics queues, and their priorities are ignored.
+    struct QueueSettings
+    {
+        std::vector<float> graphics = {1.0f};
+
+        std::vector<float> compute = {1.0f};
+
+        std::vector<float> transfer = {1.0f};
+
+        std::vector<float> presentation = {1.0f};
+    }; // struct QueueSettings
+
 public:
     LogicalDevice()
         : _device(VK_NULL_HANDLE),
-          _p_physicalDevice()
+          _queue(VK_NULL_HANDLE),
+          _queues(),
+          _queueFamilies(),
+          _extensions(),
+          _features(),
+          _p_physicalDevice(),
+          _p_shaderModuleCache(),
+          _p_allocator(),
+          _p_hostAllocator()
     {
     }
 
     LogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice)
+        : LogicalDevice(rp_physicalDevice, QueueSettings())
+    {
+    }
+
+    LogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
+                  const QueueSettings& r_queueSettings)
+        : LogicalDevice(rp_physicalDevice, r_queueSettings, nullptr)
+    {
+    }
+
+    /// @param rp_hostAllocator host allocator for the device and its children; nullptr for the implementation's own.
+    LogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
+                  const QueueSettings& r_queueSettings,
+                  const std::shared_ptr<HostAllocator>& rp_hostAllocator)
         : LogicalDevice(rp_physicalDevice,
                         [](){
                             std::vector<PhysicalDevice::Feature> features;
@@ -36,14 +101,19 @@ public:
                             std::vector<const char*> extensions;
                             LogicalDevice::getRequiredExtensions(std::back_inserter(extensions));
                             return extensions;
-                        }())
+                        }(),
+                        std::nullopt,
+                        r_queueSettings,
+                        rp_hostAllocator)
     {
     }
 
     virtual ~LogicalDevice()
     {
+        _p_shaderModuleCache.reset();
+        _p_allocator.reset();
         if (_device != VK_NULL_HANDLE) {
-            vkDestroyDevice(_device, nullptr);
+            vkDestroyDevice(_device, this->getAllocationCallbacks());
         }
     }
 
@@ -58,6 +128,17 @@ public:
         return it_output;
     }
 
+    /// @brief Features that get enabled if the physical device supports them.
+    /// @tparam TIterator output iterator with @ref PhysicalDevice::Feature as value type.
+    /// @return the output iterator pointing to the new end of the modified container.
+    template <class TIterator>
+    static TIterator getOptionalFeatures(TIterator it_output)
+    {
+        // Bindless resources (see @ref BindlessDescriptors)
+        *it_output++ = PhysicalDevice::Feature::DescriptorIndexing;
+        return it_output;
+    }
+
     /// @tparam TIterator output iterator with @a const @a char* as value type.
     /// @return the output iterator pointing to the new end of the modified container.
     template <class TIterator>
@@ -66,6 +147,29 @@ public:
         return it_output;
     }
 
+    /// @brief Extensions that get enabled if the physical device supports them.
+    /// @tparam TIterator output iterator with @a const @a char* as value type.
+    /// @return the output iterator pointing to the new end of the modified container.
+    template <class TIterator>
+    static TIterator getOptionalExtensions(TIterator it_output)
+    {
+        // Reports pipeline cache hits (see @ref PipelineCache)
+        *it_output++ = VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME;
+        return it_output;
+    }
+
+    /// @brief Check whether an extension was enabled on the device.
+    bool hasExtension(std::string_view name) const
+    {
+        return _extensions.contains(std::string(name));
+    }
+
+    /// @brief Check whether a feature was enabled on the device.
+    bool hasFeature(PhysicalDevice::Feature feature) const
+    {
+        return std::find(_features.begin(), _features.end(), feature) != _features.end();
+    }
+
     ///@}
     ///@name Member Access
     ///@{
@@ -80,65 +184,228 @@ public:
         return *_p_physicalDevice;
     }
 
+    /// @brief Shader modules shared by all @ref Shader instances created on this device.
+    ShaderModuleCache& getShaderModuleCache() const
+    {
+        if (!_p_shaderModuleCache) {
+            throw std::runtime_error("Uninitialized logical device has no shader module cache");
+        }
+        return *_p_shaderModuleCache;
+    }
+
+    /// @brief Sub-allocator for all buffer and image memory on this device.
+    DeviceAllocator& getAllocator() const
+    {
+        if (!_p_allocator) {
+            throw std::runtime_error("Uninitialized logical device has no allocator");
+        }
+        return *_p_allocator;
+    }
+
+    /// @brief Get the host allocator of the device, nullptr if it uses the implementation's own.
+    const std::shared_ptr<HostAllocator>& getHostAllocator() const noexcept
+    {
+        return _p_hostAllocator;
+    }
+
+    /// @brief Get the callbacks every child of the device is created and destroyed with; may be nullptr.
+    const VkAllocationCallbacks* getAllocationCallbacks() const noexcept
+    {
+        return _p_hostAllocator ? _p_hostAllocator->getCallbacks() : nullptr;
+    }
+
     ///@}
     ///@name Queries
     ///@{
 
+    /// @brief Get the graphics queue.
     VkQueue getQueue() const
     {
-        auto queueFamily = _p_physicalDevice->getQueueFamily({}); // @todo
-        VkQueue queue;
-        vkGetDeviceQueue(_device, queueFamily.graphics.value(), 0, &queue);
-        return queue;
+        return _queue;
+    }
+
+    /// @brief Get one of the queues of a type.
+    /// @note Queues must not be submitted to from several threads at once.
+    VkQueue getQueue(QueueType type, std::size_t i_queue = 0) const
+    {
+        const auto& r_queues = _queues[static_cast<std::size_t>(type)];
+        if (r_queues.size() <= i_queue) {
+            throw std::runtime_error("Queue index out of range");
+        }
+        return r_queues[i_queue];
+    }
+
+    std::size_t getQueueCount(QueueType type) const noexcept
+    {
+        return _queues[static_cast<std::size_t>(type)].size();
+    }
+
+    uint32_t getQueueFamilyIndex(QueueType type) const noexcept
+    {
+        return _queueFamilies[static_cast<std::size_t>(type)];
+    }
+
+    /// @brief Check whether queues of a type belong to a family other than the graphics family.
+    /// @details Exclusive resources must change ownership (see @ref QueueTransfer) before
+    ///          they can be used on queues of a different family.
+    bool hasDedicatedFamily(QueueType type) const noexcept
+    {
+        return this->getQueueFamilyIndex(type) != this->getQueueFamilyIndex(QueueType::Graphics);
     }
 
     ///@}
 protected:
     LogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
                   const std::vector<PhysicalDevice::Feature>& r_requiredFeatures,
-                  const std::vector<const char*>& r_requiredExtensions)
+                  const std::vector<const char*>& r_requiredExtensions,
+                  std::optional<VkSurfaceKHR> surface,
+                  const QueueSettings& r_queueSettings,
+                  const std::shared_ptr<HostAllocator>& rp_hostAllocator)
         : LogicalDevice(rp_physicalDevice,
                         {r_requiredFeatures.data(), r_requiredFeatures.size()},
-                        {r_requiredExtensions.data(), r_requiredExtensions.size()})
+                        {r_requiredExtensions.data(), r_requiredExtensions.size()},
+                        surface,
+                        r_queueSettings,
+                        rp_hostAllocator)
     {
     }
 
+    /// @param surface surface to create presentation queues for, if any.
     LogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
                   std::span<const PhysicalDevice::Feature> requiredFeatures,
-                  std::span<const char* const> requiredExtensions)
+                  std::span<const char* const> requiredExtensions,
+                  std::optional<VkSurfaceKHR> surface,
+                  const QueueSettings& r_queueSettings,
+                  const std::shared_ptr<HostAllocator>& rp_hostAllocator)
         : _device(VK_NULL_HANDLE),
-          _p_physicalDevice(rp_physicalDevice)
+          _queue(VK_NULL_HANDLE),
+          _queues(),
+          _queueFamilies(),
+          _extensions(),
+          _features(),
+          _p_physicalDevice(rp_physicalDevice),
+          _p_shaderModuleCache(),
+          _p_allocator(),
+          _p_hostAllocator(rp_hostAllocator)
     {
-        const auto queueFamily = rp_physicalDevice->getQueueFamily({});
+        const auto queueFamily = rp_physicalDevice->getQueueFamily(surface);
+
+        // Enable optional features on top of the required ones if they're available
+        _features.assign(requiredFeatures.begin(), requiredFeatures.end());
+        for (PhysicalDevice::Feature feature : _features) {
+            if (!rp_physicalDevice->hasFeature(feature)) {
+                throw std::runtime_error("Physical device lacks a required feature");
+            }
+        }
+        {
+            std::vector<PhysicalDevice::Feature> optionalFeatures;
+            LogicalDevice::getOptionalFeatures(std::back_inserter(optionalFeatures));
+            for (PhysicalDevice::Feature optional : optionalFeatures) {
+                if (rp_physicalDevice->hasFeature(optional) && !this->hasFeature(optional)) {
+                    _features.push_back(optional);
+                }
+            }
+        }
+
+        // Features that aren't core on this device come with an extension
+        std::vector<const char*> extensions(requiredExtensions.begin(), requiredExtensions.end());
+        for (PhysicalDevice::Feature feature : _features) {
+            const char* p_extension = rp_physicalDevice->getFeatureExtension(feature);
+            const bool isListed = p_extension && std::any_of(extensions.begin(),
+                                                             extensions.end(),
+                                                             [p_extension](const char* p_listed) {
+                                                                 return std::strcmp(p_extension, p_listed) == 0;
+                                                             });
+            if (p_extension && !isListed) {
+                extensions.push_back(p_extension);
+            }
+        }
+
+        // Enable optional extensions on top of the required ones if they're available
+        {
+            std::vector<const char*> optionalExtensions;
+            LogicalDevice::getOptionalExtensions(std::back_inserter(optionalExtensions));
+            for (const char* p_optional : optionalExtensions) {
+                const bool isAvailable = rp_physicalDevice->hasExtension(p_optional);
+                const bool isRequired = std::any_of(extensions.begin(),
+                                                    extensions.end(),
+                                                    [p_optional](const char* p_required) {
+                                                        return std::strcmp(p_optional, p_required) == 0;
+                                                    });
+                if (isAvailable && !isRequired) {
+                    extensions.push_back(p_optional);
+                }
+            }
+        }
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 
-        // Collect unique queue families
-        std::unordered_set<uint32_t> uniqueQueueFamilies;
-        if (queueFamily.graphics.has_value())
-            uniqueQueueFamilies.insert(queueFamily.graphics.value());
-        if (queueFamily.presentation.has_value())
-            uniqueQueueFamilies.insert(queueFamily.presentation.value());
-
-        for (auto family : uniqueQueueFamilies) {
-            queueCreateInfos.push_back({});
-            auto& r_createInfo = queueCreateInfos.back();
-            r_createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            r_createInfo.queueFamilyIndex = queueFamily.graphics.value();
-            r_createInfo.queueCount = 1;
-            const float queuePriority = 1.0f;
-            r_createInfo.pQueuePriorities = &queuePriority;
+        // Dedicated compute and transfer families never overlap with each other or the graphics
+        // family, but the presentation family may be any of them. Types without a family of their
+        // own fall back to graphics, except for presentation to a surface that graphics can't present to.
+        const std::array<const std::vector<float>*,queueTypeCount> priorities {
+            &r_queueSettings.graphics,
+            &r_queueSettings.compute,
+            &r_queueSettings.transfer,
+            &r_queueSettings.presentation
+        };
+        const std::array<std::optional<uint32_t>,queueTypeCount> families {
+            queueFamily.graphics,
+            queueFamily.compute,
+            queueFamily.transfer,
+            queueFamily.presentation
+        };
+
+        // Type whose queues each type uses; a family gets a single create info, owned by its first type
+        std::array<std::size_t,queueTypeCount> owners {};
+
+        if (queueFamily.graphics.has_value()) {
+            for (std::size_t i_type=0; i_type<queueTypeCount; ++i_type) {
+                const auto& r_priorities = *priorities[i_type];
+                const uint32_t availableCount = families[i_type].has_value()
+                                                ? rp_physicalDevice->getCapabilities().queueFamilies[families[i_type].value()].queueCount
+                                                : 0;
+                const auto queueCount = static_cast<uint32_t>(std::min<std::size_t>(r_priorities.size(), availableCount));
+
+                if (std::any_of(r_priorities.begin(), r_priorities.end(), [](float priority) {return priority < 0.0f || 1.0f < priority;})) {
+                    throw std::runtime_error("Queue priorities must be in [0, 1]");
+                }
+
+                if (queueCount == 0) {
+                    if (i_type == static_cast<std::size_t>(QueueType::Graphics)) {
+                        throw std::runtime_error("At least one graphics queue is required");
+                    }
+                    if (i_type == static_cast<std::size_t>(QueueType::Presentation) && families[i_type].has_value()) {
+                        throw std::runtime_error("At least one presentation queue is required");
+                    }
+                }
+
+                _queueFamilies[i_type] = queueCount ? families[i_type].value() : queueFamily.graphics.value();
+                const auto it_owner = std::find(_queueFamilies.begin(), _queueFamilies.begin() + i_type, _queueFamilies[i_type]);
+                owners[i_type] = static_cast<std::size_t>(std::distance(_queueFamilies.begin(), it_owner));
+                if (owners[i_type] != i_type) {
+                    continue;
+                }
+
+                queueCreateInfos.push_back({});
+                auto& r_createInfo = queueCreateInfos.back();
+                r_createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+                r_createInfo.queueFamilyIndex = families[i_type].value();
+                r_createInfo.queueCount = queueCount;
+                r_createInfo.pQueuePriorities = r_priorities.data();
+            }
         }
 
-        const auto features = PhysicalDevice::makeFeatures({requiredFeatures.data(), requiredFeatures.size()});
+        auto features = PhysicalDevice::makeFeatures({_features.data(), _features.size()});
 
         VkDeviceCreateInfo createInfo {};
         if (!queueCreateInfos.empty()) {
             createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+            createInfo.pNext = features.link();
             createInfo.pQueueCreateInfos = queueCreateInfos.data();
             createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
-            createInfo.pEnabledFeatures = &features;
-            createInfo.enabledExtensionCount = requiredExtensions.size();
-            createInfo.ppEnabledExtensionNames = requiredExtensions.data();
+            createInfo.pEnabledFeatures = &features.core;
+            createInfo.enabledExtensionCount = extensions.size();
+            createInfo.ppEnabledExtensionNames = extensions.data();
 
             #if defined(__APPLE__) && __APPLE__
             //createInfo.flags = VK_KHR_portability_subset; // <== @todo apparently, I'll need VK_KHR_portability_subset but I've no idea where
@@ -152,23 +419,73 @@ protected:
         }
 
         // Create the logical device
-        if (vkCreateDevice(rp_physicalDevice->getDevice(), &createInfo, nullptr, &_device) != VK_SUCCESS) {
+        if (vkCreateDevice(rp_physicalDevice->getDevice(), &createInfo, this->getAllocationCallbacks(), &_device) != VK_SUCCESS) {
             throw std::runtime_error("Logical device creation failed");
         }
 
-        // Get its queue
-        for (auto family : uniqueQueueFamilies) {
-            _queues.push_back({});
-            vkGetDeviceQueue(_device, family, 0, &_queues.back());
+        // The destructor doesn't run if construction fails, so the device is destroyed here
+        try {
+            _extensions.insert(extensions.begin(), extensions.end());
+            _p_shaderModuleCache = std::make_unique<ShaderModuleCache>(_device, this->getAllocationCallbacks());
+            _p_allocator = std::make_unique<DeviceAllocator>(_device,
+                                                              *rp_physicalDevice,
+                                                              DeviceAllocator::Settings(),
+                                                              this->getAllocationCallbacks());
+
+            // Get its queues; types without a family of their own share the queues of the type owning their family
+            auto it_createInfo = queueCreateInfos.begin();
+            for (std::size_t i_type=0; i_type<queueTypeCount; ++i_type) {
+                if (owners[i_type] != i_type) {
+                    _queues[i_type] = _queues[owners[i_type]];
+                    continue;
+                }
+
+                _queues[i_type].resize(it_createInfo->queueCount);
+                for (uint32_t i_queue=0; i_queue<it_createInfo->queueCount; ++i_queue) {
+                    vkGetDeviceQueue(_device, it_createInfo->queueFamilyIndex, i_queue, &_queues[i_type][i_queue]);
+                }
+                ++it_createInfo;
+            }
+            _queue = _queues[static_cast<std::size_t>(QueueType::Graphics)].front();
+        } catch (...) {
+            _p_shaderModuleCache.reset();
+            _p_allocator.reset();
+            vkDestroyDevice(_device, this->getAllocationCallbacks());
+            _device = VK_NULL_HANDLE;
+            throw;
         }
     }
 
 private:
+    static constexpr std::size_t queueTypeCount = 4;
+
     VkDevice _device;
 
-    std::vector<VkQueue> _queues;
+    /// @brief Graphics queue, fetched once so that @ref getQueue is cheap enough for every frame.
+    VkQueue _queue;
+
+    /// @brief Queues of each @ref QueueType.
+    std::array<std::vector<VkQueue>,queueTypeCount> _queues;
+
+    /// @brief Queue family of each @ref QueueType.
+    std::array<uint32_t,queueTypeCount> _queueFamilies;
+
+    /// @brief Names of all extensions enabled on the device.
+    std::unordered_set<std::string> _extensions;
+
+    /// @brief Features enabled on the device.
+    std::vector<PhysicalDevice::Feature> _features;
 
     std::shared_ptr<PhysicalDevice> _p_physicalDevice;
+
+    /// @brief Destroyed before the device.
+    std::unique_ptr<ShaderModuleCache> _p_shaderModuleCache;
+
+    /// @brief Destroyed before the device.
+    std::unique_ptr<DeviceAllocator> _p_allocator;
+
+    /// @brief Outlives the device and every child created with its callbacks.
+    std::shared_ptr<HostAllocator> _p_hostAllocator;
 }; // class LogicalDevice
 
 
@@ -183,6 +500,28 @@ public:
     }
 
     GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice)
+        : GraphicsLogicalDevice(rp_physicalDevice, QueueSettings())
+    {
+    }
+
+    GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
+                          const QueueSettings& r_queueSettings)
+        : GraphicsLogicalDevice(rp_physicalDevice, r_queueSettings, nullptr)
+    {
+    }
+
+    GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
+                          const QueueSettings& r_queueSettings,
+                          const std::shared_ptr<HostAllocator>& rp_hostAllocator)
+        : GraphicsLogicalDevice(rp_physicalDevice, std::nullopt, r_queueSettings, rp_hostAllocator)
+    {
+    }
+
+    /// @param surface surface to create presentation queues for; swap chains must present to it.
+    GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
+                          std::optional<VkSurfaceKHR> surface,
+                          const QueueSettings& r_queueSettings,
+                          const std::shared_ptr<HostAllocator>& rp_hostAllocator)
         : LogicalDevice(rp_physicalDevice,
                         [](){
                             std::vector<PhysicalDevice::Feature> features;
@@ -193,7 +532,10 @@ public:
                             std::vector<const char*> extensions;
                             GraphicsLogicalDevice::getRequiredExtensions(std::back_inserter(extensions));
                             return extensions;
-                        }())
+                        }(),
+                        surface,
+                        r_queueSettings,
+                        rp_hostAllocator)
     {
     }
 
@@ -223,15 +565,21 @@ public:
 protected:
     GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
                           const std::vector<PhysicalDevice::Feature>& r_requiredFeatures,
-                          const std::vector<const char*>& r_requiredExtensions)
-        : LogicalDevice(rp_physicalDevice, r_requiredFeatures, r_requiredExtensions)
+                          const std::vector<const char*>& r_requiredExtensions,
+                          std::optional<VkSurfaceKHR> surface,
+                          const QueueSettings& r_queueSettings,
+                          const std::shared_ptr<HostAllocator>& rp_hostAllocator)
+        : LogicalDevice(rp_physicalDevice, r_requiredFeatures, r_requiredExtensions, surface, r_queueSettings, rp_hostAllocator)
     {
     }
 
     GraphicsLogicalDevice(const std::shared_ptr<PhysicalDevice>& rp_physicalDevice,
                           std::span<const PhysicalDevice::Feature> requiredFeatures,
-                          std::span<const char* const> requiredExtensions)
-        : LogicalDevice(rp_physicalDevice, requiredFeatures, requiredExtensions)
+                          std::span<const char* const> requiredExtensions,
+                          std::optional<VkSurfaceKHR> surface,
+                          const QueueSettings& r_queueSettings,
+                          const std::shared_ptr<HostAllocator>& rp_hostAllocator)
+        : LogicalDevice(rp_physicalDevice, requiredFeatures, requiredExtensions, surface, r_queueSettings, rp_hostAllocator)
     {
     }
 }; // class GraphicsLogicalDevice
@@ -0,0 +1,200 @@
+// --- Internal Includes ---
+#include "OffscreenTarget.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+#include <thread>
+
+
+OffscreenTarget::OffscreenTarget(const std::shared_ptr<LogicalDevice>& rp_device,
+                                 const Settings& r_settings)
+    : _p_device(rp_device),
+      _settings(r_settings),
+      _images(),
+      _memory(),
+      _i_next(0),
+      _frameCount(0),
+      _begin(),
+      _lastPresent()
+{
+    if (_settings.imageCount == 0) {
+        throw std::runtime_error("Offscreen render target requires at least one image");
+    }
+
+    if (!_settings.unthrottled && _settings.refreshRate <= 0.0) {
+        throw std::runtime_error("Offscreen render target requires a positive refresh rate");
+    }
+
+    VkImageCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    info.imageType = VK_IMAGE_TYPE_2D;
+    info.format = _settings.format;
+    info.extent = {_settings.extent.width, _settings.extent.height, 1};
+    info.mipLevels = 1;
+    info.arrayLayers = 1;
+    info.samples = VK_SAMPLE_COUNT_1_BIT;
+    info.tiling = VK_IMAGE_TILING_OPTIMAL;
+
+    // - VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT: render directly to the image
+    // - VK_IMAGE_USAGE_TRANSFER_SRC_BIT: read rendered frames back to the host
+    // - VK_IMAGE_USAGE_TRANSFER_DST_BIT: clear the image outside of a render pass
+    info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                 | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+                 | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    const VkDevice device = _p_device->getDevice();
+    DeviceAllocator& r_allocator = _p_device->getAllocator();
+    _images.reserve(_settings.imageCount);
+    _memory.reserve(_settings.imageCount);
+
+    // The destructor doesn't run if construction fails, so release what was created so far
+    try {
+        for (uint32_t i_image=0; i_image<_settings.imageCount; ++i_image) {
+            VkImage image;
+            if (vkCreateImage(device, &info, _p_device->getAllocationCallbacks(), &image) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create offscreen image");
+            }
+            _images.push_back(image);
+
+            _memory.push_back(r_allocator.allocate(image,
+                                                   info.tiling,
+                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+        }
+    } catch (...) {
+        this->destroy();
+        throw;
+    }
+}
+
+
+OffscreenTarget::~OffscreenTarget()
+{
+    this->destroy();
+}
+
+
+void OffscreenTarget::destroy() noexcept
+{
+    const VkDevice device = _p_device->getDevice();
+    for (VkImage image : _images) {
+        vkDestroyImage(device, image, _p_device->getAllocationCallbacks());
+    }
+    for (const auto& r_allocation : _memory) {
+        _p_device->getAllocator().free(r_allocation);
+    }
+    _images.clear();
+    _memory.clear();
+}
+
+
+std::vector<VkImage>& OffscreenTarget::getImages() noexcept
+{
+    return _images;
+}
+
+
+VkFormat OffscreenTarget::getImageFormat() const noexcept
+{
+    return _settings.format;
+}
+
+
+VkExtent2D OffscreenTarget::getImageExtent() const noexcept
+{
+    return _settings.extent;
+}
+
+
+VkImageLayout OffscreenTarget::getFinalLayout() const noexcept
+{
+    return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
+
+bool OffscreenTarget::isPresentable() const noexcept
+{
+    return false;
+}
+
+
+bool OffscreenTarget::isOutOfDate() const noexcept
+{
+    return false;
+}
+
+
+const LogicalDevice& OffscreenTarget::getLogicalDevice() const noexcept
+{
+    return *_p_device;
+}
+
+
+LogicalDevice& OffscreenTarget::getLogicalDevice() noexcept
+{
+    return *_p_device;
+}
+
+
+const OffscreenTarget::Settings& OffscreenTarget::getSettings() const noexcept
+{
+    return _settings;
+}
+
+
+std::size_t OffscreenTarget::getFrameCount() const noexcept
+{
+    return _frameCount;
+}
+
+
+double OffscreenTarget::getFramesPerSecond() const noexcept
+{
+    if (_frameCount == 0) {
+        return 0.0;
+    }
+
+    const std::chrono::duration<double> elapsed = _lastPresent - _begin;
+    return 0.0 < elapsed.count() ? _frameCount / elapsed.count() : 0.0;
+}
+
+
+std::optional<uint32_t> OffscreenTarget::acquire(VkSemaphore signal)
+{
+    if (signal != VK_NULL_HANDLE) {
+        throw std::runtime_error("Offscreen render targets cannot signal semaphores on acquire");
+    }
+
+    if (_frameCount == 0) {
+        _begin = Clock::now();
+        _lastPresent = _begin;
+    }
+
+    const uint32_t i_image = _i_next;
+    _i_next = (_i_next + 1) % static_cast<uint32_t>(_images.size());
+    return i_image;
+}
+
+
+void OffscreenTarget::present(uint32_t i_image, VkSemaphore wait)
+{
+    if (_images.size() <= i_image) {
+        throw std::runtime_error("Presented image index out of range for offscreen render target");
+    }
+
+    if (wait != VK_NULL_HANDLE) {
+        throw std::runtime_error("Offscreen render targets cannot wait on semaphores on present");
+    }
+
+    // Simulate a display that picks up a new image once per refresh
+    if (!_settings.unthrottled) {
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / _settings.refreshRate)
+        );
+        std::this_thread::sleep_until(_lastPresent + period);
+    }
+
+    _lastPresent = Clock::now();
+    ++_frameCount;
+}
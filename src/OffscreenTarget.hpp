@@ -0,0 +1,113 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "RenderTarget.hpp"
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+
+/// @brief @ref RenderTarget that owns its images instead of borrowing them from a window.
+/// @details Meant for machines without a display (render farms, CI on software drivers).
+///          Images are handed out round-robin by @ref acquire, and @ref present simulates
+///          a display refresh by pacing frames to @ref Settings::refreshRate unless the
+///          target is @ref Settings::unthrottled, in which case frames are produced as fast
+///          as the rest of the loop allows.
+class OffscreenTarget final : public RenderTarget
+{
+public:
+    struct Settings
+    {
+        VkExtent2D extent {800, 600};
+
+        VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+
+        /// @brief Number of images in the ring.
+        uint32_t imageCount = 3;
+
+        /// @brief Simulated display refresh rate [Hz] that @ref present paces frames to.
+        double refreshRate = 60.0;
+
+        /// @brief Don't pace frames at all; measure raw throughput instead.
+        bool unthrottled = false;
+    }; // struct Settings
+
+public:
+    OffscreenTarget(const std::shared_ptr<LogicalDevice>& rp_device,
+                    const Settings& r_settings);
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+
+    ~OffscreenTarget() override;
+
+    /// @name Queries
+    /// @{
+
+    std::vector<VkImage>& getImages() noexcept override;
+
+    VkFormat getImageFormat() const noexcept override;
+
+    VkExtent2D getImageExtent() const noexcept override;
+
+    VkImageLayout getFinalLayout() const noexcept override;
+
+    bool isPresentable() const noexcept override;
+
+    bool isOutOfDate() const noexcept override;
+
+    const LogicalDevice& getLogicalDevice() const noexcept override;
+
+    LogicalDevice& getLogicalDevice() noexcept override;
+
+    const Settings& getSettings() const noexcept;
+
+    /// @brief Number of frames passed to @ref present so far.
+    std::size_t getFrameCount() const noexcept;
+
+    /// @brief Average number of frames presented per second since the first @ref acquire.
+    double getFramesPerSecond() const noexcept;
+
+    /// @}
+    /// @name Frame Control
+    /// @{
+
+    /// @note @a signal must be @a VK_NULL_HANDLE, images are ready as soon as the
+    ///       work previously submitted to them completes.
+    std::optional<uint32_t> acquire(VkSemaphore signal) override;
+
+    /// @note @a wait must be @a VK_NULL_HANDLE.
+    void present(uint32_t i_image, VkSemaphore wait) override;
+
+    /// @}
+
+private:
+    /// @brief Destroy the images and free their memory.
+    void destroy() noexcept;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    Settings _settings;
+
+    std::vector<VkImage> _images;
+
+    std::vector<DeviceAllocator::Allocation> _memory;
+
+    uint32_t _i_next;
+
+    std::size_t _frameCount;
+
+    Clock::time_point _begin;
+
+    Clock::time_point _lastPresent;
+}; // class OffscreenTarget
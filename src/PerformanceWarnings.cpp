@@ -0,0 +1,192 @@
+// --- Internal Includes ---
+#include "PerformanceWarnings.hpp"
+#include "utilities.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+
+PerformanceWarnings::PerformanceWarnings()
+    : _mutex(),
+      _records(),
+      _frame(0),
+      _droppedCount(0)
+{
+}
+
+
+void PerformanceWarnings::record(const VkDebugUtilsMessengerCallbackDataEXT* p_data) noexcept
+{
+    try {
+        const Key key {p_data->messageIdNumber,
+                       p_data->objectCount ? p_data->pObjects[0].objectType : VK_OBJECT_TYPE_UNKNOWN};
+        const std::size_t frame = _frame.load(std::memory_order_relaxed);
+
+        std::scoped_lock<std::mutex> lock(_mutex);
+        auto [it_record, isNew] = _records.try_emplace(key);
+        Record& r_record = it_record->second;
+        if (isNew) {
+            r_record.messageId = key.first;
+            r_record.messageIdName = p_data->pMessageIdName ? p_data->pMessageIdName : "";
+            r_record.message = p_data->pMessage ? p_data->pMessage : "";
+            r_record.objectType = key.second;
+        }
+
+        // Keep a sample of the objects, so that records stay small even if a warning fires for every object
+        for (uint32_t i_object=0; i_object<p_data->objectCount && r_record.objects.size()<maxSampledObjects; ++i_object) {
+            const auto& r_object = p_data->pObjects[i_object];
+            const bool isSampled = std::any_of(r_record.objects.begin(),
+                                               r_record.objects.end(),
+                                               [&r_object](const Object& r_sampled) {
+                                                   return r_sampled.type == r_object.objectType && r_sampled.handle == r_object.objectHandle;
+                                               });
+            if (!isSampled) {
+                r_record.objects.push_back(Object {r_object.objectType,
+                                                   r_object.objectHandle,
+                                                   r_object.pObjectName ? r_object.pObjectName : ""});
+            }
+        }
+
+        ++r_record.count;
+        if (r_record.frameCounts.empty() || r_record.frameCounts.back().frame != frame) {
+            r_record.frameCounts.push_back(FrameCount {frame, 0});
+        }
+        ++r_record.frameCounts.back().count;
+    } catch (...) {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+void PerformanceWarnings::nextFrame() noexcept
+{
+    _frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+std::size_t PerformanceWarnings::getFrame() const noexcept
+{
+    return _frame.load(std::memory_order_relaxed);
+}
+
+
+std::vector<PerformanceWarnings::Record> PerformanceWarnings::getRecords() const
+{
+    std::vector<Record> records;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        records.reserve(_records.size());
+        for (const auto& [r_key, r_record] : _records) {
+            records.push_back(r_record);
+        }
+    }
+
+    std::stable_sort(records.begin(),
+                     records.end(),
+                     [](const Record& r_left, const Record& r_right) {return r_right.count < r_left.count;});
+    return records;
+}
+
+
+std::vector<PerformanceWarnings::Record> PerformanceWarnings::getNewRecords(std::span<const int32_t> baseline) const
+{
+    std::vector<Record> records = this->getRecords();
+    records.erase(std::remove_if(records.begin(),
+                                 records.end(),
+                                 [baseline](const Record& r_record) {
+                                     return std::find(baseline.begin(), baseline.end(), r_record.messageId) != baseline.end();
+                                 }),
+                  records.end());
+    return records;
+}
+
+
+std::size_t PerformanceWarnings::getCount() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    std::size_t count = 0;
+    for (const auto& [r_key, r_record] : _records) {
+        count += r_record.count;
+    }
+    return count;
+}
+
+
+std::size_t PerformanceWarnings::getDroppedCount() const noexcept
+{
+    return _droppedCount.load(std::memory_order_relaxed);
+}
+
+
+void PerformanceWarnings::writeJSON(std::ostream& r_stream) const
+{
+    const auto records = this->getRecords();
+    const auto flags = r_stream.flags();
+
+    r_stream << "{\"frameCount\":" << this->getFrame()
+             << ",\"droppedCount\":" << this->getDroppedCount()
+             << ",\"warnings\":[";
+
+    bool isFirst = true;
+    for (const Record& r_record : records) {
+        r_stream << (isFirst ? "\n" : ",\n") << "{\"messageId\":" << std::dec << r_record.messageId
+                 << ",\"messageIdName\":";
+        writeJSONString(r_stream, r_record.messageIdName);
+        r_stream << ",\"count\":" << r_record.count
+                 << ",\"message\":";
+        writeJSONString(r_stream, r_record.message);
+        r_stream << ",\"objectType\":" << std::dec << r_record.objectType;
+
+        // Handles don't fit the double precision of JSON numbers, so they are written as strings
+        r_stream << ",\"objects\":[";
+        for (std::size_t i_object=0; i_object<r_record.objects.size(); ++i_object) {
+            const Object& r_object = r_record.objects[i_object];
+            r_stream << (i_object ? "," : "") << "{\"type\":" << std::dec << r_object.type
+                     << ",\"handle\":\"0x" << std::hex << r_object.handle << std::dec
+                     << "\",\"name\":";
+            writeJSONString(r_stream, r_object.name);
+            r_stream << '}';
+        }
+
+        r_stream << "],\"frames\":[";
+        for (std::size_t i_frame=0; i_frame<r_record.frameCounts.size(); ++i_frame) {
+            const FrameCount& r_frameCount = r_record.frameCounts[i_frame];
+            r_stream << (i_frame ? "," : "") << '[' << r_frameCount.frame << ',' << r_frameCount.count << ']';
+        }
+        r_stream << "]}";
+        isFirst = false;
+    }
+
+    r_stream << "\n]}\n";
+    r_stream.flags(flags);
+}
+
+
+std::vector<int32_t> PerformanceWarnings::readMessageIds(std::istream& r_stream)
+{
+    // Only files written by writeJSON are supported, so scanning for the key is enough:
+    // quotes inside strings are escaped, so the key can't appear in any message text.
+    const std::string contents((std::istreambuf_iterator<char>(r_stream)), std::istreambuf_iterator<char>());
+    constexpr std::string_view key = "\"messageId\":";
+
+    std::vector<int32_t> messageIds;
+    for (std::size_t position=contents.find(key); position!=std::string::npos; position=contents.find(key, position)) {
+        position += key.size();
+        std::size_t length = 0;
+        try {
+            messageIds.push_back(static_cast<int32_t>(std::stol(contents.substr(position, 16), &length)));
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid message ID in performance warnings file");
+        }
+        position += length;
+    }
+
+    std::sort(messageIds.begin(), messageIds.end());
+    messageIds.erase(std::unique(messageIds.begin(), messageIds.end()), messageIds.end());
+    return messageIds;
+}
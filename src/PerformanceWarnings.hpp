@@ -0,0 +1,125 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- STL Includes ---
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+
+/// @brief Collects performance warnings of the debug messenger as structured records.
+/// @details Passed to the messenger as its @a pUserData (see @ref DebugMessenger), and fed
+///          every message of type @a VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT by the
+///          callback, regardless of the filters of @ref DebugSink.
+///
+///          Occurrences are grouped by message ID number and the type of the first object
+///          they refer to, so the same warning about a thousand different pipelines still
+///          yields a single record. Each record keeps a bounded sample of the objects its
+///          occurrences referred to, and counts its occurrences per frame; frames are
+///          delimited by @ref nextFrame.
+///
+///          Records can be queried with @ref getRecords, exported with @ref writeJSON, and
+///          compared against the message IDs of a previous export with @ref getNewRecords,
+///          so that runs can fail when new warnings show up.
+/// @note Thread safe. Performance warnings are rare compared to validation chatter, so
+///       @ref record takes a mutex instead of going through a lock-free queue.
+class PerformanceWarnings
+{
+public:
+    struct Object
+    {
+        VkObjectType type = VK_OBJECT_TYPE_UNKNOWN;
+
+        uint64_t handle = 0;
+
+        /// @brief Debug name of the object, empty if it has none.
+        std::string name;
+    }; // struct Object
+
+    struct FrameCount
+    {
+        std::size_t frame = 0;
+
+        std::size_t count = 0;
+    }; // struct FrameCount
+
+    struct Record
+    {
+        int32_t messageId = 0;
+
+        std::string messageIdName;
+
+        /// @brief Text of the first occurrence.
+        std::string message;
+
+        /// @brief Type of the first object of every occurrence, @a VK_OBJECT_TYPE_UNKNOWN if they refer to none.
+        VkObjectType objectType = VK_OBJECT_TYPE_UNKNOWN;
+
+        /// @brief Distinct objects referred to by occurrences, in order of appearance; at most @ref maxSampledObjects.
+        std::vector<Object> objects;
+
+        /// @brief Number of occurrences over all frames.
+        std::size_t count = 0;
+
+        /// @brief Occurrences per frame, in frame order; frames without any are left out.
+        std::vector<FrameCount> frameCounts;
+    }; // struct Record
+
+public:
+    PerformanceWarnings();
+
+    PerformanceWarnings(const PerformanceWarnings&) = delete;
+
+    /// @brief Record an occurrence of a performance warning in the current frame.
+    /// @details Never throws, since it is called from messenger callbacks; occurrences
+    ///          that can't be stored are counted by @ref getDroppedCount.
+    void record(const VkDebugUtilsMessengerCallbackDataEXT* p_data) noexcept;
+
+    /// @brief Attribute further occurrences to the next frame.
+    void nextFrame() noexcept;
+
+    /// @brief Get the index of the frame occurrences are currently attributed to.
+    std::size_t getFrame() const noexcept;
+
+    /// @brief Get a snapshot of all records, the most frequent first.
+    std::vector<Record> getRecords() const;
+
+    /// @brief Get the records whose message ID is not in @a baseline.
+    /// @details Object handles differ between runs, so only message IDs are compared.
+    std::vector<Record> getNewRecords(std::span<const int32_t> baseline) const;
+
+    /// @brief Get the number of occurrences over all records.
+    std::size_t getCount() const;
+
+    /// @brief Get the number of occurrences that couldn't be recorded.
+    std::size_t getDroppedCount() const noexcept;
+
+    /// @brief Write the frame count and all records as a JSON object.
+    void writeJSON(std::ostream& r_stream) const;
+
+    /// @brief Read the message IDs of the records in a JSON file written by @ref writeJSON.
+    static std::vector<int32_t> readMessageIds(std::istream& r_stream);
+
+    /// @brief Maximum number of objects a record keeps in @ref Record::objects.
+    static constexpr std::size_t maxSampledObjects = 8;
+
+private:
+    using Key = std::pair<int32_t,VkObjectType>;
+
+private:
+    mutable std::mutex _mutex;
+
+    std::map<Key,Record> _records;
+
+    std::atomic<std::size_t> _frame;
+
+    std::atomic<std::size_t> _droppedCount;
+}; // class PerformanceWarnings
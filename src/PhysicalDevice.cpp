@@ -5,6 +5,121 @@
 #include <iostream>
 
 
+void* PhysicalDevice::Features::link() noexcept
+{
+    void* p_head = nullptr;
+    if (descriptorIndexing.sType) {
+        descriptorIndexing.pNext = p_head;
+        p_head = &descriptorIndexing;
+    }
+    return p_head;
+}
+
+
+PhysicalDevice::Capabilities PhysicalDevice::Capabilities::query(VkPhysicalDevice device)
+{
+    Capabilities capabilities;
+    vkGetPhysicalDeviceProperties(device, &capabilities.properties);
+    vkGetPhysicalDeviceFeatures(device, &capabilities.features);
+    vkGetPhysicalDeviceMemoryProperties(device, &capabilities.memoryProperties);
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+    capabilities.queueFamilies.resize(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, capabilities.queueFamilies.data());
+
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+    capabilities.extensions.resize(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, capabilities.extensions.data());
+    capabilities.extensions.resize(extensionCount);
+    capabilities.indexExtensions();
+
+    // Extension structs may only be chained if the device knows them, and need the Vulkan 1.1 queries
+    const uint32_t apiVersion = capabilities.properties.apiVersion;
+    const bool hasDescriptorIndexing = VK_API_VERSION_1_2 <= apiVersion
+                                       || (VK_API_VERSION_1_1 <= apiVersion && capabilities.hasExtension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME));
+    if (hasDescriptorIndexing) {
+        capabilities.descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features {};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &capabilities.descriptorIndexingFeatures;
+        vkGetPhysicalDeviceFeatures2(device, &features);
+        capabilities.descriptorIndexingFeatures.pNext = nullptr;
+
+        capabilities.descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2 properties {};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &capabilities.descriptorIndexingProperties;
+        vkGetPhysicalDeviceProperties2(device, &properties);
+        capabilities.descriptorIndexingProperties.pNext = nullptr;
+    }
+
+    return capabilities;
+}
+
+
+void PhysicalDevice::Capabilities::indexExtensions()
+{
+    extensionNames.clear();
+    extensionNames.reserve(extensions.size());
+    for (const auto& r_extension : extensions) {
+        extensionNames.emplace(r_extension.extensionName);
+    }
+}
+
+
+bool PhysicalDevice::hasFeature(Feature feature) const
+{
+    switch (feature) {
+        case Feature::DescriptorIndexing: {
+            const auto& r_features = this->getCapabilities().descriptorIndexingFeatures;
+            return r_features.shaderSampledImageArrayNonUniformIndexing
+                   && r_features.shaderStorageBufferArrayNonUniformIndexing
+                   && r_features.descriptorBindingSampledImageUpdateAfterBind
+                   && r_features.descriptorBindingStorageBufferUpdateAfterBind
+                   && r_features.descriptorBindingUpdateUnusedWhilePending
+                   && r_features.descriptorBindingPartiallyBound
+                   && r_features.runtimeDescriptorArray;
+        }
+    }
+    return false;
+}
+
+
+const char* PhysicalDevice::getFeatureExtension(Feature feature) const
+{
+    switch (feature) {
+        case Feature::DescriptorIndexing:
+            return this->getProperties().apiVersion < VK_API_VERSION_1_2 ? VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME : nullptr;
+    }
+    return nullptr;
+}
+
+
+PhysicalDevice::Features PhysicalDevice::makeFeatures(std::span<const Feature> features)
+{
+    Features output;
+    for (Feature feature : features) {
+        switch (feature) {
+            case Feature::DescriptorIndexing: {
+                auto& r_features = output.descriptorIndexing;
+                r_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+                r_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+                r_features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+                r_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+                r_features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+                r_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+                r_features.descriptorBindingPartiallyBound = VK_TRUE;
+                r_features.runtimeDescriptorArray = VK_TRUE;
+                break;
+            }
+        }
+    }
+    return output;
+}
+
+
 std::ostream& operator<<(std::ostream& r_stream, const PhysicalDevice& r_device)
 {
     return r_stream << r_device.getName();
@@ -16,6 +16,10 @@
 #include <tuple>
 #include <limits>
 #include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <functional>
 #include <iosfwd>
 
 
@@ -30,6 +34,12 @@ public:
 
         std::optional<uint32_t> presentation;
 
+        /// @brief Family with compute but without graphics support, for work that runs alongside graphics.
+        std::optional<uint32_t> compute;
+
+        /// @brief Family with transfer but without graphics or compute support, usually backed by DMA engines.
+        std::optional<uint32_t> transfer;
+
         bool all() const noexcept
         {
             return graphics.has_value() && presentation.has_value();
@@ -39,11 +49,86 @@ public:
     /// @brief Represents @ref PhysicalDevice features.
     enum class Feature
     {
+        /// @brief Non-uniform indexing into runtime sized arrays of sampled images and storage
+        ///        buffers, whose bindings may be partially bound and updated after binding
+        ///        (see @ref BindlessDescriptors).
+        DescriptorIndexing
     }; // enum class Feature
 
+    /// @brief Feature structs to create a logical device with (see @ref makeFeatures).
+    struct Features
+    {
+        VkPhysicalDeviceFeatures core {};
+
+        /// @brief Chained only if its @a sType is set.
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexing {};
+
+        /// @brief Chain the extension structs that are set.
+        /// @return the head of the chain for @a VkDeviceCreateInfo::pNext, nullptr if none are set.
+        /// @note The chain points into this object, so it must not be copied or moved afterwards.
+        void* link() noexcept;
+    }; // struct Features
+
+    /// @brief Everything the driver reports about a device that doesn't depend on a surface.
+    /// @details Queried once when the @ref PhysicalDevice is constructed, and shared by its copies.
+    struct Capabilities
+    {
+        /// @brief Hashes strings and string views alike, so lookups don't construct strings.
+        struct StringHash
+        {
+            using is_transparent = void;
+
+            std::size_t operator()(std::string_view string) const noexcept
+            {
+                return std::hash<std::string_view>()(string);
+            }
+        }; // struct StringHash
+
+        VkPhysicalDeviceProperties properties;
+
+        VkPhysicalDeviceFeatures features;
+
+        /// @brief Zeroed if the device doesn't support descriptor indexing, or Vulkan 1.1.
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures {};
+
+        /// @brief Zeroed if the device doesn't support descriptor indexing, or Vulkan 1.1.
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties {};
+
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+
+        std::vector<VkQueueFamilyProperties> queueFamilies;
+
+        std::vector<VkExtensionProperties> extensions;
+
+        /// @brief Names of all @ref extensions.
+        std::unordered_set<std::string,StringHash,std::equal_to<>> extensionNames;
+
+        bool hasExtension(std::string_view name) const
+        {
+            return extensionNames.find(name) != extensionNames.end();
+        }
+
+        /// @brief Fill @ref extensionNames from @ref extensions.
+        void indexExtensions();
+
+        static Capabilities query(VkPhysicalDevice device);
+    }; // struct Capabilities
+
 public:
     PhysicalDevice(VkPhysicalDevice device)
-        : _device(device)
+        : _device(device),
+          _p_capabilities()
+    {
+        if (_device != VK_NULL_HANDLE) {
+            _p_capabilities = std::make_shared<const Capabilities>(Capabilities::query(_device));
+        }
+    }
+
+    /// @brief Construct from capabilities that were already queried (see @ref CapabilityCache).
+    PhysicalDevice(VkPhysicalDevice device,
+                   const std::shared_ptr<const Capabilities>& rp_capabilities)
+        : _device(device),
+          _p_capabilities(rp_capabilities)
     {
     }
 
@@ -55,24 +140,49 @@ public:
         return _device;
     }
 
+    const Capabilities& getCapabilities() const
+    {
+        if (!_p_capabilities) {
+            throw std::runtime_error("Uninitialized physical device has no capabilities");
+        }
+        return *_p_capabilities;
+    }
+
+    /// @brief Get the capability snapshot shared by all copies of the device, for holding on to it.
+    const std::shared_ptr<const Capabilities>& getSharedCapabilities() const noexcept
+    {
+        return _p_capabilities;
+    }
+
     ///@}
     ///@name Queries
     ///@{
 
-    VkPhysicalDeviceProperties getProperties() const
+    const VkPhysicalDeviceProperties& getProperties() const
     {
-        VkPhysicalDeviceProperties properties;
-        vkGetPhysicalDeviceProperties(_device, &properties);
-        return properties;
+        return this->getCapabilities().properties;
     }
 
-    VkPhysicalDeviceFeatures getFeatures() const
+    const VkPhysicalDeviceFeatures& getFeatures() const
     {
-        VkPhysicalDeviceFeatures features;
-        vkGetPhysicalDeviceFeatures(_device, &features);
-        return features;
+        return this->getCapabilities().features;
+    }
+
+    const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const
+    {
+        return this->getCapabilities().memoryProperties;
+    }
+
+    bool hasExtension(std::string_view name) const
+    {
+        return this->getCapabilities().hasExtension(name);
     }
 
+    bool hasFeature(Feature feature) const;
+
+    /// @brief Get the extension that provides a feature on this device, nullptr if it is part of the core API.
+    const char* getFeatureExtension(Feature feature) const;
+
     std::string getName() const
     {
         return this->getProperties().deviceName;
@@ -81,30 +191,37 @@ public:
     UUID getUUID() const
     {
         UUID id;
-        const auto properties = this->getProperties();
-        std::copy(properties.pipelineCacheUUID,
-                  properties.pipelineCacheUUID + id.size(),
+        const auto& r_properties = this->getProperties();
+        std::copy(r_properties.pipelineCacheUUID,
+                  r_properties.pipelineCacheUUID + id.size(),
                   id.begin());
         return id;
     }
 
+    /// @note Presentation support depends on the surface, so it is queried on every call.
     QueueFamily getQueueFamily(std::optional<VkSurfaceKHR> surface) const
     {
         QueueFamily family;
+        const auto& r_families = this->getCapabilities().queueFamilies;
 
-        uint32_t numberOfFamilies = 0;
-        vkGetPhysicalDeviceQueueFamilyProperties(_device, &numberOfFamilies, nullptr);
-        std::vector<VkQueueFamilyProperties> families(numberOfFamilies);
-        vkGetPhysicalDeviceQueueFamilyProperties(_device, &numberOfFamilies, families.data());
-
-        for (std::size_t i=0; i<families.size(); ++i) {
-            const auto& r_family = families[i];
+        for (std::size_t i=0; i<r_families.size(); ++i) {
+            const auto& r_family = r_families[i];
             assert(i < std::numeric_limits<uint32_t>::max());
 
-            if (r_family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            const bool isGraphics = r_family.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+            const bool isCompute = r_family.queueFlags & VK_QUEUE_COMPUTE_BIT;
+            if (isGraphics) {
                 family.graphics.emplace(i);
             } // graphics
 
+            if (isCompute && !isGraphics && !family.compute.has_value()) {
+                family.compute.emplace(i);
+            } // compute
+
+            if ((r_family.queueFlags & VK_QUEUE_TRANSFER_BIT) && !isGraphics && !isCompute && !family.transfer.has_value()) {
+                family.transfer.emplace(i);
+            } // transfer
+
             if (surface.has_value()) {
                 VkBool32 hasPresentationSupport = false;
                 vkGetPhysicalDeviceSurfaceSupportKHR(_device,
@@ -149,8 +266,12 @@ public:
         return output;
     }
 
-    static std::optional<PhysicalDevice> getDefaultDevice(const VkInstance& r_vulkanInstance,
-                                                          const VkSurfaceKHR& r_surface)
+    /// @brief Get all physical devices suitable for rendering, most suitable first.
+    /// @param surface surface the devices must be able to present to, if any.
+    ///                Headless setups pass an empty optional, in which case
+    ///                presentation support is not required.
+    static std::vector<PhysicalDevice> getSuitableDevices(const VkInstance& r_vulkanInstance,
+                                                          std::optional<VkSurfaceKHR> surface)
     {
         auto devices = PhysicalDevice::getDevices(r_vulkanInstance);
         std::vector<std::tuple<
@@ -163,79 +284,99 @@ public:
         std::transform(devices.begin(),
                        devices.end(),
                        std::back_inserter(deviceParams),
-                       [&r_surface](PhysicalDevice device) {
+                       [&surface](PhysicalDevice device) {
                            return std::make_tuple(
                                device,
                                device.getProperties(),
                                device.getFeatures(),
-                               device.getQueueFamily(r_surface)
+                               device.getQueueFamily(surface)
                            ); // make_tuple
                        }); // std::transform
 
         std::erase_if(
             deviceParams,
-            [](const auto& r_tuple) -> bool {
+            [&surface](const auto& r_tuple) -> bool {
                 const auto& r_properties = std::get<1>(r_tuple);
                 const auto& r_features = std::get<2>(r_tuple);
                 const auto& r_family = std::get<3>(r_tuple);
 
+                // Software implementations (VK_PHYSICAL_DEVICE_TYPE_CPU) are accepted
+                // so that headless runs work on machines without a GPU.
                 bool isSuitable = true;
                 isSuitable &= (r_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU
-                               || r_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU);
+                               || r_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU
+                               || r_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU);
                 isSuitable &= r_features.geometryShader;
-                isSuitable &= r_family.presentation.has_value();
+                isSuitable &= r_family.graphics.has_value();
+                isSuitable &= !surface.has_value() || r_family.presentation.has_value();
 
                 return !isSuitable;
             } // erasePredicate
         ); // std::erase_if
 
+        // Order the devices. Each criterion only breaks ties of the ones before it,
+        // and equivalent devices keep their enumeration order.
+        std::stable_sort(deviceParams.begin(),
+                         deviceParams.end(),
+                         [](const auto& r_left, const auto& r_right) -> bool {
+                             const auto& r_lProp = std::get<1>(r_left);
+                             const auto& r_rProp = std::get<1>(r_right);
+                             const auto& r_lFeats = std::get<2>(r_left);
+                             const auto& r_rFeats = std::get<2>(r_right);
+                             const auto& r_lFamily = std::get<3>(r_left);
+                             const auto& r_rFamily = std::get<3>(r_right);
+
+                             // Prefer discrete GPUs
+                             const bool lDiscrete = r_lProp.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+                             const bool rDiscrete = r_rProp.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
+                             if (lDiscrete != rDiscrete)
+                                 return lDiscrete;
+
+                             // Prefer GPUs supporting larger images
+                             if (r_lProp.limits.maxImageDimension2D != r_rProp.limits.maxImageDimension2D)
+                                 return r_rProp.limits.maxImageDimension2D < r_lProp.limits.maxImageDimension2D;
+
+                             // Prefer GPUs that support graphics and presentation on the same queue
+                             const bool lShared = r_lFamily.graphics == r_lFamily.presentation;
+                             const bool rShared = r_rFamily.graphics == r_rFamily.presentation;
+                             if (lShared != rShared)
+                                 return lShared;
+
+                             // Prefer GPUs with 64 bit floating point support
+                             return r_lFeats.shaderFloat64 && !r_rFeats.shaderFloat64;
+                         }); // comparisonFunction
+
+        std::vector<PhysicalDevice> output;
+        output.reserve(deviceParams.size());
+        for (const auto& r_tuple : deviceParams) {
+            output.push_back(std::get<0>(r_tuple));
+        }
+        return output;
+    }
+
+    /// @brief Pick the most suitable physical device (see @ref getSuitableDevices).
+    /// @param surface surface the device must be able to present to, if any.
+    static std::optional<PhysicalDevice> getDefaultDevice(const VkInstance& r_vulkanInstance,
+                                                          std::optional<VkSurfaceKHR> surface)
+    {
+        auto devices = PhysicalDevice::getSuitableDevices(r_vulkanInstance, surface);
+
         std::optional<PhysicalDevice> pick;
         if (!devices.empty()) {
-            // Order the devices
-            std::sort(deviceParams.begin(),
-                      deviceParams.end(),
-                      [](const auto& r_left, const auto& r_right) -> bool {
-                          const auto& r_lProp = std::get<1>(r_left);
-                          const auto& r_rProp = std::get<1>(r_right);
-                          const auto& r_lFeats = std::get<2>(r_left);
-                          const auto& r_rFeats = std::get<2>(r_right);
-                          const auto& r_lFamily = std::get<3>(r_left);
-                          const auto& r_rFamily = std::get<3>(r_right);
-
-                          // Prefer discrete GPUs
-                          if (r_lProp.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU && r_rProp.deviceType != VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
-                              return true;
-
-                          // Prefer GPUs with more memory
-                          if (r_lProp.limits.maxImageDimension2D > r_rProp.limits.maxImageDimension2D)
-                              return true;
-
-                          // Prefer GPUs that support graphics and presentation on the same queue
-                          if ((r_lFamily.graphics.value() == r_lFamily.presentation.value()) && (r_rFamily.graphics.value() != r_rFamily.presentation.value()))
-                            return true;
-
-                          // Prefer GPUs with 64 bit floating point support
-                          if (r_lFeats.shaderFloat64 && !r_rFeats.shaderFloat64)
-                            return true;
-
-                          return false;
-                      }); // comparisonFunction
             pick.emplace(devices.front());
-        } // if devices
+        }
 
         return pick;
     }
 
-    static VkPhysicalDeviceFeatures makeFeatures(std::span<const Feature> features)
-    {
-        if (!features.empty()) {
-            throw std::runtime_error("Physical device features are not implemented");
-        }
-        return VkPhysicalDeviceFeatures {};
-    }
+    /// @brief Fill the feature structs that enable @a features.
+    /// @note Whether the device supports them is checked by @ref hasFeature.
+    static Features makeFeatures(std::span<const Feature> features);
 
 private:
     VkPhysicalDevice _device;
+
+    std::shared_ptr<const Capabilities> _p_capabilities;
 }; // class PhysicalDevice
 
 
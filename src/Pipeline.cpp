@@ -0,0 +1,260 @@
+// --- Internal Includes ---
+#include "Pipeline.hpp"
+
+// --- STL Includes ---
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Create a render pass with a single color attachment that gets cleared on load.
+VkRenderPass makeRenderPass(VkDevice device,
+                            const VkAllocationCallbacks* p_allocationCallbacks,
+                            VkFormat colorFormat,
+                            VkImageLayout finalLayout)
+{
+    VkAttachmentDescription attachment {};
+    attachment.format = colorFormat;
+    attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    attachment.finalLayout = finalLayout;
+
+    VkAttachmentReference reference {};
+    reference.attachment = 0;
+    reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &reference;
+
+    // Don't write the attachment before the image is acquired
+    // (the acquire semaphore is waited on at this stage).
+    VkSubpassDependency dependency {};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.srcAccessMask = 0;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    VkRenderPassCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.attachmentCount = 1;
+    info.pAttachments = &attachment;
+    info.subpassCount = 1;
+    info.pSubpasses = &subpass;
+    info.dependencyCount = 1;
+    info.pDependencies = &dependency;
+
+    VkRenderPass renderPass;
+    if (vkCreateRenderPass(device, &info, p_allocationCallbacks, &renderPass) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create render pass");
+    }
+    return renderPass;
+}
+
+
+} // unnamed namespace
+
+
+Pipeline::Pipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+                   std::optional<std::shared_ptr<ShaderIO>> p_vertexShaderIO,
+                   std::optional<std::shared_ptr<ShaderIO>> p_fragmentShaderIO,
+                   VkFormat colorFormat,
+                   VkImageLayout finalLayout,
+                   const std::shared_ptr<PipelineCache>& rp_cache)
+    : _p_device(rp_device),
+      _p_vertexShader(),
+      _p_fragmentShader(),
+      _renderPass(VK_NULL_HANDLE),
+      _layout(VK_NULL_HANDLE),
+      _pipeline(VK_NULL_HANDLE)
+{
+    const VkDevice device = _p_device->getDevice();
+
+    // Shader stages
+    if (!p_vertexShaderIO.has_value() || !p_vertexShaderIO.value()) {
+        throw std::runtime_error("Graphics pipelines require a vertex shader");
+    }
+
+    std::vector<VkPipelineShaderStageCreateInfo> stages;
+    const auto addStage = [&stages](const Shader& r_shader, VkShaderStageFlagBits stage) {
+        VkPipelineShaderStageCreateInfo info {};
+        info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        info.stage = stage;
+        info.module = r_shader.get();
+        info.pName = "main";
+        stages.push_back(info);
+    };
+
+    _p_vertexShader = std::make_unique<Shader>(*p_vertexShaderIO.value(), *_p_device);
+    addStage(*_p_vertexShader, VK_SHADER_STAGE_VERTEX_BIT);
+
+    if (p_fragmentShaderIO.has_value() && p_fragmentShaderIO.value()) {
+        _p_fragmentShader = std::make_unique<Shader>(*p_fragmentShaderIO.value(), *_p_device);
+        addStage(*_p_fragmentShader, VK_SHADER_STAGE_FRAGMENT_BIT);
+    }
+
+    // Fixed function state
+    // - vertices are generated in the vertex shader, so there's no vertex input
+    VkPipelineVertexInputStateCreateInfo vertexInput {};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    // - viewport and scissor are set when recording (dynamic state)
+    VkPipelineViewportStateCreateInfo viewport {};
+    viewport.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewport.viewportCount = 1;
+    viewport.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterization {};
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.depthClampEnable = VK_FALSE;
+    rasterization.rasterizerDiscardEnable = VK_FALSE;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_BACK_BIT;
+    rasterization.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    rasterization.depthBiasEnable = VK_FALSE;
+    rasterization.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample {};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    multisample.sampleShadingEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState blendAttachment {};
+    blendAttachment.blendEnable = VK_FALSE;
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT
+                                     | VK_COLOR_COMPONENT_G_BIT
+                                     | VK_COLOR_COMPONENT_B_BIT
+                                     | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo blend {};
+    blend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    blend.logicOpEnable = VK_FALSE;
+    blend.attachmentCount = 1;
+    blend.pAttachments = &blendAttachment;
+
+    const std::array<VkDynamicState,2> dynamicStates {VK_DYNAMIC_STATE_VIEWPORT,
+                                                      VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic {};
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamic.pDynamicStates = dynamicStates.data();
+
+    // Layout and render pass
+    VkPipelineLayoutCreateInfo layoutInfo {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    if (vkCreatePipelineLayout(device, &layoutInfo, _p_device->getAllocationCallbacks(), &_layout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline layout");
+    }
+
+    try {
+        _renderPass = makeRenderPass(device, _p_device->getAllocationCallbacks(), colorFormat, finalLayout);
+    } catch (...) {
+        vkDestroyPipelineLayout(device, _layout, _p_device->getAllocationCallbacks());
+        throw;
+    }
+
+    // Assemble the pipeline
+    VkGraphicsPipelineCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount = static_cast<uint32_t>(stages.size());
+    info.pStages = stages.data();
+    info.pVertexInputState = &vertexInput;
+    info.pInputAssemblyState = &inputAssembly;
+    info.pViewportState = &viewport;
+    info.pRasterizationState = &rasterization;
+    info.pMultisampleState = &multisample;
+    info.pColorBlendState = &blend;
+    info.pDynamicState = &dynamic;
+    info.layout = _layout;
+    info.renderPass = _renderPass;
+    info.subpass = 0;
+    info.basePipelineHandle = VK_NULL_HANDLE;
+    info.basePipelineIndex = -1;
+
+    // Ask the driver whether the pipeline came from the cache. Without
+    // creation feedback there's no reliable way to tell, so the result
+    // is recorded as unknown.
+    const bool hasFeedback = _p_device->hasExtension(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+    VkPipelineCreationFeedbackEXT feedback {};
+    VkPipelineCreationFeedbackCreateInfoEXT feedbackInfo {};
+    feedbackInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+    feedbackInfo.pPipelineCreationFeedback = &feedback;
+
+    if (rp_cache && hasFeedback) {
+        info.pNext = &feedbackInfo;
+    }
+
+    if (vkCreateGraphicsPipelines(device,
+                                  rp_cache ? rp_cache->get() : VK_NULL_HANDLE,
+                                  1,
+                                  &info,
+                                  _p_device->getAllocationCallbacks(),
+                                  &_pipeline) != VK_SUCCESS) {
+        vkDestroyRenderPass(device, _renderPass, _p_device->getAllocationCallbacks());
+        vkDestroyPipelineLayout(device, _layout, _p_device->getAllocationCallbacks());
+        throw std::runtime_error("Failed to create graphics pipeline");
+    }
+
+    if (rp_cache) {
+        if (hasFeedback) {
+            rp_cache->record(feedback);
+        } else {
+            rp_cache->recordUnknown();
+        }
+    }
+}
+
+
+Pipeline::Pipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+                   const Description& r_description,
+                   const std::shared_ptr<PipelineCache>& rp_cache)
+    : Pipeline(rp_device,
+               r_description.vertexShader,
+               r_description.fragmentShader,
+               r_description.colorFormat,
+               r_description.finalLayout,
+               rp_cache)
+{
+}
+
+
+Pipeline::~Pipeline()
+{
+    const VkDevice device = _p_device->getDevice();
+    vkDestroyPipeline(device, _pipeline, _p_device->getAllocationCallbacks());
+    vkDestroyRenderPass(device, _renderPass, _p_device->getAllocationCallbacks());
+    vkDestroyPipelineLayout(device, _layout, _p_device->getAllocationCallbacks());
+}
+
+
+VkPipeline Pipeline::get() const noexcept
+{
+    return _pipeline;
+}
+
+
+VkPipelineLayout Pipeline::getLayout() const noexcept
+{
+    return _layout;
+}
+
+
+VkRenderPass Pipeline::getRenderPass() const noexcept
+{
+    return _renderPass;
+}
@@ -6,17 +6,72 @@
 // --- Internal Includes ---
 #include "Shader.hpp"
 #include "LogicalDevice.hpp"
+#include "PipelineCache.hpp"
 
 // --- STL Includes ---
+#include <memory>
 #include <optional>
 
 
+/// @brief Graphics pipeline rendering into a single color attachment.
+/// @details Owns the render pass and pipeline layout it was created with.
+///          Viewport and scissor are dynamic states, so the pipeline can
+///          be reused with render targets of any extent.
 class Pipeline
 {
 public:
-    Pipeline(std::optional<std::shared_ptr<ShaderIO>> p_vertexShaderIO,
-             std::optional<std::shared_ptr<ShaderIO>> p_fragmentShaderIO)
+    /// @brief Everything a @ref Pipeline is built from, so that it can be created elsewhere (see @ref PipelineCompiler).
+    struct Description
     {
-    }
+        std::shared_ptr<ShaderIO> vertexShader;
 
-};
+        /// @brief Optional, may be null.
+        std::shared_ptr<ShaderIO> fragmentShader;
+
+        VkFormat colorFormat = VK_FORMAT_B8G8R8A8_SRGB;
+
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    }; // struct Description
+
+public:
+    /// @param rp_cache cache to look up and store the compiled pipeline in, if any.
+    Pipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+             std::optional<std::shared_ptr<ShaderIO>> p_vertexShaderIO,
+             std::optional<std::shared_ptr<ShaderIO>> p_fragmentShaderIO,
+             VkFormat colorFormat,
+             VkImageLayout finalLayout,
+             const std::shared_ptr<PipelineCache>& rp_cache = {});
+
+    /// @param rp_cache cache to look up and store the compiled pipeline in, if any.
+    Pipeline(const std::shared_ptr<LogicalDevice>& rp_device,
+             const Description& r_description,
+             const std::shared_ptr<PipelineCache>& rp_cache = {});
+
+    Pipeline(const Pipeline&) = delete;
+
+    ~Pipeline();
+
+    /// @name Member Access
+    /// @{
+
+    VkPipeline get() const noexcept;
+
+    VkPipelineLayout getLayout() const noexcept;
+
+    VkRenderPass getRenderPass() const noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    std::unique_ptr<Shader> _p_vertexShader;
+
+    std::unique_ptr<Shader> _p_fragmentShader;
+
+    VkRenderPass _renderPass;
+
+    VkPipelineLayout _layout;
+
+    VkPipeline _pipeline;
+}; // class Pipeline
@@ -0,0 +1,232 @@
+// --- Internal Includes ---
+#include "PipelineCache.hpp"
+#include "CacheFile.hpp"
+
+// --- STL Includes ---
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+
+/// @brief Written in front of the blob returned by @a vkGetPipelineCacheData, within the file's payload.
+/// @details Vulkan's own header already identifies the vendor, device and cache UUID,
+///          but not the driver version, which is why this one exists.
+struct DeviceHeader
+{
+    uint32_t vendorID;
+
+    uint32_t deviceID;
+
+    uint32_t driverVersion;
+
+    PhysicalDevice::UUID uuid;
+}; // struct DeviceHeader
+
+
+constexpr CacheFile::Magic fileMagic {'V', 'K', 'P', 'C'};
+
+
+constexpr uint32_t fileVersion = 2;
+
+
+/// @brief Header at the beginning of every blob returned by @a vkGetPipelineCacheData (VK_PIPELINE_CACHE_HEADER_VERSION_ONE).
+struct VulkanCacheHeader
+{
+    uint32_t headerSize;
+
+    uint32_t headerVersion;
+
+    uint32_t vendorID;
+
+    uint32_t deviceID;
+
+    PhysicalDevice::UUID uuid;
+}; // struct VulkanCacheHeader
+
+
+/// @brief Read a cache file and return its blob if it was written for the same device and driver.
+/// @return the validated blob, or an empty vector if the file is missing, corrupt or incompatible.
+std::vector<char> readBlob(const std::filesystem::path& r_path,
+                           const VkPhysicalDeviceProperties& r_properties)
+{
+    const auto contents = CacheFile::read(r_path, fileMagic, fileVersion);
+    if (!contents.has_value() || contents->size() < sizeof(DeviceHeader)) {
+        return {};
+    }
+
+    // Check the device header against the current device and driver
+    DeviceHeader header;
+    std::memcpy(&header, contents->data(), sizeof(header));
+    if (header.vendorID != r_properties.vendorID
+        || header.deviceID != r_properties.deviceID
+        || header.driverVersion != r_properties.driverVersion
+        || std::memcmp(header.uuid.data(), r_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return {};
+    }
+
+    // Check Vulkan's header as well, drivers are not required to validate it
+    const char* p_data = contents->data() + sizeof(header);
+    const std::size_t dataSize = contents->size() - sizeof(header);
+    VulkanCacheHeader vulkanHeader;
+    if (dataSize < sizeof(vulkanHeader)) {
+        return {};
+    }
+    std::memcpy(&vulkanHeader, p_data, sizeof(vulkanHeader));
+    if (vulkanHeader.headerSize < sizeof(vulkanHeader)
+        || vulkanHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+        || vulkanHeader.vendorID != r_properties.vendorID
+        || vulkanHeader.deviceID != r_properties.deviceID
+        || std::memcmp(vulkanHeader.uuid.data(), r_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        return {};
+    }
+
+    return std::vector<char>(p_data, p_data + dataSize);
+}
+
+
+VkPipelineCache createCache(VkDevice device,
+                            const VkAllocationCallbacks* p_allocationCallbacks,
+                            const std::vector<char>& r_blob)
+{
+    VkPipelineCacheCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    info.initialDataSize = r_blob.size();
+    info.pInitialData = r_blob.empty() ? nullptr : r_blob.data();
+
+    VkPipelineCache cache;
+    if (vkCreatePipelineCache(device, &info, p_allocationCallbacks, &cache) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline cache");
+    }
+    return cache;
+}
+
+
+} // unnamed namespace
+
+
+PipelineCache::PipelineCache(const std::shared_ptr<LogicalDevice>& rp_device,
+                             std::filesystem::path&& r_path)
+    : _p_device(rp_device),
+      _path(std::move(r_path)),
+      _cache(VK_NULL_HANDLE),
+      _isWarm(false),
+      _hits(0),
+      _misses(0),
+      _unknown(0)
+{
+    const auto blob = readBlob(_path, _p_device->getPhysicalDevice().getProperties());
+    _isWarm = !blob.empty();
+    _cache = createCache(_p_device->getDevice(), _p_device->getAllocationCallbacks(), blob);
+}
+
+
+PipelineCache::~PipelineCache()
+{
+    try {
+        this->save();
+    } catch (const std::exception& r_exception) {
+        std::cerr << "Failed to save pipeline cache to " << _path << ": " << r_exception.what() << '\n';
+    }
+
+    vkDestroyPipelineCache(_p_device->getDevice(), _cache, _p_device->getAllocationCallbacks());
+}
+
+
+void PipelineCache::save()
+{
+    const VkDevice device = _p_device->getDevice();
+    const auto properties = _p_device->getPhysicalDevice().getProperties();
+
+    // Another process may have written the file since it was loaded,
+    // so merge its contents instead of overwriting them.
+    {
+        const auto onDisk = readBlob(_path, properties);
+        if (!onDisk.empty()) {
+            VkPipelineCache diskCache = createCache(device, _p_device->getAllocationCallbacks(), onDisk);
+            const VkResult result = vkMergePipelineCaches(device, _cache, 1, &diskCache);
+            vkDestroyPipelineCache(device, diskCache, _p_device->getAllocationCallbacks());
+            if (result != VK_SUCCESS) {
+                throw std::runtime_error("Failed to merge pipeline caches");
+            }
+        }
+    }
+
+    std::size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device, _cache, &dataSize, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to query pipeline cache size");
+    }
+
+    // Leave room for the device header in front of the blob
+    std::vector<char> data(sizeof(DeviceHeader) + dataSize);
+    if (vkGetPipelineCacheData(device, _cache, &dataSize, data.data() + sizeof(DeviceHeader)) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to get pipeline cache data");
+    }
+    data.resize(sizeof(DeviceHeader) + dataSize);
+
+    DeviceHeader header {};
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::copy(properties.pipelineCacheUUID,
+              properties.pipelineCacheUUID + header.uuid.size(),
+              header.uuid.begin());
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    CacheFile::write(_path, fileMagic, fileVersion, data);
+}
+
+
+VkPipelineCache PipelineCache::get() const noexcept
+{
+    return _cache;
+}
+
+
+const std::filesystem::path& PipelineCache::getPath() const noexcept
+{
+    return _path;
+}
+
+
+bool PipelineCache::isWarm() const noexcept
+{
+    return _isWarm;
+}
+
+
+PipelineCache::Statistics PipelineCache::getStatistics() const noexcept
+{
+    Statistics statistics;
+    statistics.hits = _hits.load(std::memory_order_relaxed);
+    statistics.misses = _misses.load(std::memory_order_relaxed);
+    statistics.unknown = _unknown.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
+void PipelineCache::record(bool hit) noexcept
+{
+    (hit ? _hits : _misses).fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void PipelineCache::record(const VkPipelineCreationFeedbackEXT& r_feedback) noexcept
+{
+    if (r_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) {
+        this->record(static_cast<bool>(r_feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT));
+    } else {
+        this->recordUnknown();
+    }
+}
+
+
+void PipelineCache::recordUnknown() noexcept
+{
+    _unknown.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+
+/// @brief @a VkPipelineCache persisted on disk between runs.
+/// @details The cache is loaded from disk on construction and written back on
+///          destruction. Blobs written by a different device, vendor or driver
+///          version are discarded, and the cache starts out empty instead.
+///          The file is written through @ref CacheFile, so a crash never leaves
+///          a truncated cache behind.
+class PipelineCache
+{
+public:
+    struct Statistics
+    {
+        /// @brief Number of pipelines found in the cache.
+        std::size_t hits = 0;
+
+        /// @brief Number of pipelines that had to be compiled.
+        std::size_t misses = 0;
+
+        /// @brief Number of pipelines the driver gave no creation feedback for, so whether they hit is unknown.
+        std::size_t unknown = 0;
+    }; // struct Statistics
+
+public:
+    PipelineCache(const std::shared_ptr<LogicalDevice>& rp_device,
+                  std::filesystem::path&& r_path);
+
+    PipelineCache(const PipelineCache&) = delete;
+
+    /// @brief Write the cache back to disk and destroy it.
+    ~PipelineCache();
+
+    /// @brief Merge the cache with what's currently on disk, and write the result back.
+    void save();
+
+    /// @name Member Access
+    /// @{
+
+    VkPipelineCache get() const noexcept;
+
+    const std::filesystem::path& getPath() const noexcept;
+
+    /// @brief Check whether a compatible cache was loaded from disk on construction.
+    bool isWarm() const noexcept;
+
+    Statistics getStatistics() const noexcept;
+
+    /// @}
+    /// @name Bookkeeping
+    /// @{
+
+    /// @brief Record whether a pipeline created with this cache was a hit or a miss.
+    void record(bool hit) noexcept;
+
+    /// @brief Record the result of a pipeline creation from its feedback.
+    /// @details Records an unknown result if the driver didn't provide valid feedback.
+    void record(const VkPipelineCreationFeedbackEXT& r_feedback) noexcept;
+
+    /// @brief Record a pipeline creation without feedback, which may or may not have hit.
+    void recordUnknown() noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    std::filesystem::path _path;
+
+    VkPipelineCache _cache;
+
+    bool _isWarm;
+
+    std::atomic<std::size_t> _hits;
+
+    std::atomic<std::size_t> _misses;
+
+    std::atomic<std::size_t> _unknown;
+}; // class PipelineCache
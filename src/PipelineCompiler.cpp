@@ -0,0 +1,44 @@
+// --- Internal Includes ---
+#include "PipelineCompiler.hpp"
+#include "Trace.hpp"
+
+
+PipelineCompiler::PipelineCompiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                                   const std::shared_ptr<PipelineCache>& rp_cache,
+                                   std::size_t threadCount)
+    : _p_device(rp_device),
+      _p_cache(rp_cache),
+      _pool(threadCount)
+{
+}
+
+
+PipelineCompiler::~PipelineCompiler()
+{
+}
+
+
+PipelineCompiler::Result PipelineCompiler::compile(const Pipeline::Description& r_description)
+{
+    return _pool.submit([p_device = _p_device, p_cache = _p_cache, description = r_description]() {
+        VKTUTORIAL_TRACE_SCOPE("PipelineCompiler::compile");
+        return std::make_shared<Pipeline>(p_device, description, p_cache);
+    });
+}
+
+
+std::vector<PipelineCompiler::Result> PipelineCompiler::compile(std::span<const Pipeline::Description> descriptions)
+{
+    std::vector<Result> results;
+    results.reserve(descriptions.size());
+    for (const auto& r_description : descriptions) {
+        results.push_back(this->compile(r_description));
+    }
+    return results;
+}
+
+
+std::size_t PipelineCompiler::getThreadCount() const noexcept
+{
+    return _pool.size();
+}
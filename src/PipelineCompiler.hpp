@@ -0,0 +1,54 @@
+#pragma once
+
+// --- Internal Includes ---
+#include "Pipeline.hpp"
+#include "PipelineCache.hpp"
+#include "LogicalDevice.hpp"
+#include "ThreadPool.hpp"
+
+// --- STL Includes ---
+#include <future>
+#include <memory>
+#include <span>
+#include <vector>
+
+
+/// @brief Creates pipelines in parallel on a pool of worker threads.
+/// @details Each @ref Pipeline::Description is compiled in its own job, which creates
+///          its shader modules (through the device's @ref ShaderModuleCache) and the
+///          pipeline itself. All jobs share a single @ref PipelineCache; Vulkan pipeline
+///          caches are internally synchronized.
+class PipelineCompiler
+{
+public:
+    using Result = std::future<std::shared_ptr<Pipeline>>;
+
+public:
+    /// @param rp_cache cache shared by all compiled pipelines, may be null.
+    /// @param threadCount number of worker threads; defaults to the number of hardware threads.
+    PipelineCompiler(const std::shared_ptr<LogicalDevice>& rp_device,
+                     const std::shared_ptr<PipelineCache>& rp_cache,
+                     std::size_t threadCount = std::thread::hardware_concurrency());
+
+    PipelineCompiler(const PipelineCompiler&) = delete;
+
+    /// @brief Waits for pending compilations.
+    ~PipelineCompiler();
+
+    /// @brief Schedule a single pipeline for compilation.
+    /// @return a future that resolves to the pipeline, or rethrows the compilation error.
+    Result compile(const Pipeline::Description& r_description);
+
+    /// @brief Schedule a batch of pipelines for compilation.
+    /// @return one future per description, in the same order; each resolves as soon as its pipeline is done.
+    std::vector<Result> compile(std::span<const Pipeline::Description> descriptions);
+
+    std::size_t getThreadCount() const noexcept;
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    std::shared_ptr<PipelineCache> _p_cache;
+
+    ThreadPool _pool;
+}; // class PipelineCompiler
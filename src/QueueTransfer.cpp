@@ -0,0 +1,136 @@
+// --- Internal Includes ---
+#include "QueueTransfer.hpp"
+
+// --- STL Includes ---
+#include <vector>
+
+
+QueueTransfer::QueueTransfer(const LogicalDevice& r_device,
+                             LogicalDevice::QueueType source,
+                             LogicalDevice::QueueType destination)
+    : _sourceFamily(r_device.getQueueFamilyIndex(source)),
+      _destinationFamily(r_device.getQueueFamilyIndex(destination)),
+      _bufferBarriers(),
+      _imageBarriers()
+{
+}
+
+
+void QueueTransfer::addBuffer(VkBuffer buffer,
+                              VkDeviceSize offset,
+                              VkDeviceSize size)
+{
+    VkBufferMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = _sourceFamily;
+    barrier.dstQueueFamilyIndex = _destinationFamily;
+    barrier.buffer = buffer;
+    barrier.offset = offset;
+    barrier.size = size;
+    _bufferBarriers.push_back(barrier);
+}
+
+
+void QueueTransfer::addImage(VkImage image,
+                             const VkImageSubresourceRange& r_range,
+                             VkImageLayout oldLayout,
+                             VkImageLayout newLayout)
+{
+    VkImageMemoryBarrier barrier {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = _sourceFamily;
+    barrier.dstQueueFamilyIndex = _destinationFamily;
+    barrier.image = image;
+    barrier.subresourceRange = r_range;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    _imageBarriers.push_back(barrier);
+}
+
+
+void QueueTransfer::clear() noexcept
+{
+    _bufferBarriers.clear();
+    _imageBarriers.clear();
+}
+
+
+void QueueTransfer::release(VkCommandBuffer commandBuffer,
+                            VkPipelineStageFlags stage,
+                            VkAccessFlags access) const
+{
+    if (!this->isOwnershipTransfer() || this->isEmpty()) {
+        return;
+    }
+
+    // Destination access masks are ignored by the release; the acquire makes the writes visible
+    std::vector<VkBufferMemoryBarrier> bufferBarriers = _bufferBarriers;
+    for (auto& r_barrier : bufferBarriers) {
+        r_barrier.srcAccessMask = access;
+    }
+
+    std::vector<VkImageMemoryBarrier> imageBarriers = _imageBarriers;
+    for (auto& r_barrier : imageBarriers) {
+        r_barrier.srcAccessMask = access;
+    }
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         stage,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0,
+                         0, nullptr,
+                         static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                         static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+
+void QueueTransfer::acquire(VkCommandBuffer commandBuffer,
+                            VkPipelineStageFlags stage,
+                            VkAccessFlags access) const
+{
+    // The semaphore already orders the work if nothing changes hands
+    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+    if (this->isOwnershipTransfer()) {
+        bufferBarriers = _bufferBarriers;
+        for (auto& r_barrier : bufferBarriers) {
+            r_barrier.dstAccessMask = access;
+        }
+    }
+
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    for (const auto& r_barrier : _imageBarriers) {
+        if (this->isOwnershipTransfer() || r_barrier.oldLayout != r_barrier.newLayout) {
+            imageBarriers.push_back(r_barrier);
+            imageBarriers.back().dstAccessMask = access;
+            if (!this->isOwnershipTransfer()) {
+                imageBarriers.back().srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarriers.back().dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            }
+        }
+    }
+
+    if (bufferBarriers.empty() && imageBarriers.empty()) {
+        return;
+    }
+
+    // Starting at the stages the semaphore is waited on chains the barrier to the wait
+    vkCmdPipelineBarrier(commandBuffer,
+                         stage,
+                         stage,
+                         0,
+                         0, nullptr,
+                         static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                         static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+
+bool QueueTransfer::isOwnershipTransfer() const noexcept
+{
+    return _sourceFamily != _destinationFamily;
+}
+
+
+bool QueueTransfer::isEmpty() const noexcept
+{
+    return _bufferBarriers.empty() && _imageBarriers.empty();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <vector>
+
+
+/// @brief Hands buffers and images created with @a VK_SHARING_MODE_EXCLUSIVE from one queue type to another.
+/// @details Exclusive resources belong to a single queue family at a time. Moving them to
+///          another family takes a release barrier recorded on a queue of the source type,
+///          and a matching acquire barrier recorded on a queue of the destination type,
+///          which must wait on a semaphore the source submission signals.
+///
+///          If both types share a family, there is no ownership to transfer: the release
+///          records nothing, and the acquire only records the image layout transitions, if any.
+class QueueTransfer
+{
+public:
+    QueueTransfer(const LogicalDevice& r_device,
+                  LogicalDevice::QueueType source,
+                  LogicalDevice::QueueType destination);
+
+    /// @name Resources
+    /// @{
+
+    void addBuffer(VkBuffer buffer,
+                   VkDeviceSize offset = 0,
+                   VkDeviceSize size = VK_WHOLE_SIZE);
+
+    /// @details @a oldLayout and @a newLayout may be identical if the layout doesn't change.
+    void addImage(VkImage image,
+                  const VkImageSubresourceRange& r_range,
+                  VkImageLayout oldLayout,
+                  VkImageLayout newLayout);
+
+    /// @brief Forget all resources, to reuse the transfer for the next batch.
+    void clear() noexcept;
+
+    /// @}
+    /// @name Recording
+    /// @{
+
+    /// @brief Record the release half on a command buffer submitted to the source queue.
+    /// @param stage stages that last accessed the resources on the source queue.
+    /// @param access accesses to make available before the transfer.
+    void release(VkCommandBuffer commandBuffer,
+                 VkPipelineStageFlags stage,
+                 VkAccessFlags access) const;
+
+    /// @brief Record the acquire half on a command buffer submitted to the destination queue.
+    /// @param stage stages that access the resources next on the destination queue.
+    ///              The submission must wait on the source's semaphore at these stages.
+    /// @param access accesses the resources are made visible to.
+    void acquire(VkCommandBuffer commandBuffer,
+                 VkPipelineStageFlags stage,
+                 VkAccessFlags access) const;
+
+    /// @}
+    /// @name Queries
+    /// @{
+
+    /// @brief Check whether the source and destination belong to different queue families.
+    bool isOwnershipTransfer() const noexcept;
+
+    bool isEmpty() const noexcept;
+
+    /// @}
+
+private:
+    uint32_t _sourceFamily;
+
+    uint32_t _destinationFamily;
+
+    std::vector<VkBufferMemoryBarrier> _bufferBarriers;
+
+    std::vector<VkImageMemoryBarrier> _imageBarriers;
+}; // class QueueTransfer
@@ -0,0 +1,84 @@
+// --- Internal Includes ---
+#include "RenderTarget.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+#include <string>
+
+
+RenderTarget::ImageViews::View::View(RenderTarget& r_target,
+                                     std::size_t i_image)
+    : _view(),
+      _image(),
+      _device(r_target.getLogicalDevice().getDevice()),
+      _p_allocationCallbacks(r_target.getLogicalDevice().getAllocationCallbacks())
+{
+    if (r_target.getImages().size() <= i_image) {
+        throw std::runtime_error("Image view index out of range for render target of size " + std::to_string(r_target.getImages().size()));
+    }
+    _image = r_target.getImages()[i_image];
+
+    if (r_target.getImageFormat() == VK_FORMAT_UNDEFINED) {
+        throw std::runtime_error("The render target's image format does not exist\n");
+    }
+
+    VkImageViewCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    info.image = _image;
+    info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    info.format = r_target.getImageFormat();
+    info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+    info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+    info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+    info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+    info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    info.subresourceRange.baseMipLevel = 0;
+    info.subresourceRange.levelCount = 1;
+    info.subresourceRange.baseArrayLayer = 0;
+    info.subresourceRange.layerCount = 1;
+
+    if (vkCreateImageView(_device,
+                          &info,
+                          _p_allocationCallbacks,
+                          &_view) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create image view");
+    }
+}
+
+
+VkImageView RenderTarget::ImageViews::View::get()
+{
+    return _view;
+}
+
+
+RenderTarget::ImageViews::View::~View()
+{
+    vkDestroyImageView(_device, _view, _p_allocationCallbacks);
+}
+
+
+RenderTarget::ImageViews::ImageViews(const std::shared_ptr<RenderTarget> rp_target)
+    : ImageViews(rp_target,
+                 [](RenderTarget& r_target, std::size_t i_image) -> std::unique_ptr<View> {
+                    return std::make_unique<View>(r_target, i_image);
+                 })
+{}
+
+
+std::size_t RenderTarget::ImageViews::size() const noexcept
+{
+    return _views.size();
+}
+
+
+RenderTarget::ImageViews::View& RenderTarget::ImageViews::operator[](std::size_t i_image)
+{
+    return *_views.at(i_image);
+}
+
+
+RenderTarget& RenderTarget::ImageViews::getRenderTarget() noexcept
+{
+    return *_p_target;
+}
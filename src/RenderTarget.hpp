@@ -0,0 +1,136 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+
+// --- STL Includes ---
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+
+/// @brief Interface for a ring of images that frames get rendered into.
+/// @details Implemented by @ref SwapChain (presents to a window surface)
+///          and @ref OffscreenTarget (headless rendering without a window).
+class RenderTarget
+{
+public:
+    class ImageViews
+    {
+    public:
+        class View
+        {
+        public:
+            View() = delete;
+
+            View(View&&) noexcept = default;
+
+            View(const View&) = delete;
+
+            View(RenderTarget& r_target, std::size_t i_image);
+
+            VkImageView get();
+
+            virtual ~View();
+
+        private:
+            VkImageView _view;
+
+            VkImage _image;
+
+            VkDevice _device;
+
+            const VkAllocationCallbacks* _p_allocationCallbacks;
+        }; // class View
+
+    public:
+        ImageViews(const std::shared_ptr<RenderTarget> rp_target);
+
+        /// @tparam TViewFactory Factory function producing a unique pointer to a @ref View.
+        /// @tparam TFactoryArgs Additional arguments passed to @a TViewFactory after @ref RenderTarget and the image index.
+        template <class TViewFactory, class ...TFactoryArgs>
+        ImageViews(const std::shared_ptr<RenderTarget> rp_target,
+                   const TViewFactory& r_factory,
+                   const TFactoryArgs& ... r_factoryArgs)
+            : _views(),
+              _p_target(rp_target)
+        {
+            const std::size_t imageCount = rp_target->getImages().size();
+            _views.reserve(imageCount);
+            for (std::size_t i_image=0; i_image<imageCount; ++i_image) {
+                _views.emplace_back(r_factory(*rp_target,
+                                              i_image,
+                                              r_factoryArgs...));
+            }
+        }
+
+        /// @name Member Access
+        /// @{
+
+        std::size_t size() const noexcept;
+
+        View& operator[](std::size_t i_image);
+
+        RenderTarget& getRenderTarget() noexcept;
+
+        /// @}
+
+    private:
+        std::vector<std::unique_ptr<View>> _views;
+
+        std::shared_ptr<RenderTarget> _p_target;
+    }; // class ImageViews
+
+public:
+    virtual ~RenderTarget() = default;
+
+    /// @name Queries
+    /// @{
+
+    /// @brief Access the images frames are rendered into.
+    virtual std::vector<VkImage>& getImages() noexcept = 0;
+
+    virtual VkFormat getImageFormat() const noexcept = 0;
+
+    virtual VkExtent2D getImageExtent() const noexcept = 0;
+
+    /// @brief Layout images must be in when they are passed to @ref present.
+    virtual VkImageLayout getFinalLayout() const noexcept = 0;
+
+    /// @brief Check whether @ref acquire and @ref present synchronize through semaphores.
+    /// @details Targets that don't present anything (@ref OffscreenTarget) require
+    ///          @a VK_NULL_HANDLE semaphores and throw if they get any other.
+    virtual bool isPresentable() const noexcept = 0;
+
+    /// @brief Check whether the target has to be recreated before it can be rendered to again.
+    /// @details Set when the window surface changed (for example on resize), in which case
+    ///          @ref acquire fails or @ref present reports the image as suboptimal.
+    virtual bool isOutOfDate() const noexcept = 0;
+
+    virtual const LogicalDevice& getLogicalDevice() const noexcept = 0;
+
+    virtual LogicalDevice& getLogicalDevice() noexcept = 0;
+
+    /// @}
+    /// @name Frame Control
+    /// @{
+
+    /// @brief Get the index of the next image to render into.
+    /// @param signal semaphore to signal when the image is ready to be written; must be
+    ///               @a VK_NULL_HANDLE unless the target @ref isPresentable.
+    /// @return the image index, or @a std::nullopt if the target is out of date. @a signal
+    ///         isn't signaled in that case, and the target has to be recreated.
+    virtual std::optional<uint32_t> acquire(VkSemaphore signal) = 0;
+
+    /// @brief Hand a rendered image back to the target.
+    /// @param i_image index of the image returned by @ref acquire.
+    /// @param wait semaphore to wait on before the image is displayed; must be
+    ///             @a VK_NULL_HANDLE unless the target @ref isPresentable.
+    virtual void present(uint32_t i_image, VkSemaphore wait) = 0;
+
+    /// @}
+}; // class RenderTarget
@@ -7,6 +7,50 @@
 // --- STL Includes ---
 #include <fstream>
 #include <vulkan/vulkan_core.h>
+#include <algorithm>
+#include <string>
+
+#ifdef VKTUTORIAL_EMBED_SHADERS
+// --- Generated Includes ---
+#include "embedded_shaders.hpp"
+#endif
+
+// --- POSIX Includes ---
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+
+
+constexpr uint32_t spirvMagic = 0x07230203u;
+
+
+/// @brief Look up an embedded shader by name.
+/// @return the shader's words, or an empty span if it wasn't embedded.
+std::span<const uint32_t> findEmbeddedShader([[maybe_unused]] std::string_view name) noexcept
+{
+    #ifdef VKTUTORIAL_EMBED_SHADERS
+    const auto it_shader = std::find_if(std::begin(embedded::shaders),
+                                        std::end(embedded::shaders),
+                                        [name](const embedded::Entry& r_entry) {return r_entry.name == name;});
+    if (it_shader != std::end(embedded::shaders)) {
+        return it_shader->spirv;
+    }
+    #endif
+    return {};
+}
+
+
+} // unnamed namespace
+
+
+std::span<const uint32_t> ShaderIO::view() const noexcept
+{
+    return {};
+}
 
 
 void ShaderIO::loadSpirv(std::istream& r_stream,
@@ -55,38 +99,125 @@ std::vector<char> SpirvShaderIO::load() const
 }
 
 
+MappedSpirvShaderIO::MappedSpirvShaderIO(std::filesystem::path&& r_spirv)
+    : _spirv(std::move(r_spirv)),
+      _p_mapping(nullptr),
+      _size(0)
+{
+    const int file = open(_spirv.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Failed to open shader " + _spirv.string());
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw std::runtime_error("Failed to query the size of shader " + _spirv.string());
+    }
+    _size = static_cast<std::size_t>(status.st_size);
+
+    if (_size == 0 || _size % sizeof(uint32_t)) {
+        close(file);
+        throw std::runtime_error("Shader " + _spirv.string() + " is not a sequence of 32 bit SPIR-V words");
+    }
+
+    _p_mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // <== the mapping stays valid after closing the descriptor
+    if (_p_mapping == MAP_FAILED) {
+        _p_mapping = nullptr;
+        throw std::runtime_error("Failed to map shader " + _spirv.string());
+    }
+
+    // The whole file gets read by the driver right away
+    madvise(_p_mapping, _size, MADV_WILLNEED);
+
+    // Mappings are page aligned, but check anyway since the driver requires it
+    if (reinterpret_cast<std::uintptr_t>(_p_mapping) % alignof(uint32_t)) {
+        munmap(_p_mapping, _size);
+        throw std::runtime_error("Mapped shader " + _spirv.string() + " is not 4-byte aligned");
+    }
+
+    const uint32_t magic = *static_cast<const uint32_t*>(_p_mapping);
+    if (magic != spirvMagic) {
+        munmap(_p_mapping, _size);
+        throw std::runtime_error("Shader " + _spirv.string() + " does not begin with the SPIR-V magic number in host byte order");
+    }
+}
+
+
+MappedSpirvShaderIO::~MappedSpirvShaderIO()
+{
+    if (_p_mapping) {
+        munmap(_p_mapping, _size);
+    }
+}
+
+
+std::vector<char> MappedSpirvShaderIO::load() const
+{
+    const char* p_begin = static_cast<const char*>(_p_mapping);
+    return std::vector<char>(p_begin, p_begin + _size);
+}
+
+
+std::span<const uint32_t> MappedSpirvShaderIO::view() const noexcept
+{
+    return {static_cast<const uint32_t*>(_p_mapping), _size / sizeof(uint32_t)};
+}
+
+
+EmbeddedShaderIO::EmbeddedShaderIO(std::string_view name)
+    : _spirv(findEmbeddedShader(name))
+{
+    if (_spirv.empty()) {
+        throw std::runtime_error("No embedded shader named " + std::string(name));
+    }
+
+    if (_spirv.front() != spirvMagic) {
+        throw std::runtime_error("Embedded shader " + std::string(name) + " does not begin with the SPIR-V magic number in host byte order");
+    }
+}
+
+
+std::vector<char> EmbeddedShaderIO::load() const
+{
+    const char* p_begin = reinterpret_cast<const char*>(_spirv.data());
+    return std::vector<char>(p_begin, p_begin + _spirv.size_bytes());
+}
+
+
+std::span<const uint32_t> EmbeddedShaderIO::view() const noexcept
+{
+    return _spirv;
+}
+
+
+bool EmbeddedShaderIO::isAvailable(std::string_view name) noexcept
+{
+    return !findEmbeddedShader(name).empty();
+}
+
+
 struct Shader::Impl
 {
     Impl(const ShaderIO& r_io,
          const LogicalDevice& r_device)
-        : vulkanDevice(r_device.getDevice()),
-          vulkanShader()
+        : module()
     {
-        const auto spirv = r_io.load();
-
-        VkShaderModuleCreateInfo info {};
-        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        info.codeSize = spirv.size();
-        info.pCode = reinterpret_cast<const uint32_t*>(spirv.data());
-
-        if (vkCreateShaderModule(this->vulkanDevice,
-                                 &info,
-                                 nullptr,
-                                 &this->vulkanShader) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create shader module\n");
-    }
-    }
+        // Prefer handing the words to the cache directly, and only
+        // load them into a temporary buffer if that's not possible.
+        std::span<const uint32_t> words = r_io.view();
+        std::vector<char> spirv;
+        if (words.empty()) {
+            spirv = r_io.load();
+            words = {reinterpret_cast<const uint32_t*>(spirv.data()), spirv.size() / sizeof(uint32_t)};
+        }
 
-    ~Impl()
-    {
-        vkDestroyShaderModule(this->vulkanDevice,
-                              this->vulkanShader,
-                              nullptr);
+        // Shaders with identical SPIR-V share a single module
+        this->module = r_device.getShaderModuleCache().acquire(words);
     }
 
-    VkDevice vulkanDevice;
-
-    VkShaderModule vulkanShader;
+    ShaderModuleCache::Handle module;
 };
 
 
@@ -100,3 +231,9 @@ Shader::Shader(const ShaderIO& r_io,
 Shader::~Shader()
 {
 }
+
+
+VkShaderModule Shader::get() const noexcept
+{
+    return _p_impl->module->module;
+}
@@ -7,6 +7,9 @@
 #include <filesystem>
 #include <iosfwd>
 #include <vector>
+#include <span>
+#include <cstdint>
+#include <string_view>
 
 
 class ShaderIO
@@ -16,6 +19,11 @@ public:
 
     virtual std::vector<char> load() const = 0;
 
+    /// @brief Access the SPIR-V words without copying them, if the implementation can.
+    /// @return a view of memory owned by the @ref ShaderIO, or an empty span if the
+    ///         words are only available through @ref load.
+    virtual std::span<const uint32_t> view() const noexcept;
+
 protected:
     void loadSpirv(std::istream& r_stream,
                    std::vector<char>& r_output) const;
@@ -35,6 +43,59 @@ private:
 }; // class SpirvShaderIO
 
 
+
+/// @brief Memory-maps a SPIR-V file and exposes its words directly through @ref view.
+/// @details The file is validated on construction: its size must be a nonzero multiple
+///          of 4 bytes, the mapping must be 4-byte aligned, and it must start with the
+///          SPIR-V magic number in host byte order. @ref Shader then passes the mapped
+///          words to the driver without any intermediate heap buffer.
+/// @note Relies on POSIX @a mmap.
+class MappedSpirvShaderIO final : public ShaderIO
+{
+public:
+    MappedSpirvShaderIO(std::filesystem::path&& r_spirv);
+
+    MappedSpirvShaderIO(const MappedSpirvShaderIO&) = delete;
+
+    ~MappedSpirvShaderIO() override;
+
+    std::vector<char> load() const override;
+
+    std::span<const uint32_t> view() const noexcept override;
+
+private:
+    std::filesystem::path _spirv;
+
+    void* _p_mapping;
+
+    std::size_t _size;
+}; // class MappedSpirvShaderIO
+
+
+
+/// @brief Exposes SPIR-V that was compiled into the executable.
+/// @details Shaders are embedded as @a constexpr word arrays in a header generated
+///          from the @a shaders build target if the project is configured with
+///          @a VKTUTORIAL_EMBED_SHADERS. No file system access is involved.
+class EmbeddedShaderIO final : public ShaderIO
+{
+public:
+    /// @param name file name of the compiled shader (e.g.: "vertexShader.vert.spv").
+    /// @throws std::runtime_error if no shader was embedded with the provided name.
+    EmbeddedShaderIO(std::string_view name);
+
+    std::vector<char> load() const override;
+
+    std::span<const uint32_t> view() const noexcept override;
+
+    /// @brief Check whether a shader with the provided name was embedded.
+    static bool isAvailable(std::string_view name) noexcept;
+
+private:
+    std::span<const uint32_t> _spirv;
+}; // class EmbeddedShaderIO
+
+
 class Shader
 {
 public:
@@ -43,6 +104,8 @@ public:
 
     ~Shader();
 
+    VkShaderModule get() const noexcept;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _p_impl;
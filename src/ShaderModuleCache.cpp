@@ -0,0 +1,191 @@
+// --- Internal Includes ---
+#include "ShaderModuleCache.hpp"
+
+// --- STL Includes ---
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+
+namespace {
+
+
+struct Key
+{
+    ShaderModuleCache::Hash hash;
+
+    std::size_t size;
+
+    bool operator==(const Key&) const noexcept = default;
+}; // struct Key
+
+
+struct KeyHash
+{
+    std::size_t operator()(const Key& r_key) const noexcept
+    {
+        return static_cast<std::size_t>(r_key.hash[0] ^ (r_key.size * 0x9e3779b97f4a7c15ull));
+    }
+}; // struct KeyHash
+
+
+/// @brief Finalizer from splitmix64.
+constexpr uint64_t mix(uint64_t value) noexcept
+{
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ull;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebull;
+    value ^= value >> 31;
+    return value;
+}
+
+
+} // unnamed namespace
+
+
+struct ShaderModuleCache::State
+{
+    struct Slot
+    {
+        std::weak_ptr<const Entry> p_entry;
+
+        /// @brief Identifies the entry the slot was created for, even after it expired.
+        const Entry* p_raw;
+    }; // struct Slot
+
+    VkDevice device;
+
+    const VkAllocationCallbacks* p_allocationCallbacks;
+
+    mutable std::mutex mutex;
+
+    std::unordered_map<Key,Slot,KeyHash> slots;
+
+    Statistics statistics;
+
+    /// @brief Find the live module of a key; the mutex must be held.
+    Handle find(const Key& r_key) const
+    {
+        const auto it_slot = slots.find(r_key);
+        return it_slot == slots.end() ? Handle() : it_slot->second.p_entry.lock();
+    }
+}; // struct ShaderModuleCache::State
+
+
+ShaderModuleCache::ShaderModuleCache(VkDevice device)
+    : ShaderModuleCache(device, nullptr)
+{
+}
+
+
+ShaderModuleCache::ShaderModuleCache(VkDevice device,
+                                     const VkAllocationCallbacks* p_allocationCallbacks)
+    : _p_state(std::make_shared<State>())
+{
+    _p_state->device = device;
+    _p_state->p_allocationCallbacks = p_allocationCallbacks;
+}
+
+
+ShaderModuleCache::~ShaderModuleCache()
+{
+}
+
+
+ShaderModuleCache::Handle ShaderModuleCache::acquire(std::span<const uint32_t> spirv)
+{
+    const Key key {ShaderModuleCache::hash(spirv), spirv.size_bytes()};
+
+    // Return the cached module if it's still alive
+    {
+        std::scoped_lock<std::mutex> lock(_p_state->mutex);
+        if (auto p_entry = _p_state->find(key)) {
+            ++_p_state->statistics.hits;
+            _p_state->statistics.bytesReused += key.size;
+            return p_entry;
+        }
+    }
+
+    // Create the module without holding the lock, since drivers may
+    // take a while, and other threads may be requesting other modules.
+    VkShaderModuleCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    info.codeSize = spirv.size_bytes();
+    info.pCode = spirv.data();
+
+    VkShaderModule module;
+    if (vkCreateShaderModule(_p_state->device, &info, _p_state->p_allocationCallbacks, &module) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create shader module");
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock(_p_state->mutex);
+        ++_p_state->statistics.liveModules;
+    }
+
+    // The deleter destroys the module and removes its slot, unless the slot
+    // belongs to a different module: a newer one created after this one expired,
+    // or the one that won the race against it.
+    const auto deleter = [p_state = _p_state](const Entry* p_entry) {
+        {
+            std::scoped_lock<std::mutex> lock(p_state->mutex);
+            auto it_slot = p_state->slots.find(Key {p_entry->hash, p_entry->size});
+            if (it_slot != p_state->slots.end() && it_slot->second.p_raw == p_entry) {
+                p_state->slots.erase(it_slot);
+            }
+            --p_state->statistics.liveModules;
+        }
+        vkDestroyShaderModule(p_state->device, p_entry->module, p_state->p_allocationCallbacks);
+        delete p_entry;
+    };
+
+    Handle p_created(new Entry {module, key.hash, key.size}, deleter);
+
+    // Another thread may have cached the same SPIR-V in the meantime, in which case
+    // its module is handed out, and the new one is destroyed once the lock is released.
+    std::scoped_lock<std::mutex> lock(_p_state->mutex);
+    if (auto p_entry = _p_state->find(key)) {
+        ++_p_state->statistics.hits;
+        ++_p_state->statistics.racesLost;
+        _p_state->statistics.bytesCreated += key.size;
+        return p_entry;
+    }
+
+    _p_state->slots[key] = State::Slot {p_created, p_created.get()};
+    ++_p_state->statistics.misses;
+    _p_state->statistics.bytesCreated += key.size;
+
+    return p_created;
+}
+
+
+ShaderModuleCache::Statistics ShaderModuleCache::getStatistics() const
+{
+    std::scoped_lock<std::mutex> lock(_p_state->mutex);
+    return _p_state->statistics;
+}
+
+
+ShaderModuleCache::Hash ShaderModuleCache::hash(std::span<const uint32_t> spirv) noexcept
+{
+    // Two independent lanes with different seeds, rotations and multipliers,
+    // consuming two words at a time
+    Hash hash {mix(spirv.size()), mix(spirv.size() ^ 0x243f6a8885a308d3ull)};
+    const auto consume = [&hash](uint64_t chunk) {
+        hash[0] = std::rotl(hash[0] ^ mix(chunk), 27) * 0x9e3779b97f4a7c15ull;
+        hash[1] = std::rotl(hash[1] ^ mix(chunk ^ 0x13198a2e03707344ull), 31) * 0xc2b2ae3d27d4eb4full;
+    };
+
+    std::size_t i_word = 0;
+    for (; i_word + 1 < spirv.size(); i_word += 2) {
+        consume(static_cast<uint64_t>(spirv[i_word]) | (static_cast<uint64_t>(spirv[i_word + 1]) << 32));
+    }
+
+    if (i_word < spirv.size()) {
+        consume(spirv[i_word]);
+    }
+
+    return Hash {mix(hash[0] ^ hash[1]), mix(hash[1])};
+}
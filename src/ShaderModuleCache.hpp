@@ -0,0 +1,88 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- STL Includes ---
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+
+/// @brief Shares @a VkShaderModules with identical SPIR-V across all @ref Shader instances of a device.
+/// @details Modules are keyed by a 128 bit hash of their SPIR-V words and their size; the
+///          SPIR-V itself isn't retained, so words borrowed from a mapped file or the
+///          executable are never copied. Accidental collisions of the hash are negligible.
+///          @ref acquire hands out reference counted @ref Handle "handles", and a module
+///          is destroyed as soon as its last handle goes away. Thread safe; modules are
+///          created outside the lock, so threads requesting different modules don't wait
+///          on each other.
+/// @note Every handle must be released before the @a VkDevice is destroyed.
+class ShaderModuleCache
+{
+public:
+    using Hash = std::array<uint64_t,2>;
+
+    struct Entry
+    {
+        VkShaderModule module;
+
+        /// @brief Hash of the SPIR-V words the module was created from.
+        Hash hash;
+
+        /// @brief Size of the SPIR-V the module was created from [bytes].
+        std::size_t size;
+    }; // struct Entry
+
+    /// @brief Reference counted access to a cached module.
+    using Handle = std::shared_ptr<const Entry>;
+
+    struct Statistics
+    {
+        /// @brief Number of requests that were served from the cache.
+        std::size_t hits = 0;
+
+        /// @brief Number of requests that created a new module.
+        std::size_t misses = 0;
+
+        /// @brief Total size of SPIR-V passed to the driver [bytes].
+        std::size_t bytesCreated = 0;
+
+        /// @brief Total size of SPIR-V that didn't have to be passed to the driver thanks to the cache [bytes].
+        std::size_t bytesReused = 0;
+
+        /// @brief Number of modules currently alive.
+        std::size_t liveModules = 0;
+
+        /// @brief Number of modules that were destroyed right away because another thread cached the same SPIR-V first.
+        /// @details These requests are counted as hits as well, but their SPIR-V as created rather than reused.
+        std::size_t racesLost = 0;
+    }; // struct Statistics
+
+public:
+    explicit ShaderModuleCache(VkDevice device);
+
+    /// @param p_allocationCallbacks host allocator modules are created and destroyed with; may be nullptr.
+    ShaderModuleCache(VkDevice device,
+                      const VkAllocationCallbacks* p_allocationCallbacks);
+
+    ShaderModuleCache(const ShaderModuleCache&) = delete;
+
+    ~ShaderModuleCache();
+
+    /// @brief Get a module created from the provided SPIR-V, creating it if it isn't cached yet.
+    Handle acquire(std::span<const uint32_t> spirv);
+
+    Statistics getStatistics() const;
+
+    /// @brief Hash SPIR-V words the same way the cache keys them.
+    static Hash hash(std::span<const uint32_t> spirv) noexcept;
+
+private:
+    struct State;
+
+    /// @brief Shared with the deleters of outstanding handles, which may outlive the cache.
+    std::shared_ptr<State> _p_state;
+}; // class ShaderModuleCache
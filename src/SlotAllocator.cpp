@@ -0,0 +1,88 @@
+// --- Internal Includes ---
+#include "SlotAllocator.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+
+
+SlotAllocator::SlotAllocator(uint32_t capacity,
+                             std::size_t framesInFlight)
+    : _capacity(capacity),
+      _end(0),
+      _count(0),
+      _freeSlots(),
+      _pendingSlots(framesInFlight),
+      _i_frame(0),
+      _isAllocated(capacity, false)
+{
+    if (framesInFlight == 0) {
+        throw std::runtime_error("Slot allocator requires at least one frame in flight");
+    }
+}
+
+
+void SlotAllocator::beginFrame()
+{
+    _i_frame = (_i_frame + 1) % _pendingSlots.size();
+    auto& r_pending = _pendingSlots[_i_frame];
+    _freeSlots.insert(_freeSlots.end(), r_pending.begin(), r_pending.end());
+    r_pending.clear();
+}
+
+
+std::optional<uint32_t> SlotAllocator::allocate()
+{
+    std::optional<uint32_t> slot;
+    if (!_freeSlots.empty()) {
+        slot.emplace(_freeSlots.back());
+        _freeSlots.pop_back();
+    } else if (_end < _capacity) {
+        slot.emplace(_end++);
+    } else {
+        return slot;
+    }
+
+    _isAllocated[slot.value()] = true;
+    ++_count;
+    return slot;
+}
+
+
+void SlotAllocator::free(uint32_t i_slot)
+{
+    if (!this->isAllocated(i_slot)) {
+        throw std::runtime_error("Freeing a slot that is not allocated");
+    }
+
+    _isAllocated[i_slot] = false;
+    --_count;
+    _pendingSlots[_i_frame].push_back(i_slot);
+}
+
+
+bool SlotAllocator::isAllocated(uint32_t i_slot) const noexcept
+{
+    return i_slot < _capacity && _isAllocated[i_slot];
+}
+
+
+uint32_t SlotAllocator::getCapacity() const noexcept
+{
+    return _capacity;
+}
+
+
+uint32_t SlotAllocator::getCount() const noexcept
+{
+    return _count;
+}
+
+
+uint32_t SlotAllocator::getPendingCount() const noexcept
+{
+    std::size_t count = 0;
+    for (const auto& r_pending : _pendingSlots) {
+        count += r_pending.size();
+    }
+    return static_cast<uint32_t>(count);
+}
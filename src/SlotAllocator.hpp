@@ -0,0 +1,61 @@
+#pragma once
+
+// --- STL Includes ---
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+/// @brief Hands out indices into a fixed size array, and recycles them once no frame in flight can use them.
+/// @details Indices that were never handed out are taken in increasing order, so the used part
+///          of the array stays compact. Freed indices are parked in the current frame slot, and
+///          go back to the free list when @ref beginFrame comes around to that slot again, i.e.
+///          once the device is done with every frame that may have referenced them. Recycled
+///          indices are handed out last in, first out.
+/// @note Not thread safe.
+class SlotAllocator
+{
+public:
+    SlotAllocator(uint32_t capacity,
+                  std::size_t framesInFlight);
+
+    /// @brief Move on to the next frame slot and recycle the indices freed in it.
+    /// @details The caller must make sure the device is done with the slot's previous frame,
+    ///          same as for @ref DescriptorAllocator::beginFrame.
+    void beginFrame();
+
+    /// @return a free index, or nullopt if all of them are taken.
+    std::optional<uint32_t> allocate();
+
+    /// @brief Return an index; it gets handed out again after @a framesInFlight frames.
+    void free(uint32_t i_slot);
+
+    /// @brief Check whether an index is handed out.
+    bool isAllocated(uint32_t i_slot) const noexcept;
+
+    uint32_t getCapacity() const noexcept;
+
+    /// @brief Get the number of indices handed out.
+    uint32_t getCount() const noexcept;
+
+    /// @brief Get the number of indices that were freed but are not recycled yet.
+    uint32_t getPendingCount() const noexcept;
+
+private:
+    uint32_t _capacity;
+
+    /// @brief First index that was never handed out.
+    uint32_t _end;
+
+    uint32_t _count;
+
+    std::vector<uint32_t> _freeSlots;
+
+    /// @brief Indices freed in each frame slot.
+    std::vector<std::vector<uint32_t>> _pendingSlots;
+
+    std::size_t _i_frame;
+
+    std::vector<bool> _isAllocated;
+}; // class SlotAllocator
@@ -0,0 +1,370 @@
+// --- Internal Includes ---
+#include "StagingRing.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+StagingRing::StagingRing(const std::shared_ptr<LogicalDevice>& rp_device,
+                         VkDeviceSize capacity,
+                         std::size_t framesInFlight)
+    : StagingRing(rp_device, capacity, framesInFlight, LogicalDevice::QueueType::Graphics)
+{
+}
+
+
+StagingRing::StagingRing(const std::shared_ptr<LogicalDevice>& rp_device,
+                         VkDeviceSize capacity,
+                         std::size_t framesInFlight,
+                         LogicalDevice::QueueType queueType)
+    : _p_device(rp_device),
+      _device(rp_device->getDevice()),
+      _queueType(queueType),
+      _queue(rp_device->getQueue(queueType)),
+      _buffer(VK_NULL_HANDLE),
+      _memory(),
+      _p_mapped(nullptr),
+      _capacity(capacity),
+      _head(0),
+      _tail(0),
+      _frames(),
+      _i_frame(0),
+      _isRecording(false),
+      _bufferCopies(),
+      _imageCopies(),
+      _begin(),
+      _statistics()
+{
+    if (_capacity == 0) {
+        throw std::runtime_error("Staging ring requires a nonzero capacity");
+    }
+
+    if (framesInFlight == 0) {
+        throw std::runtime_error("Staging ring requires at least one frame in flight");
+    }
+
+    // Staging buffer
+    VkBufferCreateInfo bufferInfo {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = _capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(_device, &bufferInfo, _p_device->getAllocationCallbacks(), &_buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create staging buffer");
+    }
+
+    // Coherent memory doesn't need explicit flushes after writing to it
+    _memory = _p_device->getAllocator().allocate(_buffer,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    _p_mapped = static_cast<std::byte*>(_memory.p_mapped);
+
+    // Frame slots
+    _frames.reserve(framesInFlight);
+    for (std::size_t i_frame=0; i_frame<framesInFlight; ++i_frame) {
+        Frame frame {};
+
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        if (vkCreateFence(_device, &fenceInfo, _p_device->getAllocationCallbacks(), &frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create staging fence");
+        }
+
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = _p_device->getQueueFamilyIndex(_queueType);
+        if (vkCreateCommandPool(_device, &poolInfo, _p_device->getAllocationCallbacks(), &frame.commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create staging command pool");
+        }
+
+        VkCommandBufferAllocateInfo commandBufferInfo {};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        commandBufferInfo.commandPool = frame.commandPool;
+        commandBufferInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        commandBufferInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(_device, &commandBufferInfo, &frame.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate staging command buffer");
+        }
+
+        _frames.push_back(frame);
+    }
+}
+
+
+StagingRing::~StagingRing()
+{
+    this->waitIdle();
+    for (Frame& r_frame : _frames) {
+        vkDestroyCommandPool(_device, r_frame.commandPool, _p_device->getAllocationCallbacks());
+        vkDestroyFence(_device, r_frame.inFlight, _p_device->getAllocationCallbacks());
+    }
+    vkDestroyBuffer(_device, _buffer, _p_device->getAllocationCallbacks());
+    _p_device->getAllocator().free(_memory);
+}
+
+
+void StagingRing::beginFrame()
+{
+    if (_isRecording) {
+        throw std::runtime_error("Staging ring frame already begun");
+    }
+
+    if (_statistics.frameCount == 0) {
+        _begin = std::chrono::steady_clock::now();
+    }
+
+    Frame& r_frame = _frames[_i_frame];
+    if (r_frame.isPending) {
+        this->reclaim(r_frame);
+    }
+
+    vkResetCommandPool(_device, r_frame.commandPool, 0);
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(r_frame.commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to begin staging command buffer");
+    }
+
+    _isRecording = true;
+}
+
+
+StagingRing::Region StagingRing::allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+    if (!_isRecording) {
+        throw std::runtime_error("Staging ring allocation outside of a frame");
+    }
+
+    if (_capacity < size) {
+        throw std::runtime_error("Staging region of " + std::to_string(size) + " bytes exceeds the ring's capacity");
+    }
+
+    // Find the first aligned position that doesn't wrap around the end of the buffer
+    alignment = std::max<VkDeviceSize>(alignment, 1);
+    uint64_t begin = (_head + alignment - 1) / alignment * alignment;
+    if (_capacity < begin % _capacity + size) {
+        begin = (begin / _capacity + 1) * _capacity;
+    }
+
+    // Wait for the oldest frames in flight until the region is free
+    if (_tail + _capacity < begin + size) {
+        using Clock = std::chrono::steady_clock;
+        const auto stallBegin = Clock::now();
+        bool isStalled = false;
+
+        for (std::size_t i_offset=1; i_offset<_frames.size() && _tail + _capacity < begin + size; ++i_offset) {
+            Frame& r_frame = _frames[(_i_frame + i_offset) % _frames.size()];
+            if (r_frame.isPending) {
+                isStalled = this->reclaim(r_frame) || isStalled;
+            }
+        }
+
+        // Frames that had already finished are reclaimed without waiting on the device
+        if (isStalled) {
+            ++_statistics.stallCount;
+            _statistics.stallTime += Clock::now() - stallBegin;
+        }
+
+        if (_tail + _capacity < begin + size) {
+            throw std::runtime_error("Staging ring is too small for a single frame's uploads");
+        }
+    }
+
+    _head = begin + size;
+
+    const VkDeviceSize offset = begin % _capacity;
+    return Region {{_p_mapped + offset, static_cast<std::size_t>(size)}, offset};
+}
+
+
+void StagingRing::copy(const Region& r_region,
+                       VkBuffer destination,
+                       VkDeviceSize destinationOffset)
+{
+    BufferCopy copy;
+    copy.destination = destination;
+    copy.region.srcOffset = r_region.offset;
+    copy.region.dstOffset = destinationOffset;
+    copy.region.size = r_region.data.size();
+    _bufferCopies.push_back(copy);
+
+    ++_statistics.uploadCount;
+    _statistics.bytesUploaded += r_region.data.size();
+}
+
+
+void StagingRing::copy(const Region& r_region,
+                       VkImage destination,
+                       const VkBufferImageCopy& r_copy)
+{
+    ImageCopy copy;
+    copy.destination = destination;
+    copy.region = r_copy;
+    copy.region.bufferOffset += r_region.offset;
+    _imageCopies.push_back(copy);
+
+    ++_statistics.uploadCount;
+    _statistics.bytesUploaded += r_region.data.size();
+}
+
+
+void StagingRing::upload(std::span<const std::byte> data,
+                         VkBuffer destination,
+                         VkDeviceSize destinationOffset)
+{
+    const Region region = this->allocate(data.size());
+    std::memcpy(region.data.data(), data.data(), data.size());
+    this->copy(region, destination, destinationOffset);
+}
+
+
+QueueTransfer StagingRing::submit(VkSemaphore signal)
+{
+    if (!_isRecording) {
+        throw std::runtime_error("Staging ring submission outside of a frame");
+    }
+
+    Frame& r_frame = _frames[_i_frame];
+
+    // Batch copies into the same buffer into a single command
+    std::stable_sort(_bufferCopies.begin(),
+                     _bufferCopies.end(),
+                     [](const BufferCopy& r_left, const BufferCopy& r_right) {return r_left.destination < r_right.destination;});
+
+    std::vector<VkBufferCopy> regions;
+    regions.reserve(_bufferCopies.size());
+    for (auto it_begin=_bufferCopies.begin(); it_begin!=_bufferCopies.end();) {
+        const auto it_end = std::find_if(it_begin,
+                                         _bufferCopies.end(),
+                                         [it_begin](const BufferCopy& r_copy) {return r_copy.destination != it_begin->destination;});
+        regions.clear();
+        std::transform(it_begin, it_end, std::back_inserter(regions), [](const BufferCopy& r_copy) {return r_copy.region;});
+        vkCmdCopyBuffer(r_frame.commandBuffer,
+                        _buffer,
+                        it_begin->destination,
+                        static_cast<uint32_t>(regions.size()),
+                        regions.data());
+        it_begin = it_end;
+    }
+
+    for (const ImageCopy& r_copy : _imageCopies) {
+        vkCmdCopyBufferToImage(r_frame.commandBuffer,
+                               _buffer,
+                               r_copy.destination,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1,
+                               &r_copy.region);
+    }
+
+    // Hand the destinations over to the graphics family if the copies ran on another one
+    QueueTransfer transfer(*_p_device, _queueType, LogicalDevice::QueueType::Graphics);
+    if (transfer.isOwnershipTransfer()) {
+        for (auto it_copy=_bufferCopies.begin(); it_copy!=_bufferCopies.end(); ++it_copy) {
+            if (it_copy == _bufferCopies.begin() || std::prev(it_copy)->destination != it_copy->destination) {
+                transfer.addBuffer(it_copy->destination);
+            }
+        }
+        for (const ImageCopy& r_copy : _imageCopies) {
+            const auto& r_layers = r_copy.region.imageSubresource;
+            VkImageSubresourceRange range {};
+            range.aspectMask = r_layers.aspectMask;
+            range.baseMipLevel = r_layers.mipLevel;
+            range.levelCount = 1;
+            range.baseArrayLayer = r_layers.baseArrayLayer;
+            range.layerCount = r_layers.layerCount;
+            transfer.addImage(r_copy.destination,
+                              range,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        }
+        transfer.release(r_frame.commandBuffer,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_ACCESS_TRANSFER_WRITE_BIT);
+    } else if (!_bufferCopies.empty() || !_imageCopies.empty()) {
+        // Make the copies visible to everything submitted to the queue afterwards
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(r_frame.commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                             0,
+                             1, &barrier,
+                             0, nullptr,
+                             0, nullptr);
+    }
+
+    _bufferCopies.clear();
+    _imageCopies.clear();
+
+    if (vkEndCommandBuffer(r_frame.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to record staging command buffer");
+    }
+
+    VkSubmitInfo submitInfo {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &r_frame.commandBuffer;
+    submitInfo.signalSemaphoreCount = signal == VK_NULL_HANDLE ? 0 : 1;
+    submitInfo.pSignalSemaphores = &signal;
+
+    vkResetFences(_device, 1, &r_frame.inFlight);
+    if (vkQueueSubmit(_queue, 1, &submitInfo, r_frame.inFlight) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to submit staging copies");
+    }
+
+    r_frame.end = _head;
+    r_frame.isPending = true;
+    _isRecording = false;
+
+    ++_statistics.frameCount;
+    _statistics.elapsed = std::chrono::steady_clock::now() - _begin;
+    _i_frame = (_i_frame + 1) % _frames.size();
+
+    return transfer;
+}
+
+
+void StagingRing::waitIdle()
+{
+    // Frames finish in submission order
+    for (std::size_t i_offset=0; i_offset<_frames.size(); ++i_offset) {
+        Frame& r_frame = _frames[(_i_frame + i_offset) % _frames.size()];
+        if (r_frame.isPending) {
+            this->reclaim(r_frame);
+        }
+    }
+}
+
+
+VkDeviceSize StagingRing::getCapacity() const noexcept
+{
+    return _capacity;
+}
+
+
+const StagingRing::Statistics& StagingRing::getStatistics() const noexcept
+{
+    return _statistics;
+}
+
+
+bool StagingRing::reclaim(Frame& r_frame)
+{
+    const bool isExecuting = vkGetFenceStatus(_device, r_frame.inFlight) != VK_SUCCESS;
+    if (isExecuting) {
+        vkWaitForFences(_device, 1, &r_frame.inFlight, VK_TRUE, std::numeric_limits<uint64_t>::max());
+    }
+    _tail = std::max(_tail, r_frame.end);
+    r_frame.isPending = false;
+    return isExecuting;
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "DeviceAllocator.hpp"
+#include "QueueTransfer.hpp"
+
+// --- STL Includes ---
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+
+/// @brief Streams data into device local buffers and images through a persistently mapped ring buffer.
+/// @details Uploads are written into transient regions of a host visible staging buffer,
+///          and the copies out of them are batched into a single command buffer per frame,
+///          which @ref submit sends to the device's queue. A region is reclaimed once the
+///          fence of the frame that copied out of it signals. If the ring is full, the
+///          oldest frames in flight are waited on, and the time spent doing so is tracked
+///          in @ref Statistics.
+///
+///          Uploads are followed by a global memory barrier, so later submissions to the
+///          same queue see the uploaded data without any further synchronization.
+///
+///          Constructed with @ref LogicalDevice::QueueType::Transfer, copies run on the
+///          device's transfer queue instead, and overlap with graphics work if the device
+///          has a dedicated transfer family. The destinations are then released to the
+///          graphics family, and @ref submit returns the matching acquire barriers.
+/// @note Not thread safe; uploads are expected to come from a single thread.
+class StagingRing
+{
+public:
+    /// @brief Transient staging memory that is valid until the current frame is submitted.
+    struct Region
+    {
+        /// @brief Mapped memory to write the data to.
+        std::span<std::byte> data;
+
+        /// @brief Offset of the region within the staging buffer [bytes].
+        VkDeviceSize offset;
+    }; // struct Region
+
+    struct Statistics
+    {
+        using Duration = std::chrono::duration<double>;
+
+        std::size_t frameCount = 0;
+
+        std::size_t uploadCount = 0;
+
+        std::size_t bytesUploaded = 0;
+
+        /// @brief Number of times the ring was full and had to wait for the device.
+        std::size_t stallCount = 0;
+
+        /// @brief Time spent waiting for space in a full ring.
+        Duration stallTime {0};
+
+        /// @brief Time between the first @ref beginFrame and the last @ref submit.
+        Duration elapsed {0};
+
+        /// @brief Average upload rate [MB/s].
+        double getBandwidth() const noexcept
+        {
+            return elapsed.count() ? 1e-6 * bytesUploaded / elapsed.count() : 0.0;
+        }
+    }; // struct Statistics
+
+public:
+    /// @param capacity size of the staging buffer [bytes]; should fit all uploads of every frame in flight.
+    StagingRing(const std::shared_ptr<LogicalDevice>& rp_device,
+                VkDeviceSize capacity,
+                std::size_t framesInFlight);
+
+    /// @param queueType queue the copies are submitted to; consumers are expected on the graphics queue.
+    StagingRing(const std::shared_ptr<LogicalDevice>& rp_device,
+                VkDeviceSize capacity,
+                std::size_t framesInFlight,
+                LogicalDevice::QueueType queueType);
+
+    StagingRing(const StagingRing&) = delete;
+
+    /// @brief Waits for all frames in flight.
+    ~StagingRing();
+
+    /// @brief Wait for the next frame slot to become available, reclaim its staging memory, and start recording copies.
+    void beginFrame();
+
+    /// @brief Reserve staging memory for the current frame.
+    /// @details Blocks until enough memory is reclaimed if the ring is full.
+    /// @throws std::runtime_error if the region can't fit into the ring, even after all other frames finished.
+    Region allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    /// @brief Copy a region into a buffer.
+    void copy(const Region& r_region,
+              VkBuffer destination,
+              VkDeviceSize destinationOffset);
+
+    /// @brief Copy a region into an image in @a VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout.
+    /// @details @a bufferOffset of @a copy is relative to the region. The region must be aligned
+    ///          to the texel size of the image's format.
+    void copy(const Region& r_region,
+              VkImage destination,
+              const VkBufferImageCopy& r_copy);
+
+    /// @brief Stage data and copy it into a buffer.
+    void upload(std::span<const std::byte> data,
+                VkBuffer destination,
+                VkDeviceSize destinationOffset);
+
+    /// @brief Submit the current frame's copies.
+    /// @param signal semaphore to signal when the copies are done, for consumers on other queues.
+    /// @return barriers the graphics queue records after waiting on @a signal at the stages that
+    ///         read the uploads, before reading them (see @ref QueueTransfer::acquire).
+    ///         Recording them is only required if the copies ran on a different queue family.
+    QueueTransfer submit(VkSemaphore signal = VK_NULL_HANDLE);
+
+    /// @brief Wait until all submitted copies are done.
+    void waitIdle();
+
+    VkDeviceSize getCapacity() const noexcept;
+
+    const Statistics& getStatistics() const noexcept;
+
+private:
+    struct Frame
+    {
+        /// @brief Signaled when the slot's copies finished executing.
+        VkFence inFlight;
+
+        VkCommandPool commandPool;
+
+        VkCommandBuffer commandBuffer;
+
+        /// @brief Ring position past the last byte staged by the slot.
+        uint64_t end;
+
+        /// @brief Whether the slot was submitted and its memory is yet to be reclaimed.
+        bool isPending;
+    }; // struct Frame
+
+    struct BufferCopy
+    {
+        VkBuffer destination;
+
+        VkBufferCopy region;
+    }; // struct BufferCopy
+
+    struct ImageCopy
+    {
+        VkImage destination;
+
+        VkBufferImageCopy region;
+    }; // struct ImageCopy
+
+    /// @brief Wait for a pending frame and reclaim its memory.
+    /// @return true if the frame was still executing and the call blocked on its fence.
+    bool reclaim(Frame& r_frame);
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkDevice _device;
+
+    LogicalDevice::QueueType _queueType;
+
+    VkQueue _queue;
+
+    VkBuffer _buffer;
+
+    DeviceAllocator::Allocation _memory;
+
+    std::byte* _p_mapped;
+
+    VkDeviceSize _capacity;
+
+    /// @brief Monotonic ring positions; the physical offset is the position modulo the capacity.
+    /// @{
+
+    uint64_t _head;
+
+    uint64_t _tail;
+
+    /// @}
+
+    std::vector<Frame> _frames;
+
+    std::size_t _i_frame;
+
+    bool _isRecording;
+
+    std::vector<BufferCopy> _bufferCopies;
+
+    std::vector<ImageCopy> _imageCopies;
+
+    std::chrono::steady_clock::time_point _begin;
+
+    Statistics _statistics;
+}; // class StagingRing
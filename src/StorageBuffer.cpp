@@ -0,0 +1,59 @@
+// --- Internal Includes ---
+#include "StorageBuffer.hpp"
+
+// --- STL Includes ---
+#include <stdexcept>
+
+
+StorageBuffer::StorageBuffer(const std::shared_ptr<LogicalDevice>& rp_device,
+                             VkDeviceSize size)
+    : _p_device(rp_device),
+      _buffer(VK_NULL_HANDLE),
+      _size(size),
+      _memory()
+{
+    if (_size == 0) {
+        throw std::runtime_error("Storage buffers must not be empty");
+    }
+
+    const VkDevice device = _p_device->getDevice();
+
+    VkBufferCreateInfo info {};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = _size;
+    info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+                 | VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+                 | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &info, _p_device->getAllocationCallbacks(), &_buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create storage buffer");
+    }
+
+    try {
+        _memory = _p_device->getAllocator().allocate(_buffer,
+                                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    } catch (...) {
+        vkDestroyBuffer(device, _buffer, _p_device->getAllocationCallbacks());
+        throw;
+    }
+}
+
+
+StorageBuffer::~StorageBuffer()
+{
+    vkDestroyBuffer(_p_device->getDevice(), _buffer, _p_device->getAllocationCallbacks());
+    _p_device->getAllocator().free(_memory);
+}
+
+
+VkBuffer StorageBuffer::get() const noexcept
+{
+    return _buffer;
+}
+
+
+VkDeviceSize StorageBuffer::getSize() const noexcept
+{
+    return _size;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// --- External Includes ---
+#include "vulkan/vulkan.hpp"
+
+// --- Internal Includes ---
+#include "LogicalDevice.hpp"
+#include "DeviceAllocator.hpp"
+
+// --- STL Includes ---
+#include <memory>
+#include <span>
+
+
+/// @brief Storage buffer that the host reads and writes directly through a persistent mapping.
+/// @details The memory must be host visible and coherent, and is device local if the device
+///          has such a memory type (integrated GPUs, resizable BAR, software drivers). Other
+///          devices read it over the bus, which suits correctness tests and occasional
+///          dispatches, but not bandwidth bound work that runs every frame.
+///
+///          Host writes before a submission are visible to it. Shader writes become visible
+///          to the host once @ref ComputeDispatcher::submit returns.
+class StorageBuffer
+{
+public:
+    /// @param size buffer size [bytes].
+    StorageBuffer(const std::shared_ptr<LogicalDevice>& rp_device,
+                  VkDeviceSize size);
+
+    StorageBuffer(const StorageBuffer&) = delete;
+
+    ~StorageBuffer();
+
+    /// @brief Access the contents as an array of @a TValue.
+    template <class TValue>
+    std::span<TValue> view() noexcept
+    {
+        return {static_cast<TValue*>(_memory.p_mapped), static_cast<std::size_t>(_size / sizeof(TValue))};
+    }
+
+    /// @brief Access the contents as an array of @a TValue.
+    template <class TValue>
+    std::span<const TValue> view() const noexcept
+    {
+        return {static_cast<const TValue*>(_memory.p_mapped), static_cast<std::size_t>(_size / sizeof(TValue))};
+    }
+
+    /// @name Member Access
+    /// @{
+
+    VkBuffer get() const noexcept;
+
+    VkDeviceSize getSize() const noexcept;
+
+    /// @}
+
+private:
+    std::shared_ptr<LogicalDevice> _p_device;
+
+    VkBuffer _buffer;
+
+    VkDeviceSize _size;
+
+    DeviceAllocator::Allocation _memory;
+}; // class StorageBuffer
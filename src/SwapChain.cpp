@@ -21,18 +21,10 @@ SwapChain::Properties SwapChain::Properties::query(const PhysicalDevice& r_devic
     // Query queue family
     properties._queueFamily = r_device.getQueueFamily(r_surface.get());
 
-    // Query physical device extensions
-    uint32_t extensionCount = 0;
-    vkEnumerateDeviceExtensionProperties(r_device.getDevice(),
-                                         nullptr,
-                                         &extensionCount,
-                                         nullptr);
-    if (0 < extensionCount) {
-        properties._extensions.resize(extensionCount);
-        vkEnumerateDeviceExtensionProperties(r_device.getDevice(),
-                                             nullptr,
-                                             &extensionCount,
-                                             properties._extensions.data());
+    // Physical device extensions don't depend on the surface
+    properties._p_deviceCapabilities = r_device.getSharedCapabilities();
+    if (!properties._p_deviceCapabilities) {
+        throw std::runtime_error("Uninitialized physical device has no capabilities");
     }
 
     // Query capabilities
@@ -78,9 +70,9 @@ const PhysicalDevice::QueueFamily& SwapChain::Properties::getQueueFamily() const
 }
 
 
-const std::vector<VkExtensionProperties> SwapChain::Properties::getDeviceExtensions() const noexcept
+const PhysicalDevice::Capabilities& SwapChain::Properties::getDeviceCapabilities() const noexcept
 {
-    return _extensions;
+    return *_p_deviceCapabilities;
 }
 
 
@@ -102,65 +94,6 @@ const std::vector<VkPresentModeKHR>& SwapChain::Properties::getPresentModes() co
 }
 
 
-SwapChain::ImageViews::View::View(SwapChain& r_swapChain,
-                                  std::size_t i_image)
-    : _view(),
-      _image(),
-      _device(r_swapChain.getLogicalDevice().getDevice())
-{
-    if (r_swapChain.getImages().size() <= i_image) {
-        throw std::runtime_error("Image view index out of range for swap chain of size " + std::to_string(r_swapChain.getImages().size()));
-    }
-    _image = r_swapChain.getImages()[i_image];
-
-    if (r_swapChain.getProperties()._formats.empty()) {
-        throw std::runtime_error("The swap chain's image format does not exist\n");
-    }
-
-    VkImageViewCreateInfo info {};
-    info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    info.image = _image;
-    info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    info.format = r_swapChain.getProperties()._formats.front().format;
-    info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-    info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-    info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-    info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-    info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    info.subresourceRange.baseMipLevel = 0;
-    info.subresourceRange.levelCount = 1;
-    info.subresourceRange.baseArrayLayer = 0;
-    info.subresourceRange.layerCount = 1;
-
-    if (vkCreateImageView(r_swapChain.getLogicalDevice().getDevice(),
-                          &info,
-                          nullptr,
-                          &_view) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create image view");
-    }
-}
-
-
-VkImageView SwapChain::ImageViews::View::get()
-{
-    return _view;
-}
-
-
-SwapChain::ImageViews::ImageViews(const std::shared_ptr<SwapChain> rp_swapChain)
-    : ImageViews(rp_swapChain,
-                 [](SwapChain& r_chain, std::size_t i_image) -> std::unique_ptr<View> {
-                    return std::make_unique<View>(r_chain, i_image);
-                 })
-{}
-
-
-SwapChain::ImageViews::View::~View()
-{
-    vkDestroyImageView(_device, _view, nullptr);
-}
-
-
 namespace {
 
 
@@ -193,17 +126,30 @@ VkSurfaceFormatKHR chooseSurfaceFormat(const SwapChain::Properties& r_properties
 ///          - VK_PRESENT_MODE_FIFO_RELAXED_KHR: if submission is late, the presentation temporarily switches to immediate mode
 ///          - VK_PRESENT_MODE_MAILBOX_KHR: if submission is faster than the display speed, existing frames are overwritten in the queue
 VkPresentModeKHR choosePresentMode(const SwapChain::Properties& r_properties,
-                                   VkPresentModeKHR preferred = VK_PRESENT_MODE_FIFO_KHR)
+                                   SwapChain::PresentPolicy policy)
 {
     if (r_properties.getPresentModes().empty()) {
         throw std::runtime_error("No presentation modes available in the provided swap chain properties");
     }
 
-    // Return the preferred mode if available
+    // Modes in order of preference, excluding the FIFO fallback
+    std::vector<VkPresentModeKHR> preferred;
+    switch (policy) {
+        case SwapChain::PresentPolicy::LowLatency:
+            preferred = {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR};
+            break;
+        case SwapChain::PresentPolicy::Throughput:
+            preferred = {VK_PRESENT_MODE_FIFO_RELAXED_KHR};
+            break;
+        case SwapChain::PresentPolicy::VSync:
+            break;
+    }
+
+    // Return the first preferred mode that is available
     const auto& r_modes = r_properties.getPresentModes();
-    for (const auto& r_mode : r_modes) {
-        if (r_mode == preferred) {
-            return r_mode;
+    for (const auto mode : preferred) {
+        if (std::find(r_modes.begin(), r_modes.end(), mode) != r_modes.end()) {
+            return mode;
         }
     }
 
@@ -230,12 +176,12 @@ VkExtent2D chooseSwapExtent(const SwapChain::Properties& r_properties,
 
         VkExtent2D extent {static_cast<uint32_t>(width),
                            static_cast<uint32_t>(height)};
-        std::clamp(extent.width,
-                   r_capabilities.minImageExtent.width,
-                   r_capabilities.maxImageExtent.width);
-        std::clamp(extent.height,
-                   r_capabilities.minImageExtent.height,
-                   r_capabilities.maxImageExtent.height);
+        extent.width = std::clamp(extent.width,
+                                  r_capabilities.minImageExtent.width,
+                                  r_capabilities.maxImageExtent.width);
+        extent.height = std::clamp(extent.height,
+                                   r_capabilities.minImageExtent.height,
+                                   r_capabilities.maxImageExtent.height);
         return extent;
     } else {
         // The window's and swap's resolution must be identical.
@@ -244,19 +190,39 @@ VkExtent2D chooseSwapExtent(const SwapChain::Properties& r_properties,
 }
 
 
-uint32_t chooseSwapChainSize(const SwapChain::Properties& r_properties)
+/// @brief Choose the number of images in the swap chain.
+/// @details More images let the CPU and GPU run further ahead of the display,
+///          which smooths out frame time spikes but adds latency.
+uint32_t chooseSwapChainSize(const SwapChain::Properties& r_properties,
+                             SwapChain::PresentPolicy policy,
+                             VkPresentModeKHR presentMode)
 {
     const auto& r_capabilities = r_properties.getCapabilities();
     uint32_t output = r_capabilities.minImageCount + 1;
 
-    if (r_capabilities.maxImageCount != 0) {
-        // Swap chain size is limited
-        std::clamp(output,
-                   r_capabilities.minImageCount,
-                   r_capabilities.maxImageCount);
+    switch (presentMode) {
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            // One image on display, one queued and one being rendered
+            output = std::max(output, 3u);
+            break;
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            output = std::max(r_capabilities.minImageCount, 2u);
+            break;
+        default:
+            if (policy == SwapChain::PresentPolicy::LowLatency) {
+                // Fell back to FIFO: keep as few frames queued as possible
+                output = r_capabilities.minImageCount;
+            } else if (policy == SwapChain::PresentPolicy::Throughput) {
+                ++output;
+            }
+            break;
     }
 
-    return output;
+    // Swap chain size is limited if maxImageCount is not 0
+    const uint32_t maxImageCount = r_capabilities.maxImageCount == 0 ? std::numeric_limits<uint32_t>::max() : r_capabilities.maxImageCount;
+    return std::clamp(output,
+                      r_capabilities.minImageCount,
+                      std::max(r_capabilities.minImageCount, maxImageCount));
 }
 
 
@@ -264,16 +230,58 @@ uint32_t chooseSwapChainSize(const SwapChain::Properties& r_properties)
 
 
 SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
-                     const std::shared_ptr<WindowSurface>& rp_surface)
+                     const std::shared_ptr<WindowSurface>& rp_surface,
+                     PresentPolicy policy)
+    : _p_device(rp_device),
+      _p_surface(rp_surface),
+      _swapChain(),
+      _images(),
+      _extent(),
+      _properties(),
+      _policy(policy),
+      _isOutOfDate(false)
+{
+    this->create(VK_NULL_HANDLE, this->getAvailableProperties());
+}
+
+
+SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
+                     const std::shared_ptr<WindowSurface>& rp_surface,
+                     PresentPolicy policy,
+                     const Properties& r_available)
     : _p_device(rp_device),
       _p_surface(rp_surface),
       _swapChain(),
-      _images()
+      _images(),
+      _extent(),
+      _properties(),
+      _policy(policy),
+      _isOutOfDate(false)
+{
+    this->create(VK_NULL_HANDLE, r_available);
+}
+
+
+SwapChain::SwapChain(const std::shared_ptr<SwapChain>& rp_old)
+    : _p_device(rp_old->_p_device),
+      _p_surface(rp_old->_p_surface),
+      _swapChain(),
+      _images(),
+      _extent(),
+      _properties(),
+      _policy(rp_old->_policy),
+      _isOutOfDate(false)
 {
-    const Properties properties = this->getAvailableProperties();
+    // The old swap chain is retired by the new one even if construction fails
+    rp_old->_isOutOfDate = true;
+    this->create(rp_old->_swapChain, this->getAvailableProperties());
+}
 
+
+void SwapChain::create(VkSwapchainKHR oldSwapChain, const Properties& r_properties)
+{
     // Check whether all requirements are met
-    if (!SwapChain::checkRequirements(properties)) {
+    if (!SwapChain::checkRequirements(r_properties)) {
         std::stringstream message;
         message << "Physical device '"
                 << _p_device->getPhysicalDevice().getName()
@@ -281,11 +289,21 @@ SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
         throw std::runtime_error(message.str());
     }
 
+    // Images are presented on the device's presentation queue, which must present to this surface
+    if (_p_device->getQueueFamilyIndex(LogicalDevice::QueueType::Presentation) != r_properties.getQueueFamily().presentation.value()) {
+        throw std::runtime_error("Logical device has no presentation queue for the swap chain's surface");
+    }
+
     // Choose swap chain properties based on what's available
-    const auto surfaceFormat = chooseSurfaceFormat(properties);
-    const auto presentMode = choosePresentMode(properties);
-    const auto swapExtent = chooseSwapExtent(properties, *_p_surface);
-    const auto swapChainSize = chooseSwapChainSize(properties);
+    const auto surfaceFormat = chooseSurfaceFormat(r_properties);
+    const auto presentMode = choosePresentMode(r_properties, _policy);
+    const auto swapExtent = chooseSwapExtent(r_properties, *_p_surface);
+    const auto swapChainSize = chooseSwapChainSize(r_properties, _policy, presentMode);
+
+    // Minimized windows have no area to present to
+    if (swapExtent.width == 0 || swapExtent.height == 0) {
+        throw std::runtime_error("Cannot construct a swap chain for a surface without area");
+    }
 
     // Assemble the swap chain constructor info
     VkSwapchainCreateInfoKHR info {};
@@ -302,13 +320,13 @@ SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
     // Specify the type of operations the images in the
     // swap chain will be used for.
     // - VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT: render directly to the image
-    // - VK_IMAGE_USAGE_TRANSFER_DST_BIT: @todo ?
-    info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    // - VK_IMAGE_USAGE_TRANSFER_DST_BIT: clear the image outside of a render pass
+    info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
     // Decide how the graphics and presentation queues should communicate their images.
     // - if the two queues are actually the same, there are no ownership issues
     // - ask vulkan to manage ownership transfers automatically if the two queues are distinct
-    const auto queueFamily = _p_device->getPhysicalDevice().getQueueFamily(_p_surface->get());
+    const auto queueFamily = r_properties.getQueueFamily();
     std::array<uint32_t,2> queueFamilyIDs {queueFamily.graphics.value(),
                                            queueFamily.presentation.value()};
 
@@ -325,7 +343,7 @@ SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
     // Set transformations performed on every submitted image.
     // (rotation, scaling, etc.)
     // By default, no transform is carried out.
-    info.preTransform = properties.getCapabilities().currentTransform;
+    info.preTransform = r_properties.getCapabilities().currentTransform;
 
     // Choose whether to blend the rendered images with the window's background
     // using the alpha channels in the submitted images.
@@ -334,16 +352,16 @@ SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
     // Ignore invisible pixels (eg.: due to overlapping windows)
     info.clipped = VK_TRUE;
 
-    // Decide what happens to invalidated images in the swap chain
-    // (eg.: due to window resizing).
-    info.oldSwapchain = VK_NULL_HANDLE;
+    // Hand over from the swap chain this one replaces (eg.: due to window resizing),
+    // so the presentation engine can reuse its resources.
+    info.oldSwapchain = oldSwapChain;
 
     // Finally ... construct the bloody swap chain
     if (vkCreateSwapchainKHR(_p_device->getDevice(),
                              &info,
-                             nullptr,
+                             _p_device->getAllocationCallbacks(),
                              &_swapChain) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to construct swap chain\n");
+        throw std::runtime_error("Failed to construct swap chain");
     }
 
     // Get the images in the constructed swap chain
@@ -358,10 +376,12 @@ SwapChain::SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
                             &finalSwapChainSize,
                             _images.data());
 
+    _extent = swapExtent;
+
     // Populate the properties the swap chain ended up with
-    _properties._queueFamily = properties.getQueueFamily();
-    _properties._extensions = properties.getDeviceExtensions();
-    _properties._capabilities = properties.getCapabilities();
+    _properties._queueFamily = r_properties.getQueueFamily();
+    _properties._p_deviceCapabilities = r_properties._p_deviceCapabilities;
+    _properties._capabilities = r_properties.getCapabilities();
     _properties._formats = {surfaceFormat};
     _properties._presentModes = {presentMode};
 }
@@ -371,7 +391,7 @@ SwapChain::~SwapChain()
 {
     vkDestroySwapchainKHR(_p_device->getDevice(),
                           _swapChain,
-                          nullptr);
+                          _p_device->getAllocationCallbacks());
 }
 
 
@@ -393,6 +413,48 @@ std::vector<VkImage>& SwapChain::getImages() noexcept
 }
 
 
+VkFormat SwapChain::getImageFormat() const noexcept
+{
+    return _properties._formats.empty() ? VK_FORMAT_UNDEFINED : _properties._formats.front().format;
+}
+
+
+SwapChain::PresentPolicy SwapChain::getPresentPolicy() const noexcept
+{
+    return _policy;
+}
+
+
+VkPresentModeKHR SwapChain::getPresentMode() const noexcept
+{
+    return _properties._presentModes.empty() ? VK_PRESENT_MODE_FIFO_KHR : _properties._presentModes.front();
+}
+
+
+VkExtent2D SwapChain::getImageExtent() const noexcept
+{
+    return _extent;
+}
+
+
+VkImageLayout SwapChain::getFinalLayout() const noexcept
+{
+    return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+}
+
+
+bool SwapChain::isPresentable() const noexcept
+{
+    return true;
+}
+
+
+bool SwapChain::isOutOfDate() const noexcept
+{
+    return _isOutOfDate;
+}
+
+
 const GraphicsLogicalDevice& SwapChain::getLogicalDevice() const noexcept
 {
     return *_p_device;
@@ -405,6 +467,54 @@ GraphicsLogicalDevice& SwapChain::getLogicalDevice() noexcept
 }
 
 
+std::optional<uint32_t> SwapChain::acquire(VkSemaphore signal)
+{
+    if (_isOutOfDate) {
+        return {};
+    }
+
+    uint32_t i_image = 0;
+    const VkResult result = vkAcquireNextImageKHR(_p_device->getDevice(),
+                                                  _swapChain,
+                                                  std::numeric_limits<uint64_t>::max(),
+                                                  signal,
+                                                  VK_NULL_HANDLE,
+                                                  &i_image);
+
+    // A suboptimal image was still acquired and can be rendered into,
+    // but the swap chain should be recreated once it's presented.
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        _isOutOfDate = true;
+        return {};
+    } else if (result == VK_SUBOPTIMAL_KHR) {
+        _isOutOfDate = true;
+    } else if (result != VK_SUCCESS) {
+        throw std::runtime_error("Failed to acquire swap chain image");
+    }
+    return i_image;
+}
+
+
+void SwapChain::present(uint32_t i_image, VkSemaphore wait)
+{
+    VkPresentInfoKHR info {};
+    info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    info.waitSemaphoreCount = wait == VK_NULL_HANDLE ? 0 : 1;
+    info.pWaitSemaphores = &wait;
+    info.swapchainCount = 1;
+    info.pSwapchains = &_swapChain;
+    info.pImageIndices = &i_image;
+
+    // The wait semaphore is consumed even if the swap chain is out of date.
+    const VkResult result = vkQueuePresentKHR(_p_device->getQueue(LogicalDevice::QueueType::Presentation), &info);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        _isOutOfDate = true;
+    } else if (result != VK_SUCCESS) {
+        throw std::runtime_error("Failed to present swap chain image");
+    }
+}
+
+
 bool SwapChain::checkRequirements(const Properties& r_properties) noexcept
 {
     return    SwapChain::checkQueueRequirements(r_properties)
@@ -423,19 +533,15 @@ bool SwapChain::checkQueueRequirements(const Properties& r_properties) noexcept
 
 bool SwapChain::checkExtensionRequirements(const Properties& r_properties) noexcept
 {
-    const auto& r_availableExtensions = r_properties.getDeviceExtensions();
+    const auto& r_capabilities = r_properties.getDeviceCapabilities();
 
-    // Check whether all required extensions' names are in the collected (available) extensions
+    // Look up each required extension in the device's extension set
     std::vector<const char*> requiredExtensions;
     SwapChain::getRequiredExtensions(std::back_inserter(requiredExtensions));
     return std::all_of(requiredExtensions.begin(),
                        requiredExtensions.end(),
-                       [&r_availableExtensions](const char* p_required) -> bool {
-                           return std::find_if(r_availableExtensions.begin(),
-                                               r_availableExtensions.end(),
-                                               [p_required](const auto& r_available) -> bool {
-                                                   return std::strcmp(p_required, r_available.extensionName);
-                                               }) != r_availableExtensions.end();
+                       [&r_capabilities](const char* p_required) -> bool {
+                           return r_capabilities.hasExtension(p_required);
                        });
 }
 
@@ -4,16 +4,18 @@
 #include "LogicalDevice.hpp"
 #include "PhysicalDevice.hpp"
 #include "WindowSurface.hpp"
+#include "RenderTarget.hpp"
 
 // --- STL Includes ---
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <cstring>
 #include <sstream>
 #include <vector>
 
 
-class SwapChain
+class SwapChain final : public RenderTarget
 {
 public:
     class Properties
@@ -27,7 +29,9 @@ public:
 
         const PhysicalDevice::QueueFamily& getQueueFamily() const noexcept;
 
-        const std::vector<VkExtensionProperties> getDeviceExtensions() const noexcept;
+        /// @brief Get the capabilities of the physical device the properties were queried for.
+        /// @details Shared with the @ref PhysicalDevice rather than copied.
+        const PhysicalDevice::Capabilities& getDeviceCapabilities() const noexcept;
 
         const VkSurfaceCapabilitiesKHR& getCapabilities() const noexcept;
 
@@ -40,7 +44,7 @@ public:
     private:
         PhysicalDevice::QueueFamily _queueFamily;
 
-        std::vector<VkExtensionProperties> _extensions;
+        std::shared_ptr<const PhysicalDevice::Capabilities> _p_deviceCapabilities;
 
         VkSurfaceCapabilitiesKHR _capabilities;
 
@@ -52,64 +56,47 @@ public:
         friend class SwapChain;
     }; // class Properties
 
-    class ImageViews
+    /// @brief Trade-off between latency, smoothness and power that decides the present mode and image count.
+    /// @details Falls back to FIFO, the only mode every surface supports, if the preferred modes
+    ///          are unavailable. The image count is always kept within the surface's limits.
+    enum class PresentPolicy
     {
-    public:
-        class View
-        {
-        public:
-            View() = delete;
-
-            View(View&&) noexcept = default;
-
-            View(const View&) = delete;
-
-            View(SwapChain& r_swapChain, std::size_t i_image);
-
-            VkImageView get();
-
-            virtual ~View();
-
-        private:
-            VkImageView _view;
-
-            VkImage _image;
+        /// @brief FIFO with one image more than the surface's minimum; frames are paced to the display.
+        VSync,
 
-            VkDevice _device;
-        }; // class View
+        /// @brief MAILBOX, or IMMEDIATE if unavailable, so new frames are displayed as soon as possible.
+        /// @details Frames aren't paced to the display, so this draws the most power.
+        ///          If neither mode is available, FIFO with as few images as possible.
+        LowLatency,
 
-    public:
-        ImageViews(const std::shared_ptr<SwapChain> rp_swapChain);
-
-        /// @tparam TViewFactory Factory function producing a unique pointer to a @ref View.
-        /// @tparam TFactoryArgs Additional arguments passed to @a TViewFactory after @ref SwapChain and the image index.
-        template <class TViewFactory, class ...TFactoryArgs>
-        ImageViews(const std::shared_ptr<SwapChain> rp_swapChain,
-                   const TViewFactory& r_factory,
-                   const TFactoryArgs& ... r_factoryArgs)
-            : _views(),
-              _p_swapChain(rp_swapChain)
-        {
-            const std::size_t imageCount = rp_swapChain->getImages().size();
-            _views.reserve(imageCount);
-            for (std::size_t i_image=0; i_image<imageCount; ++i_image) {
-                _views.emplace_back(r_factory(*rp_swapChain,
-                                              i_image,
-                                              r_factoryArgs...));
-            }
-        }
-
-    private:
-        std::vector<std::unique_ptr<View>> _views;
-
-        std::shared_ptr<SwapChain> _p_swapChain;
-    }; // class ImageViews
+        /// @brief FIFO_RELAXED or FIFO with a deeper queue that absorbs frame time spikes at the cost of latency.
+        Throughput
+    }; // enum class PresentPolicy
 
 public:
+    /// @details Images are presented on @a rp_device's presentation queue, so the device must
+    ///          have been created for @a rp_surface (see @ref LogicalDevice::QueueType::Presentation).
     SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
-              const std::shared_ptr<WindowSurface>& rp_surface);
+              const std::shared_ptr<WindowSurface>& rp_surface,
+              PresentPolicy policy = PresentPolicy::VSync);
 
-    ~SwapChain();
+    /// @brief Construct from surface properties that were already queried, instead of querying them again.
+    /// @details @a r_available must hold the surface's current capabilities (see @ref Properties::query).
+    SwapChain(const std::shared_ptr<GraphicsLogicalDevice>& rp_device,
+              const std::shared_ptr<WindowSurface>& rp_surface,
+              PresentPolicy policy,
+              const Properties& r_available);
+
+    /// @brief Recreate a swap chain for the surface of an existing one, for example after a resize.
+    /// @details The @ref PresentPolicy of @a rp_old is kept.
+    /// @details @a rp_old is passed as @a oldSwapchain, which lets the presentation engine
+    ///          reuse its resources and hand over without a gap. @a rp_old is retired and
+    ///          can't acquire images anymore, but images it already acquired remain valid
+    ///          and may still be presented. It must be kept alive until the frames rendered
+    ///          into its images finished (see @ref FrameLoop::setTarget).
+    SwapChain(const std::shared_ptr<SwapChain>& rp_old);
+
+    ~SwapChain() override;
 
     /// @name Queries
     /// @{
@@ -130,11 +117,35 @@ public:
     const Properties& getProperties() const noexcept;
 
     /// @brief Access images in the swap chain.
-    std::vector<VkImage>& getImages() noexcept;
+    std::vector<VkImage>& getImages() noexcept override;
+
+    VkFormat getImageFormat() const noexcept override;
 
-    const GraphicsLogicalDevice& getLogicalDevice() const noexcept;
+    /// @brief Get the policy the present mode and image count were chosen by.
+    PresentPolicy getPresentPolicy() const noexcept;
 
-    GraphicsLogicalDevice& getLogicalDevice() noexcept;
+    /// @brief Get the present mode the @ref PresentPolicy ended up with.
+    VkPresentModeKHR getPresentMode() const noexcept;
+
+    VkExtent2D getImageExtent() const noexcept override;
+
+    VkImageLayout getFinalLayout() const noexcept override;
+
+    bool isPresentable() const noexcept override;
+
+    bool isOutOfDate() const noexcept override;
+
+    const GraphicsLogicalDevice& getLogicalDevice() const noexcept override;
+
+    GraphicsLogicalDevice& getLogicalDevice() noexcept override;
+
+    /// @}
+    /// @name Frame Control
+    /// @{
+
+    std::optional<uint32_t> acquire(VkSemaphore signal) override;
+
+    void present(uint32_t i_image, VkSemaphore wait) override;
 
     /// @}
     /// @name Checks
@@ -157,6 +168,10 @@ public:
 
     /// @}
 
+private:
+    /// @brief Construct the swap chain from the provided surface properties.
+    void create(VkSwapchainKHR oldSwapChain, const Properties& r_properties);
+
 private:
     std::shared_ptr<GraphicsLogicalDevice> _p_device;
 
@@ -166,5 +181,12 @@ private:
 
     std::vector<VkImage> _images;
 
+    VkExtent2D _extent;
+
     Properties _properties;
+
+    PresentPolicy _policy;
+
+    /// @brief Set once the surface no longer matches the swap chain, or after it was retired.
+    bool _isOutOfDate;
 }; // class SwapChain
@@ -0,0 +1,77 @@
+// --- Internal Includes ---
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : _mutex(),
+      _condition(),
+      _jobs(),
+      _stop(false),
+      _workers()
+{
+    // hardware_concurrency may return 0 if it can't tell
+    threadCount = std::max<std::size_t>(threadCount, 1);
+
+    _workers.reserve(threadCount);
+    for (std::size_t i_thread=0; i_thread<threadCount; ++i_thread) {
+        _workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_all();
+
+    for (auto& r_worker : _workers) {
+        r_worker.join();
+    }
+}
+
+
+std::size_t ThreadPool::size() const noexcept
+{
+    return _workers.size();
+}
+
+
+void ThreadPool::enqueue(std::function<void()>&& r_job)
+{
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        _jobs.emplace_back(std::move(r_job));
+    }
+    _condition.notify_one();
+}
+
+
+void ThreadPool::work()
+{
+    if constexpr (Trace::isEnabled()) {
+        Trace::setThreadName("ThreadPool worker");
+    }
+
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() {return _stop || !_jobs.empty();});
+            if (_jobs.empty()) {
+                return; // <== stopped and drained
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        // Exceptions are captured by the packaged_task
+        job();
+    }
+}
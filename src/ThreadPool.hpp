@@ -0,0 +1,58 @@
+#pragma once
+
+// --- STL Includes ---
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+
+/// @brief Fixed number of worker threads consuming a shared FIFO of jobs.
+/// @details Jobs still in the queue when the pool is destroyed are executed
+///          before the workers are joined.
+class ThreadPool
+{
+public:
+    /// @param threadCount number of workers; defaults to the number of hardware threads.
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    /// @brief Schedule a callable for execution on one of the workers.
+    /// @return a future that resolves to the callable's result, or rethrows its exception.
+    template <class TFunction>
+    std::future<std::invoke_result_t<TFunction>> submit(TFunction&& r_function)
+    {
+        // std::function requires copyable targets, so the task is wrapped in a shared_ptr
+        using Result = std::invoke_result_t<TFunction>;
+        auto p_task = std::make_shared<std::packaged_task<Result()>>(std::forward<TFunction>(r_function));
+        auto future = p_task->get_future();
+        this->enqueue([p_task]() {(*p_task)();});
+        return future;
+    }
+
+    std::size_t size() const noexcept;
+
+private:
+    void enqueue(std::function<void()>&& r_job);
+
+    void work();
+
+private:
+    std::mutex _mutex;
+
+    std::condition_variable _condition;
+
+    std::deque<std::function<void()>> _jobs;
+
+    bool _stop;
+
+    std::vector<std::thread> _workers;
+}; // class ThreadPool
@@ -0,0 +1,204 @@
+// --- Internal Includes ---
+#include "Trace.hpp"
+#include "utilities.hpp"
+
+// --- STL Includes ---
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+
+struct Trace::Buffer
+{
+    explicit Buffer(uint32_t id)
+        : p_head(new Chunk),
+          p_tail(p_head),
+          threadID(id),
+          name()
+    {
+    }
+
+    Buffer(const Buffer&) = delete;
+
+    ~Buffer()
+    {
+        for (Chunk* p_chunk=p_head; p_chunk!=nullptr;) {
+            Chunk* p_next = p_chunk->p_next.load(std::memory_order_acquire);
+            delete p_chunk;
+            p_chunk = p_next;
+        }
+    }
+
+    Chunk* p_head;
+
+    /// @brief Chunk the owning thread currently writes to.
+    Chunk* p_tail;
+
+    uint32_t threadID;
+
+    /// @brief Guarded by the registry's mutex.
+    std::string name;
+}; // struct Trace::Buffer
+
+
+/// @brief Buffers of every thread that recorded a span.
+/// @details Buffers are never released, so that spans of threads that
+///          already exited still show up in the trace.
+struct Trace::Registry
+{
+    std::mutex mutex;
+
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+    std::vector<Counter> counters;
+}; // struct Trace::Registry
+
+
+Trace::Registry& Trace::getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+
+void Trace::record(const char* p_name, int64_t begin, int64_t end)
+{
+    Buffer& r_buffer = Trace::getThreadBuffer();
+    Chunk* p_chunk = r_buffer.p_tail;
+
+    // Only this thread writes the size, so it can be read without synchronization
+    std::size_t size = p_chunk->size.load(std::memory_order_relaxed);
+    if (size == Chunk::capacity) {
+        Chunk* p_next = new Chunk;
+        p_chunk->p_next.store(p_next, std::memory_order_release);
+        r_buffer.p_tail = p_next;
+        p_chunk = p_next;
+        size = 0;
+    }
+
+    p_chunk->events[size] = Event {p_name, begin, end};
+    p_chunk->size.store(size + 1, std::memory_order_release);
+}
+
+
+void Trace::recordCounter(const char* p_name, double value)
+{
+    const int64_t time = Trace::now();
+    Registry& r_registry = Trace::getRegistry();
+    std::scoped_lock<std::mutex> lock(r_registry.mutex);
+    r_registry.counters.push_back(Counter {p_name, time, value});
+}
+
+
+void Trace::setThreadName(const std::string& r_name)
+{
+    Buffer& r_buffer = Trace::getThreadBuffer();
+    std::scoped_lock<std::mutex> lock(Trace::getRegistry().mutex);
+    r_buffer.name = r_name;
+}
+
+
+std::size_t Trace::getEventCount()
+{
+    Registry& r_registry = Trace::getRegistry();
+    std::scoped_lock<std::mutex> lock(r_registry.mutex);
+
+    std::size_t count = 0;
+    for (const auto& rp_buffer : r_registry.buffers) {
+        for (const Chunk* p_chunk=rp_buffer->p_head; p_chunk!=nullptr; p_chunk=p_chunk->p_next.load(std::memory_order_acquire)) {
+            count += p_chunk->size.load(std::memory_order_acquire);
+        }
+    }
+    return count;
+}
+
+
+void Trace::writeChromeJSON(std::ostream& r_stream)
+{
+    Registry& r_registry = Trace::getRegistry();
+    std::scoped_lock<std::mutex> lock(r_registry.mutex);
+
+    // Collect a consistent snapshot first, since other threads may keep recording
+    struct Snapshot
+    {
+        const Buffer* p_buffer;
+
+        std::vector<Event> events;
+    }; // struct Snapshot
+
+    std::vector<Snapshot> snapshots;
+    int64_t origin = std::numeric_limits<int64_t>::max();
+    for (const auto& rp_buffer : r_registry.buffers) {
+        Snapshot& r_snapshot = snapshots.emplace_back(Snapshot {rp_buffer.get(), {}});
+        for (const Chunk* p_chunk=rp_buffer->p_head; p_chunk!=nullptr; p_chunk=p_chunk->p_next.load(std::memory_order_acquire)) {
+            const std::size_t size = p_chunk->size.load(std::memory_order_acquire);
+            r_snapshot.events.insert(r_snapshot.events.end(),
+                                     p_chunk->events.begin(),
+                                     p_chunk->events.begin() + size);
+        }
+        for (const Event& r_event : r_snapshot.events) {
+            origin = std::min(origin, r_event.begin);
+        }
+    }
+    for (const Counter& r_counter : r_registry.counters) {
+        origin = std::min(origin, r_counter.time);
+    }
+
+    // Timestamps are in microseconds relative to the first span
+    const auto flags = r_stream.flags();
+    r_stream << std::fixed << std::setprecision(3);
+    r_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirst = true;
+    for (const Snapshot& r_snapshot : snapshots) {
+        const uint32_t threadID = r_snapshot.p_buffer->threadID;
+        if (!r_snapshot.p_buffer->name.empty()) {
+            r_stream << (isFirst ? "\n" : ",\n")
+                     << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadID
+                     << ",\"args\":{\"name\":";
+            writeJSONString(r_stream, r_snapshot.p_buffer->name);
+            r_stream << "}}";
+            isFirst = false;
+        }
+
+        for (const Event& r_event : r_snapshot.events) {
+            r_stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+            writeJSONString(r_stream, r_event.p_name);
+            r_stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadID
+                     << ",\"ts\":" << 1e-3 * static_cast<double>(r_event.begin - origin)
+                     << ",\"dur\":" << 1e-3 * static_cast<double>(r_event.end - r_event.begin)
+                     << '}';
+            isFirst = false;
+        }
+    }
+
+    for (const Counter& r_counter : r_registry.counters) {
+        r_stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+        writeJSONString(r_stream, r_counter.p_name);
+        r_stream << ",\"ph\":\"C\",\"pid\":1"
+                 << ",\"ts\":" << 1e-3 * static_cast<double>(r_counter.time - origin)
+                 << ",\"args\":{\"value\":" << r_counter.value << "}}";
+        isFirst = false;
+    }
+
+    r_stream << "\n]}\n";
+    r_stream.flags(flags);
+}
+
+
+Trace::Buffer& Trace::getThreadBuffer()
+{
+    thread_local Buffer* tp_buffer = nullptr;
+    if (tp_buffer == nullptr) {
+        Registry& r_registry = Trace::getRegistry();
+        std::scoped_lock<std::mutex> lock(r_registry.mutex);
+        const auto threadID = static_cast<uint32_t>(r_registry.buffers.size());
+        tp_buffer = r_registry.buffers.emplace_back(std::make_unique<Buffer>(threadID)).get();
+    }
+    return *tp_buffer;
+}
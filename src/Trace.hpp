@@ -0,0 +1,142 @@
+#pragma once
+
+// --- STL Includes ---
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+
+/// @brief Collects timed spans of CPU work and exports them as a Chrome / Perfetto trace.
+/// @details Every thread appends its spans to its own buffer, a list of fixed-size chunks
+///          that only the owning thread writes. Chunk sizes are published with release
+///          stores, so recording a span takes no locks and @ref writeChromeJSON can read
+///          buffers while other threads are still recording. The only lock is taken once
+///          per thread, when its buffer is registered on its first span.
+///
+///          Spans are usually placed with @ref VKTUTORIAL_TRACE_SCOPE, which compiles to
+///          nothing unless @a VKTUTORIAL_ENABLE_TRACING is defined.
+class Trace
+{
+public:
+    /// @brief Measures the lifetime of a scope.
+    /// @note @a p_name is stored as is, so it must outlive the trace (use string literals).
+    class Span
+    {
+    public:
+        explicit Span(const char* p_name) noexcept
+            : _p_name(p_name),
+              _begin(Trace::now())
+        {
+        }
+
+        Span(const Span&) = delete;
+
+        ~Span()
+        {
+            Trace::record(_p_name, _begin, Trace::now());
+        }
+
+    private:
+        const char* _p_name;
+
+        int64_t _begin;
+    }; // class Span
+
+    struct Event
+    {
+        const char* p_name;
+
+        /// @brief Steady clock time at the beginning of the span [ns].
+        int64_t begin;
+
+        /// @brief Steady clock time at the end of the span [ns].
+        int64_t end;
+    }; // struct Event
+
+public:
+    /// @brief Check whether @ref VKTUTORIAL_TRACE_SCOPE records anything.
+    static constexpr bool isEnabled() noexcept
+    {
+        #ifdef VKTUTORIAL_ENABLE_TRACING
+        return true;
+        #else
+        return false;
+        #endif
+    }
+
+    /// @brief Get the current steady clock time [ns].
+    static int64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    /// @brief Append a span to the calling thread's buffer.
+    static void record(const char* p_name, int64_t begin, int64_t end);
+
+    /// @brief Record the value of a counter at the current time.
+    /// @details Counters show up as their own track in exported traces. Recording one
+    ///          takes a lock, so they are meant for rare values like cache statistics,
+    ///          not for anything recorded per frame.
+    /// @note @a p_name is stored as is, so it must outlive the trace (use string literals).
+    static void recordCounter(const char* p_name, double value);
+
+    /// @brief Name the calling thread in exported traces.
+    static void setThreadName(const std::string& r_name);
+
+    /// @brief Get the number of spans recorded by all threads so far.
+    static std::size_t getEventCount();
+
+    /// @brief Write all spans recorded so far in the Chrome trace event format.
+    /// @details The output can be loaded in @a chrome://tracing or @a ui.perfetto.dev.
+    static void writeChromeJSON(std::ostream& r_stream);
+
+private:
+    /// @brief Block of events written by a single thread.
+    struct Chunk
+    {
+        static constexpr std::size_t capacity = 4096;
+
+        std::array<Event,capacity> events;
+
+        /// @brief Number of events written so far; read by exporting threads.
+        std::atomic<std::size_t> size {0};
+
+        std::atomic<Chunk*> p_next {nullptr};
+    }; // struct Chunk
+
+    struct Counter
+    {
+        const char* p_name;
+
+        /// @brief Steady clock time the value was recorded at [ns].
+        int64_t time;
+
+        double value;
+    }; // struct Counter
+
+    struct Buffer;
+
+    struct Registry;
+
+    static Registry& getRegistry();
+
+    /// @brief Get the calling thread's buffer, registering it on first use.
+    static Buffer& getThreadBuffer();
+}; // class Trace
+
+
+#define VKTUTORIAL_TRACE_CONCATENATE_IMPL(left, right) left##right
+#define VKTUTORIAL_TRACE_CONCATENATE(left, right) VKTUTORIAL_TRACE_CONCATENATE_IMPL(left, right)
+
+/// @brief Record a span named @a name from here to the end of the enclosing scope.
+#ifdef VKTUTORIAL_ENABLE_TRACING
+#define VKTUTORIAL_TRACE_SCOPE(name) const Trace::Span VKTUTORIAL_TRACE_CONCATENATE(traceSpan_, __LINE__) (name)
+#else
+#define VKTUTORIAL_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -5,8 +5,12 @@
 
 // --- Internal Includes ---
 #include "utilities.hpp"
+#include "DebugSink.hpp"
+#include "HostAllocator.hpp"
 
 // --- STL Includes ---
+#include <array>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -15,9 +19,40 @@
 
 class VulkanInstance
 {
+public:
+    struct Settings
+    {
+        /// @brief Severities the messenger of @a vkCreateInstance and @a vkDestroyInstance subscribes to.
+        VkDebugUtilsMessageSeverityFlagsEXT debugSeverities = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
+                                                              | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+
+        /// @brief Enable the best practices checks of the validation layers, which report most performance warnings.
+        /// @note Only has an effect if validation layers are enabled, i.e. in debug builds.
+        bool bestPractices = false;
+    }; // struct Settings
+
 public:
     template <concepts::Container<std::string> TContainer>
     VulkanInstance(const TContainer& requiredExtensions)
+        : VulkanInstance(requiredExtensions, nullptr)
+    {
+    }
+
+    /// @param rp_hostAllocator host allocator for the instance and its children; nullptr for the implementation's own.
+    template <concepts::Container<std::string> TContainer>
+    VulkanInstance(const TContainer& requiredExtensions,
+                   const std::shared_ptr<HostAllocator>& rp_hostAllocator)
+        : VulkanInstance(requiredExtensions, Settings(), rp_hostAllocator)
+    {
+    }
+
+    /// @param rp_hostAllocator host allocator for the instance and its children; nullptr for the implementation's own.
+    template <concepts::Container<std::string> TContainer>
+    VulkanInstance(const TContainer& requiredExtensions,
+                   const Settings& r_settings,
+                   const std::shared_ptr<HostAllocator>& rp_hostAllocator)
+        : _instance(VK_NULL_HANDLE),
+          _p_hostAllocator(rp_hostAllocator)
     {
         // Convert extension names to C strings
         std::vector<const char*> cStrings(requiredExtensions.size());
@@ -26,6 +61,12 @@ public:
                        cStrings.begin(),
                        [](const auto& r_name) {return r_name.c_str();});
 
+        // Best practices are enabled through an extension of the validation layer
+        const bool enableBestPractices = _enableValidationLayers && r_settings.bestPractices;
+        if (enableBestPractices) {
+            cStrings.push_back(VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME);
+        }
+
         // Optional info struct for optimizing vulkan calls
         VkApplicationInfo appInfo {};
         appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -33,7 +74,7 @@ public:
         appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.pEngineName = "none";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        appInfo.apiVersion = VK_API_VERSION_1_0;
+        appInfo.apiVersion = VK_API_VERSION_1_2; // <== extension features are queried through Vulkan 1.1 (see PhysicalDevice::Capabilities)
 
         // Specify required global extensions and validation layers
         VkInstanceCreateInfo createInfo {};
@@ -82,10 +123,7 @@ public:
         VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo {};
         if (_enableValidationLayers) {
             debugCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-            debugCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT
-                                            | VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT
-                                            | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT
-                                            | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+            debugCreateInfo.messageSeverity = r_settings.debugSeverities;
             debugCreateInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT
                                         | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT
                                         | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
@@ -95,15 +133,25 @@ public:
             createInfo.pNext = nullptr;
         }
 
+        const std::array<VkValidationFeatureEnableEXT,1> enabledValidationFeatures {VK_VALIDATION_FEATURE_ENABLE_BEST_PRACTICES_EXT};
+        VkValidationFeaturesEXT validationFeatures {};
+        if (enableBestPractices) {
+            validationFeatures.sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT;
+            validationFeatures.enabledValidationFeatureCount = static_cast<uint32_t>(enabledValidationFeatures.size());
+            validationFeatures.pEnabledValidationFeatures = enabledValidationFeatures.data();
+            validationFeatures.pNext = createInfo.pNext;
+            createInfo.pNext = &validationFeatures;
+        }
+
         // Create vulkan instance
-        if (vkCreateInstance(&createInfo, nullptr, &_instance) != VK_SUCCESS) {
+        if (vkCreateInstance(&createInfo, this->getAllocationCallbacks(), &_instance) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create vulkan instance");
         }
     }
 
     ~VulkanInstance()
     {
-        vkDestroyInstance(_instance, nullptr);
+        vkDestroyInstance(_instance, this->getAllocationCallbacks());
     }
 
     ///@name Member Access
@@ -114,6 +162,18 @@ public:
         return _instance;
     }
 
+    /// @brief Get the host allocator of the instance, nullptr if it uses the implementation's own.
+    const std::shared_ptr<HostAllocator>& getHostAllocator() const noexcept
+    {
+        return _p_hostAllocator;
+    }
+
+    /// @brief Get the callbacks to create and destroy the instance's children with; may be nullptr.
+    const VkAllocationCallbacks* getAllocationCallbacks() const noexcept
+    {
+        return _p_hostAllocator ? _p_hostAllocator->getCallbacks() : nullptr;
+    }
+
     ///@}
 
 private:
@@ -140,31 +200,16 @@ private:
                                                         const VkDebugUtilsMessengerCallbackDataEXT* p_data,
                                                         void* p_userData)
     {
-        std::cerr << "VulkanInstance";
-
-        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT)
-            std::cerr << " [VERBOSE]";
-        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
-            std::cerr << " [INFO]";
-        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
-            std::cerr << " [WARNING]";
-        if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
-            std::cerr << " [ERROR]";
-
-        if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT)
-            std::cerr << " (GENERAL)";
-        if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT)
-            std::cerr << " (VALIDATION)";
-        if (type & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
-            std::cerr << " (PERFORMANCE)";
-
-        std::cerr << ": " << p_data->pMessage << std::endl;
+        // Drivers call this from their own threads; never block them on output
+        DebugSink::getDefault().submit("VulkanInstance", severity, type, p_data);
         return VK_FALSE;
     }
 
 private:
     VkInstance _instance;
 
+    std::shared_ptr<HostAllocator> _p_hostAllocator;
+
     #ifndef NDEBUG
     static constexpr bool _enableValidationLayers = true;
     #else
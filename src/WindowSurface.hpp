@@ -20,14 +20,14 @@ public:
           _p_window(p_window),
           _p_vulkanInstance(rp_vulkanInstance)
     {
-        if (glfwCreateWindowSurface(_p_vulkanInstance->get(), _p_window, nullptr, &_surface) != VK_SUCCESS) {
+        if (glfwCreateWindowSurface(_p_vulkanInstance->get(), _p_window, _p_vulkanInstance->getAllocationCallbacks(), &_surface) != VK_SUCCESS) {
             throw std::runtime_error("Window surface construction failed");
         }
     }
 
     ~WindowSurface()
     {
-        vkDestroySurfaceKHR(_p_vulkanInstance->get(), _surface, nullptr);
+        vkDestroySurfaceKHR(_p_vulkanInstance->get(), _surface, _p_vulkanInstance->getAllocationCallbacks());
     }
 
     ///@name Member Access
@@ -3,11 +3,115 @@
 
 // --- STL Includes ---
 #include <iostream>
+#include <string>
+#include <stdexcept>
+#include <filesystem>
 
 
-int main() {
+namespace {
+
+
+/// @brief Parse command line arguments.
+/// @details Recognized arguments:
+///          - @a --headless render into an offscreen target without opening a window
+///          - @a --unthrottled don't pace headless frames to a simulated refresh rate
+///          - @a --frames @a N exit after rendering @a N frames
+///          - @a --frames-in-flight @a N number of frames the CPU may record ahead of the GPU
+///          - @a --pipeline-cache @a PATH file to persist the pipeline cache in
+///          - @a --capability-cache @a PATH file to persist device selection and surface queries in
+///          - @a --gpu-profile @a PATH file to write GPU scope timings to as CSV
+///          - @a --trace @a PATH file to write CPU spans to as a Chrome / Perfetto trace
+///          - @a --performance-warnings @a PATH file to write performance warnings to as JSON
+///          - @a --performance-baseline @a PATH fail if performance warnings not in this file show up
+///          - @a --present-policy @a vsync|low-latency|throughput trade-off between latency and power
+///          - @a --host-memory-limit @a BYTES bound on the host memory Vulkan implementations may take
+///          - @a --system-allocator leave host memory to the Vulkan implementation
+///          - @a --debug-severity @a verbose|info|warning|error least severe debug messages to write
+Application::Settings parseArguments(int argc, const char* const* argv)
+{
+    Application::Settings settings;
+
+    // Shaders and caches live next to the executable by default
+    const auto executableDirectory = std::filesystem::path(argv[0]).parent_path();
+    settings.shaderDirectory = executableDirectory / "shaders";
+    settings.pipelineCache = executableDirectory / "pipeline.cache";
+    settings.capabilityCache = executableDirectory / "capabilities.cache";
+
+    for (int i_arg=1; i_arg<argc; ++i_arg) {
+        const std::string argument = argv[i_arg];
+        if (argument == "--headless") {
+            settings.headless = true;
+        } else if (argument == "--unthrottled") {
+            settings.offscreen.unthrottled = true;
+        } else if (argument == "--frames" && i_arg + 1 < argc) {
+            settings.frameCount = std::stoul(argv[++i_arg]);
+        } else if (argument == "--frames-in-flight" && i_arg + 1 < argc) {
+            settings.framesInFlight = std::stoul(argv[++i_arg]);
+        } else if (argument == "--pipeline-cache" && i_arg + 1 < argc) {
+            settings.pipelineCache = argv[++i_arg];
+        } else if (argument == "--capability-cache" && i_arg + 1 < argc) {
+            settings.capabilityCache = argv[++i_arg];
+        } else if (argument == "--gpu-profile" && i_arg + 1 < argc) {
+            settings.gpuProfile = argv[++i_arg];
+        } else if (argument == "--trace" && i_arg + 1 < argc) {
+            settings.trace = argv[++i_arg];
+        } else if (argument == "--performance-warnings" && i_arg + 1 < argc) {
+            settings.performanceWarnings = argv[++i_arg];
+        } else if (argument == "--performance-baseline" && i_arg + 1 < argc) {
+            settings.performanceBaseline = argv[++i_arg];
+        } else if (argument == "--present-policy" && i_arg + 1 < argc) {
+            const std::string policy = argv[++i_arg];
+            if (policy == "vsync") {
+                settings.presentPolicy = SwapChain::PresentPolicy::VSync;
+            } else if (policy == "low-latency") {
+                settings.presentPolicy = SwapChain::PresentPolicy::LowLatency;
+            } else if (policy == "throughput") {
+                settings.presentPolicy = SwapChain::PresentPolicy::Throughput;
+            } else {
+                throw std::runtime_error("Unrecognized present policy: " + policy);
+            }
+        } else if (argument == "--host-memory-limit" && i_arg + 1 < argc) {
+            if (!settings.hostAllocator.has_value()) {
+                throw std::runtime_error("--host-memory-limit requires the host allocator");
+            }
+            settings.hostAllocator->maxBytes = std::stoull(argv[++i_arg]);
+        } else if (argument == "--system-allocator") {
+            settings.hostAllocator.reset();
+        } else if (argument == "--debug-severity" && i_arg + 1 < argc) {
+            // Severity bits grow with severity, so everything from the threshold up is enabled
+            const std::string severity = argv[++i_arg];
+            VkDebugUtilsMessageSeverityFlagsEXT threshold = 0;
+            if (severity == "verbose") {
+                threshold = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+            } else if (severity == "info") {
+                threshold = VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+            } else if (severity == "warning") {
+                threshold = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+            } else if (severity == "error") {
+                threshold = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+            } else {
+                throw std::runtime_error("Unrecognized debug severity: " + severity);
+            }
+            settings.debugSeverities = ~(threshold - 1) & (VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT * 2 - 1);
+        } else {
+            throw std::runtime_error("Unrecognized argument: " + argument);
+        }
+    }
+
+    if (settings.headless && settings.frameCount == 0) {
+        settings.frameCount = 1000;
+    }
+
+    return settings;
+}
+
+
+} // unnamed namespace
+
+
+int main(int argc, const char* const* argv) {
     try {
-        Application().run();
+        Application(parseArguments(argc, argv)).run();
     } catch (const std::exception& r_exception) {
         std::cerr << r_exception.what() << std::endl;
         return EXIT_FAILURE;
@@ -0,0 +1,26 @@
+// --- Internal Includes ---
+#include "utilities.hpp"
+
+// --- STL Includes ---
+#include <ostream>
+
+
+void writeJSONString(std::ostream& r_stream, std::string_view string)
+{
+    r_stream << '"';
+    for (char c : string) {
+        switch (c) {
+            case '"': r_stream << "\\\""; break;
+            case '\\': r_stream << "\\\\"; break;
+            case '\n': r_stream << "\\n"; break;
+            case '\t': r_stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    r_stream << ' ';
+                } else {
+                    r_stream << c;
+                }
+        }
+    }
+    r_stream << '"';
+}
@@ -3,6 +3,8 @@
 // --- STL Includes ---
 #include <iterator>
 #include <compare>
+#include <iosfwd>
+#include <string_view>
 
 
 namespace concepts {
@@ -34,3 +36,8 @@ concept Comparison
 
 
 } // namespace concepts
+
+
+/// @brief Write a string as a quoted JSON string literal.
+/// @details Quotes, backslashes, newlines and tabs are escaped; other control characters are replaced by spaces.
+void writeJSONString(std::ostream& r_stream, std::string_view string);